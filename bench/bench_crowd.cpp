@@ -0,0 +1,200 @@
+// Copyright 2025 WildSpark Authors
+//
+// Headless crowd benchmark. A scripted server moves N remote players in
+// simple patterns and sends full world_update messages at 20 Hz in the real
+// JSON format. The messages go through the real Networking decoder into
+// GameScene's own PlayerLayer update and depth-sorted draw, with labels in a
+// TextBatch, drawn into a NullRenderSink. No window, GPU or Nakama server is
+// needed.
+//
+// Reports frame time (update + render), world_update parse time, heap
+// allocations per frame and live heap size.
+//
+// Usage: bench_crowd [frames] [players...]   (default: 600 frames, 1k 5k 10k)
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "graphics/FontCache.h"
+#include "graphics/RenderCommandList.h"
+#include "graphics/RenderStats.h"
+#include "graphics/TextBatch.h"
+#include "networking/Networking.h"
+#include "support/AllocationCounter.h"
+#include "world/WorldMap.h"
+#include "world/WorldRenderer.h"
+#include "world/entities/PlayerLayer.h"
+
+#include <SFML/Graphics.hpp>
+
+namespace {
+
+constexpr float kFrameDt = 1.f / 60.f;
+constexpr float kServerTickDt = 1.f / 20.f;
+constexpr float kWorldSize = 4000.f;
+const sf::Vector2f kViewSize{1280.f, 720.f};
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Scripted server: each player follows one of three deterministic patterns
+// around its home position.
+class CrowdServer {
+ public:
+  explicit CrowdServer(int players) {
+    ids_.reserve(players);
+    for (int i = 0; i < players; ++i) {
+      char id[40];
+      std::snprintf(id, sizeof(id), "%08x-4e2a-4c1b-9f3d-%012d", i * 2654435761u, i);
+      ids_.emplace_back(id);
+    }
+  }
+
+  sf::Vector2f positionOf(int i, float t) const {
+    // Homes on a regular grid covering the world.
+    const int side = static_cast<int>(std::ceil(std::sqrt(ids_.size())));
+    const float cell = kWorldSize / static_cast<float>(side);
+    const sf::Vector2f home{(i % side + 0.5f) * cell, (i / side + 0.5f) * cell};
+    const float phase = static_cast<float>(i) * 0.37f;
+    switch (i % 3) {
+      case 0:  // circle
+        return home + sf::Vector2f(std::cos(t + phase), std::sin(t + phase)) * 40.f;
+      case 1:  // horizontal patrol
+        return home + sf::Vector2f(std::sin(t * 0.5f + phase) * 80.f, 0.f);
+      default:  // figure eight
+        return home + sf::Vector2f(std::sin(t * 0.7f + phase) * 60.f,
+                                   std::sin(t * 1.4f + phase) * 30.f);
+    }
+  }
+
+  // Full-state world_update as the match handler sends it (opcode 2).
+  void buildWorldUpdate(float t, Nakama::NMatchData& out) const {
+    nlohmann::json players = nlohmann::json::object();
+    for (std::size_t i = 0; i < ids_.size(); ++i) {
+      const sf::Vector2f p = positionOf(static_cast<int>(i), t);
+      players[ids_[i]] = {{"position", {{"x", p.x}, {"y", p.y}}}};
+    }
+    const nlohmann::json message = {{"type", "world_update"},
+                                    {"data", {{"players", std::move(players)}}}};
+    const std::string text = message.dump();
+    out.opCode = 2;
+    out.data.assign(text.begin(), text.end());
+  }
+
+ private:
+  std::vector<std::string> ids_;
+};
+
+struct Result {
+  int players = 0;
+  FrameTimeHistory frameMs;
+  double parseMsTotal = 0.0;
+  int ticks = 0;
+  std::size_t allocations = 0;
+  std::size_t liveBytesEnd = 0;
+  std::size_t drawnPerFrame = 0;
+
+  explicit Result(int frames) : frameMs(static_cast<std::size_t>(frames)) {}
+};
+
+Result run(int players, int frames) {
+  Result result(frames);
+  result.players = players;
+
+  WorldMap map;
+  WorldRenderer renderer(map);
+  renderer.setCulling(true);
+  renderer.setDepthSorting(true);
+  renderer.setDebugObjectAreas(false);
+
+  // Scripted stand-in for the match socket: messages are fed straight into
+  // the realtime listener, so parsing and interning are the real code.
+  Networking networking(nullptr);
+  InternalRtListener listener(&networking);
+
+  PlayerLayer layer;
+  networking.setPlayerStateUpdateCallback(
+      [&](PlayerHandle player, const sf::Vector2f& position, unsigned int seq) {
+        layer.applyServerState(player, networking.playerIds().name(player), position, seq);
+      });
+
+  CrowdServer server(players);
+  Nakama::NMatchData packet;
+  NullRenderSink sink;
+  TextBatch labels(FontCache::instance().defaultFont());
+
+  const sf::View view(sf::Vector2f(kWorldSize, kWorldSize) / 2.f, kViewSize);
+
+  float t = 0.f, nextTick = 0.f;
+  std::size_t drawn = 0;
+  for (int f = 0; f < frames; ++f) {
+    // Message generation is the server's cost and stays outside the timing.
+    const bool tick = t >= nextTick;
+    if (tick) {
+      server.buildWorldUpdate(t, packet);
+      nextTick += kServerTickDt;
+    }
+
+    const auto allocsStart = AllocationCounter::snapshot().allocations;
+    const auto frameStart = Clock::now();
+    if (tick) {
+      const auto parseStart = Clock::now();
+      listener.onMatchData(packet);
+      result.parseMsTotal += msSince(parseStart);
+      ++result.ticks;
+    }
+    layer.update(sf::seconds(kFrameDt), view);
+
+    sink.reset();
+    sink.setView(view);
+    renderer.resetStats();
+    labels.clear();
+    layer.render(renderer, sink, labels);
+    labels.draw(sink);
+    drawn += layer.drawn();
+    result.frameMs.push(static_cast<float>(msSince(frameStart)));
+    result.allocations += AllocationCounter::snapshot().allocations - allocsStart;
+
+    t += kFrameDt;
+  }
+  result.liveBytesEnd = AllocationCounter::snapshot().liveBytes;
+  result.drawnPerFrame = drawn / static_cast<std::size_t>(frames);
+  return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int frames = argc > 1 ? std::max(1, std::atoi(argv[1])) : 600;
+  std::vector<int> crowds;
+  for (int i = 2; i < argc; ++i) crowds.push_back(std::max(1, std::atoi(argv[i])));
+  if (crowds.empty()) crowds = {1000, 5000, 10000};
+
+  for (const int players : crowds) {
+    const Result r = run(players, frames);
+    std::cout << "bench_crowd: " << players << " players, " << frames << " frames\n"
+              << "  frame ms      mean " << r.frameMs.average() << "  p50 "
+              << r.frameMs.percentile(0.50f) << "  p95 " << r.frameMs.percentile(0.95f)
+              << "  p99 " << r.frameMs.percentile(0.99f) << "  max " << r.frameMs.max()
+              << "\n"
+              << "  world_update  " << r.ticks << " parsed, mean "
+              << (r.ticks ? r.parseMsTotal / r.ticks : 0.0) << " ms\n"
+              << "  allocations   " << r.allocations / static_cast<std::size_t>(frames)
+              << " per frame\n"
+              << "  heap          " << r.liveBytesEnd / 1024 << " KiB live\n"
+              << "  drawn         " << r.drawnPerFrame << " players per frame"
+              << std::endl;
+  }
+  return 0;
+}
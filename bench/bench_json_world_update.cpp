@@ -0,0 +1,100 @@
+// Copyright 2025 WildSpark Authors
+//
+// JSON world_update decode benchmark: the nlohmann DOM walk the listener
+// used to do against the on-demand JsonWorldUpdateReader, for servers that
+// have not switched to the binary wire format. Both decode as far as a
+// user id and position reaching the game.
+//
+// Exits non-zero when the on-demand decoder is less than kTargetSpeedup
+// times faster on a 1000-player snapshot.
+//
+// Usage: bench_json_world_update [iterations]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "networking/JsonWorldUpdateReader.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kTargetPlayers = 1000;
+constexpr double kTargetSpeedup = 5.0;
+
+// Same shape and ids as bench_crowd / bench_wire.
+std::string worldUpdate(int n) {
+  nlohmann::json players = nlohmann::json::object();
+  for (int i = 0; i < n; ++i) {
+    char id[40];
+    std::snprintf(id, sizeof(id), "%08x-4e2a-4c1b-9f3d-%012d", i * 2654435761u, i);
+    players[id] = {{"position", {{"x", i * 13.37f}, {"y", i * 7.11f}}}};
+  }
+  return nlohmann::json{{"type", "world_update"}, {"data", {{"players", players}}}}.dump();
+}
+
+float domDecode(const std::string& bytes) {
+  const auto message = nlohmann::json::parse(bytes);
+  float sum = 0.f;
+  if (message.value("type", "") != "world_update") return sum;
+  for (auto& [id, player] : message["data"]["players"].items()) {
+    sum += static_cast<float>(id.size());
+    sum += player["position"].value("x", 0.f) + player["position"].value("y", 0.f);
+  }
+  return sum;
+}
+
+float onDemandDecode(const std::string& bytes) {
+  JsonWorldUpdateReader reader(bytes);
+  JsonWorldUpdateReader::Entry entry;
+  float sum = 0.f;
+  while (reader.next(entry)) {
+    sum += static_cast<float>(entry.userId.size());
+    sum += entry.position.x + entry.position.y;
+  }
+  return sum;
+}
+
+template <typename F>
+double usPerCall(int iterations, F&& f) {
+  const auto start = Clock::now();
+  for (int i = 0; i < iterations; ++i) f();
+  return std::chrono::duration<double, std::micro>(Clock::now() - start).count() /
+         iterations;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+  volatile float sink = 0.f;  // keeps decode loops from being optimised out
+
+  double targetSpeedup = 0.0;
+  std::cout << "bench_json_world_update: " << iterations << " iterations\n";
+  for (const int n : {1, 100, kTargetPlayers, 5000}) {
+    const std::string json = worldUpdate(n);
+    if (domDecode(json) != onDemandDecode(json)) {
+      std::cerr << "  decoders disagree for " << n << " players" << std::endl;
+      return 1;
+    }
+    const double dom = usPerCall(iterations, [&] { sink = sink + domDecode(json); });
+    const double onDemand =
+        usPerCall(iterations, [&] { sink = sink + onDemandDecode(json); });
+    const double speedup = dom / onDemand;
+    if (n == kTargetPlayers) targetSpeedup = speedup;
+    std::cout << "  world_update x" << n << " (" << json.size() << " bytes)\n"
+              << "    decode us   dom " << dom << "  on-demand " << onDemand << "  ("
+              << speedup << "x)\n";
+  }
+
+  const bool met = targetSpeedup >= kTargetSpeedup;
+  std::cout << "  target " << kTargetSpeedup << "x at " << kTargetPlayers << " players: "
+            << (met ? "met" : "MISSED") << std::endl;
+  return met ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+// Copyright 2025 WildSpark Authors
+//
+// Headless renderer benchmark. Builds a synthetic map, flies a scripted
+// camera across it and emits every frame into a NullRenderSink, so the
+// numbers only measure CPU-side work (culling, draw list building, vertex
+// submission). No window or GPU is needed.
+//
+// Usage: bench_renderer [frames] [map_tiles]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <utility>
+
+#include "graphics/RenderCommandList.h"
+#include "graphics/RenderStats.h"
+#include "world/WorldMap.h"
+#include "world/WorldRenderer.h"
+
+#include <SFML/Graphics.hpp>
+
+namespace {
+
+constexpr int kTileSize = 16;
+constexpr int kRegionTiles = 16;  // tiles per ground bucket edge
+constexpr float kViewWidth = 640.f;
+constexpr float kViewHeight = 360.f;
+
+void appendQuad(sf::VertexArray& va, float x, float y, float w, float h,
+                float u, float v) {
+  const sf::Vector2f p0{x, y}, p1{x + w, y}, p2{x + w, y + h}, p3{x, y + h};
+  const sf::Vector2f t0{u, v}, t1{u + w, v}, t2{u + w, v + h}, t3{u, v + h};
+  va.append(sf::Vertex{p0, sf::Color::White, t0});
+  va.append(sf::Vertex{p1, sf::Color::White, t1});
+  va.append(sf::Vertex{p2, sf::Color::White, t2});
+  va.append(sf::Vertex{p0, sf::Color::White, t0});
+  va.append(sf::Vertex{p2, sf::Color::White, t2});
+  va.append(sf::Vertex{p3, sf::Color::White, t3});
+}
+
+// Ground layer: one chunk per kRegionTiles x kRegionTiles region, mirroring
+// the bucketed layout the TMJ loader produces.
+WorldMap::LayerMesh makeGround(const char* name, int tiles,
+                               const sf::Texture* tex) {
+  WorldMap::LayerMesh layer;
+  layer.type = "tilelayer";
+  layer.name = name;
+  const int regions = (tiles + kRegionTiles - 1) / kRegionTiles;
+  for (int ry = 0; ry < regions; ++ry) {
+    for (int rx = 0; rx < regions; ++rx) {
+      WorldMap::LayerMesh::CellKey key{rx, ry};
+      WorldMap::LayerMesh::Chunk ch;
+      ch.texture = tex;
+      for (int ty = 0; ty < kRegionTiles; ++ty) {
+        for (int tx = 0; tx < kRegionTiles; ++tx) {
+          const float x = static_cast<float>((rx * kRegionTiles + tx) * kTileSize);
+          const float y = static_cast<float>((ry * kRegionTiles + ty) * kTileSize);
+          appendQuad(ch.vertices, x, y, kTileSize, kTileSize,
+                     static_cast<float>((tx % 8) * kTileSize), 0.f);
+        }
+      }
+      layer.chunk_buckets[key].chunks.push_back(std::move(ch));
+      layer.chunk_bucket_order.push_back(key);
+    }
+  }
+  return layer;
+}
+
+// Object layer: scattered 1x2-tile props spread across two textures so the
+// draw stream contains texture switches.
+WorldMap::LayerMesh makeObjects(int tiles, int count, const sf::Texture* a,
+                                const sf::Texture* b) {
+  WorldMap::LayerMesh layer;
+  layer.type = "objectgroup";
+  layer.name = "level_0_1";
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> pos(0, tiles - 2);
+  for (int i = 0; i < count; ++i) {
+    const int tx = pos(rng), ty = pos(rng);
+    WorldMap::LayerMesh::CellKey key{tx / kRegionTiles, ty / kRegionTiles};
+    WorldMap::LayerMesh::Chunk ch;
+    ch.id = static_cast<uint32_t>(i + 1);
+    ch.texture = (i % 3 == 0) ? b : a;
+    const float x = static_cast<float>(tx * kTileSize);
+    const float y = static_cast<float>(ty * kTileSize);
+    appendQuad(ch.vertices, x, y, kTileSize, 2 * kTileSize, 0.f, 0.f);
+    ch.sortY = y + 2 * kTileSize;
+    auto& bucket = layer.chunk_buckets[key];
+    if (bucket.chunks.empty()) layer.chunk_bucket_order.push_back(key);
+    bucket.chunks.push_back(std::move(ch));
+  }
+  return layer;
+}
+
+// Scripted camera: a Lissajous sweep over the map with a slow zoom pulse so
+// both panning and the number of visible chunks vary from frame to frame.
+sf::View cameraAt(int frame, int frames, float worldSize) {
+  const float t = static_cast<float>(frame) / static_cast<float>(frames);
+  const float twoPi = 6.2831853f;
+  const float margin = kViewWidth;
+  const float half = (worldSize - 2.f * margin) * 0.5f;
+  const sf::Vector2f center{margin + half + half * std::sin(twoPi * t * 3.f),
+                            margin + half + half * std::sin(twoPi * t * 2.f)};
+  const float zoom = 1.f + 0.5f * std::sin(twoPi * t * 5.f);
+  return sf::View(center, {kViewWidth * zoom, kViewHeight * zoom});
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int frames = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+  const int tiles = argc > 2 ? std::max(64, std::atoi(argv[2])) : 512;
+
+  sf::Texture groundTex, propsTexA, propsTexB;
+  WorldMap map;
+  map.setTileSize(kTileSize, kTileSize);
+  auto& layers = map.layersMutable();
+  layers.push_back(makeGround("world", tiles, &groundTex));
+  layers.push_back(makeGround("decals", tiles, &groundTex));
+  layers.push_back(makeObjects(tiles, tiles * tiles / 32, &propsTexA, &propsTexB));
+  map.rebuildObjectDrawOrderForLayer(static_cast<int>(layers.size()) - 1);
+
+  WorldRenderer renderer(map);
+  renderer.setCulling(true);
+
+  NullRenderSink sink;
+  FrameTimeHistory history(static_cast<std::size_t>(frames));
+  const float worldSize = static_cast<float>(tiles * kTileSize);
+
+  std::uint64_t runHash = 0;
+  std::uint64_t drawCalls = 0, vertices = 0, culled = 0, switches = 0;
+  for (int f = 0; f < frames; ++f) {
+    sink.reset();
+    sink.setView(cameraAt(f, frames, worldSize));
+    renderer.resetStats();
+
+    const auto start = std::chrono::steady_clock::now();
+    renderer.renderGround(sink);
+    renderer.renderOverlays(sink);
+    const auto end = std::chrono::steady_clock::now();
+
+    // Stored in microseconds; FrameTimeHistory is unit-agnostic.
+    history.push(std::chrono::duration<float, std::micro>(end - start).count());
+    runHash = runHash * 1099511628211ull ^ sink.hash();
+    drawCalls += sink.drawCalls();
+    vertices += sink.vertexCount();
+    culled += renderer.stats().chunksCulled;
+    switches += renderer.stats().textureSwitches;
+  }
+
+  std::cout << "bench_renderer: " << frames << " frames, " << tiles << "x"
+            << tiles << " tiles\n"
+            << "  cpu us/frame  mean " << history.average() << "  p50 "
+            << history.percentile(0.50f) << "  p95 "
+            << history.percentile(0.95f) << "  p99 "
+            << history.percentile(0.99f) << "  max " << history.max() << "\n"
+            << "  per frame     draws " << drawCalls / frames << "  vertices "
+            << vertices / frames << "  culled " << culled / frames
+            << "  texture switches " << switches / frames << "\n"
+            << "  command hash  0x" << std::hex << runHash << std::dec
+            << std::endl;
+  return 0;
+}
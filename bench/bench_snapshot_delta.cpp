@@ -0,0 +1,136 @@
+// Copyright 2025 WildSpark Authors
+//
+// Downlink cost of delta world snapshots (opcode 3) against full binary
+// world_updates (opcode 2), for a crowd where only some players move each
+// tick. Snapshots go through the in-process SnapshotServer stand-in and
+// SnapshotHistory with packet loss on both the snapshots and the acks;
+// the client's rebuilt state is checked against the server's every tick.
+//
+// Usage: bench_snapshot_delta [players] [seconds] [loss percent]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "networking/SnapshotHistory.h"
+#include "networking/WireProtocol.h"
+#include "support/SnapshotServer.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kTickRate = 20;
+constexpr float kSpeed = 100.f;            // px/s
+constexpr double kMovingFraction = 0.35;   // players walking at any time
+
+class ClientView : public MessageSink {
+ public:
+  void emit(InboundMessage& message) override {
+    positions[message.netId] = message.position;
+  }
+  std::map<std::uint32_t, sf::Vector2f> positions;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int playerCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+  const int seconds = argc > 2 ? std::max(1, std::atoi(argv[2])) : 60;
+  const double loss = argc > 3 ? std::clamp(std::atof(argv[3]), 0.0, 90.0) / 100.0 : 0.02;
+
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> unit(0.f, 1.f);
+  std::vector<SnapshotServer::Player> players;
+  std::vector<sf::Vector2f> velocity(playerCount);
+  for (int i = 0; i < playerCount; ++i) {
+    char id[40];
+    std::snprintf(id, sizeof(id), "%08x-4e2a-4c1b-9f3d-%012d", i * 2654435761u, i);
+    players.push_back({static_cast<std::uint32_t>(i), id,
+                       {unit(rng) * 4000.f, unit(rng) * 4000.f}, 0});
+  }
+
+  SnapshotServer server;
+  SnapshotHistory history;
+  ClientView view;
+  InboundMessage scratch;
+  std::string fullBytes, deltaBytes, ackBytes;
+  std::size_t fullTotal = 0, deltaTotal = 0, ackTotal = 0, mismatches = 0;
+  double decodeUs = 0.0;
+  const int ticks = seconds * kTickRate;
+
+  for (int tick = 0; tick < ticks; ++tick) {
+    // Players start and stop walking; about kMovingFraction walk at once.
+    for (int i = 0; i < playerCount; ++i) {
+      if (unit(rng) < 0.05f) {
+        const float angle = unit(rng) * 6.2831853f;
+        velocity[i] = unit(rng) < kMovingFraction
+                          ? sf::Vector2f(std::cos(angle), std::sin(angle)) * kSpeed
+                          : sf::Vector2f();
+      }
+      if (velocity[i] != sf::Vector2f()) {
+        players[i].position += velocity[i] / static_cast<float>(kTickRate);
+        ++players[i].lastSequence;
+      }
+    }
+
+    // Full binary world_update, user ids only on the first tick.
+    {
+      wire::WorldUpdateWriter writer(fullBytes, static_cast<std::uint32_t>(playerCount));
+      for (const auto& player : players) {
+        const std::string_view userId = tick == 0 ? player.userId : std::string_view();
+        writer.add({player.netId, userId, player.position, player.lastSequence});
+      }
+    }
+    fullTotal += fullBytes.size();
+
+    server.encode(players, deltaBytes);
+    deltaTotal += deltaBytes.size();
+    if (unit(rng) < loss) continue;  // snapshot lost
+
+    const auto start = Clock::now();
+    history.apply(deltaBytes, scratch, view);
+    decodeUs += std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    wire::encode(wire::SnapshotAck{history.latestId()}, ackBytes);
+    ackTotal += ackBytes.size();
+    if (unit(rng) >= loss) server.acknowledge(history.latestId());
+
+    const auto* rebuilt = history.find(history.latestId());
+    if (!rebuilt || rebuilt->size() != players.size()) {
+      ++mismatches;
+      continue;
+    }
+    for (std::size_t i = 0; i < players.size(); ++i) {
+      if ((*rebuilt)[i].x != wire::quantize(players[i].position.x) ||
+          (*rebuilt)[i].y != wire::quantize(players[i].position.y)) {
+        ++mismatches;
+        break;
+      }
+    }
+  }
+
+  const double fullPerTick = static_cast<double>(fullTotal) / ticks;
+  const double deltaPerTick = static_cast<double>(deltaTotal) / ticks;
+  std::cout << "bench_snapshot_delta: " << playerCount << " players, " << seconds << " s at "
+            << kTickRate << " Hz, " << loss * 100.0 << "% loss\n"
+            << "  world_update   " << fullPerTick << " bytes/tick  ("
+            << fullPerTick * kTickRate / 1024.0 << " KiB/s)\n"
+            << "  world_snapshot " << deltaPerTick << " bytes/tick  ("
+            << deltaPerTick * kTickRate / 1024.0 << " KiB/s)\n"
+            << "  downlink saved " << 100.0 * (1.0 - deltaPerTick / fullPerTick) << "%  ("
+            << fullPerTick / deltaPerTick << "x), uplink acks "
+            << static_cast<double>(ackTotal) / ticks * kTickRate << " bytes/s\n"
+            << "  client decode  " << decodeUs / ticks << " us/tick, baselines missing "
+            << history.stats().missingBaseline << "\n"
+            << "  state mismatches " << mismatches << std::endl;
+  return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+// Copyright 2025 WildSpark Authors
+//
+// Wire format benchmark: bytes per message and encode/decode time for the
+// JSON and binary (WireProtocol) encodings of the match messages. Decoding
+// is measured as far as a position reaching the game, i.e. JSON is parsed
+// and walked the way InternalRtListener does.
+//
+// Usage: bench_wire [iterations]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "networking/WireProtocol.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Player {
+  std::string id;
+  sf::Vector2f position;
+};
+
+std::vector<Player> makePlayers(int n) {
+  std::vector<Player> players;
+  for (int i = 0; i < n; ++i) {
+    char id[40];
+    std::snprintf(id, sizeof(id), "%08x-4e2a-4c1b-9f3d-%012d", i * 2654435761u, i);
+    players.push_back({id, {i * 13.37f, i * 7.11f}});
+  }
+  return players;
+}
+
+std::string jsonWorldUpdate(const std::vector<Player>& players) {
+  nlohmann::json list = nlohmann::json::object();
+  for (const auto& p : players) {
+    list[p.id] = {{"position", {{"x", p.position.x}, {"y", p.position.y}}}};
+  }
+  return nlohmann::json{{"type", "world_update"}, {"data", {{"players", list}}}}.dump();
+}
+
+// Steady-state binary update: ids were introduced earlier, only netIds.
+void binaryWorldUpdate(const std::vector<Player>& players, std::string& out) {
+  wire::WorldUpdateWriter writer(out, static_cast<std::uint32_t>(players.size()));
+  for (std::size_t i = 0; i < players.size(); ++i) {
+    writer.add({static_cast<std::uint32_t>(i), {}, players[i].position, 0});
+  }
+}
+
+float jsonDecode(const std::string& bytes) {
+  const auto message = nlohmann::json::parse(bytes);
+  float sum = 0.f;
+  for (auto& [id, player] : message["data"]["players"].items()) {
+    sum += player["position"].value("x", 0.f) + player["position"].value("y", 0.f);
+  }
+  return sum;
+}
+
+float binaryDecode(const std::string& bytes) {
+  wire::WorldUpdateReader reader(bytes);
+  wire::PlayerState state;
+  float sum = 0.f;
+  while (reader.next(state)) sum += state.position.x + state.position.y;
+  return sum;
+}
+
+template <typename F>
+double usPerCall(int iterations, F&& f) {
+  const auto start = Clock::now();
+  for (int i = 0; i < iterations; ++i) f();
+  return std::chrono::duration<double, std::micro>(Clock::now() - start).count() /
+         iterations;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+  volatile float sink = 0.f;  // keeps decode loops from being optimised out
+
+  std::cout << "bench_wire: " << iterations << " iterations\n";
+  for (const int n : {1, 10, 100, 1000}) {
+    const auto players = makePlayers(n);
+    const std::string json = jsonWorldUpdate(players);
+    std::string binary;
+    binaryWorldUpdate(players, binary);
+
+    const double jsonEnc =
+        usPerCall(iterations, [&] { sink = sink + jsonWorldUpdate(players).size(); });
+    const double binEnc = usPerCall(iterations, [&] { binaryWorldUpdate(players, binary); });
+    const double jsonDec = usPerCall(iterations, [&] { sink = sink + jsonDecode(json); });
+    const double binDec = usPerCall(iterations, [&] { sink = sink + binaryDecode(binary); });
+
+    std::cout << "  world_update x" << n << "\n"
+              << "    bytes       json " << json.size() << "  binary " << binary.size()
+              << "\n"
+              << "    encode us   json " << jsonEnc << "  binary " << binEnc << "\n"
+              << "    decode us   json " << jsonDec << "  binary " << binDec << "\n";
+  }
+
+  nlohmann::json input;
+  input["playerId"] = "3f2c9d41-4e2a-4c1b-9f3d-000000000001";
+  input["action"] = "move";
+  input["inputSequence"] = 1234;
+  input["velocityX"] = 70.71f;
+  input["velocityY"] = -70.71f;
+  std::string binaryInput;
+  wire::encode(wire::PlayerInput{1234, {70.71f, -70.71f}}, binaryInput);
+  std::cout << "  player input\n"
+            << "    bytes       json " << input.dump().size() << "  binary "
+            << binaryInput.size() << std::endl;
+  return 0;
+}
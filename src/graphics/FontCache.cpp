@@ -0,0 +1,45 @@
+// Copyright 2025 WildSpark Authors
+
+#include "FontCache.h"
+
+#include <iostream>
+#include <utility>
+
+FontCache& FontCache::instance() {
+  static FontCache cache;
+  return cache;
+}
+
+const sf::Font* FontCache::get(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = fonts_.find(path);
+  if (it == fonts_.end()) {
+    auto font = std::make_unique<sf::Font>();
+    ++loads_;
+    if (!font->openFromFile(path)) font.reset();
+    it = fonts_.emplace(path, std::move(font)).first;
+  }
+  return it->second.get();
+}
+
+const sf::Font* FontCache::defaultFont() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (defaultResolved_) return default_;
+  }
+  const sf::Font* font = get("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf");
+  if (!font) font = get("arial.ttf");
+  if (!font) {
+    std::cerr << "FontCache: Failed to load a default font. Text will not be displayed." << std::endl;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  defaultResolved_ = true;
+  default_ = font;
+  return default_;
+}
+
+std::size_t FontCache::loadCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return loads_;
+}
@@ -0,0 +1,43 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef GRAPHICS_FONTCACHE_H_
+#define GRAPHICS_FONTCACHE_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <SFML/Graphics.hpp>
+
+// Process-wide font cache. Each font file is opened and parsed once and the
+// resulting sf::Font (and therefore its glyph atlas) is shared by every
+// label in the game, so spawning an entity never touches the disk.
+//
+// Fonts are never unloaded; returned pointers stay valid for the lifetime of
+// the process. A failed load is cached too, so a missing file is only
+// reported once.
+class FontCache {
+ public:
+  static FontCache& instance();
+
+  // Font at `path`, or nullptr if it cannot be opened.
+  const sf::Font* get(const std::string& path);
+
+  // UI font: DejaVuSans, falling back to arial.ttf next to the executable.
+  const sf::Font* defaultFont();
+
+  // Number of font files actually opened (for tests and diagnostics).
+  std::size_t loadCount() const;
+
+ private:
+  FontCache() = default;
+
+  mutable std::mutex mutex_;
+  std::map<std::string, std::unique_ptr<sf::Font>> fonts_;  // null = failed
+  std::size_t loads_ = 0;
+  bool defaultResolved_ = false;
+  const sf::Font* default_ = nullptr;
+};
+
+#endif  // GRAPHICS_FONTCACHE_H_
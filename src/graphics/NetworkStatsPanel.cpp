@@ -0,0 +1,116 @@
+// Copyright 2025 WildSpark Authors
+
+#include "NetworkStatsPanel.h"
+
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+
+#include "imgui.h"
+
+namespace {
+
+const char* opCodeName(std::size_t opCode) {
+  switch (static_cast<std::int64_t>(opCode)) {
+    case opcode::kPlayerInput: return "input";
+    case opcode::kWorldUpdate: return "world_update";
+    case opcode::kWorldSnapshot: return "world_snapshot";
+    case opcode::kInputAck: return "input_ack";
+    case opcode::kObjectUpdate: return "object_update";
+    case opcode::kPing: return "ping";
+    case opcode::kInterest: return "interest";
+    case opcode::kSnapshotAck: return "snapshot_ack";
+    default: return "other";
+  }
+}
+
+}  // namespace
+
+void NetworkStatsPanel::sample(double seconds, const NetworkStats& stats) {
+  if (hasCurrent_) {
+    previous_ = current_;
+    previousAt_ = currentAt_;
+    hasPrevious_ = true;
+  }
+  current_ = stats;
+  currentAt_ = seconds;
+  hasCurrent_ = true;
+}
+
+void NetworkStatsPanel::draw() {
+  if (!visible_) return;
+
+  ImGui::SetNextWindowPos(ImVec2(10, 320), ImGuiCond_FirstUseEver);
+  ImGui::SetNextWindowBgAlpha(0.8f);
+  if (!ImGui::Begin("Network Stats", &visible_,
+                    ImGuiWindowFlags_AlwaysAutoResize |
+                        ImGuiWindowFlags_NoFocusOnAppearing)) {
+    ImGui::End();
+    return;
+  }
+
+  const double elapsed = hasPrevious_ ? currentAt_ - previousAt_ : 0.0;
+  auto perSecond = [elapsed](std::uint64_t now, std::uint64_t before) {
+    return elapsed > 0.0 ? static_cast<double>(now - before) / elapsed : 0.0;
+  };
+  const NetworkStats::Traffic total = current_.total();
+  const NetworkStats::Traffic before = hasPrevious_ ? previous_.total() : NetworkStats::Traffic{};
+
+  ImGui::Text("Ack RTT: %.1f ms (min %.1f, jitter %.1f, %" PRIu64 " samples)",
+              current_.ackRttMs, current_.ackRttMinMs, current_.ackRttJitterMs,
+              current_.ackSamples);
+  ImGui::Text("Ping RTT: %.1f ms (jitter %.1f)", current_.pingRttMs,
+              current_.pingJitterMs);
+  ImGui::Text("In: %.2f KiB/s (%.0f msg/s)  Out: %.2f KiB/s (%.0f msg/s)",
+              perSecond(total.bytesIn, before.bytesIn) / 1024.0,
+              perSecond(total.messagesIn, before.messagesIn),
+              perSecond(total.bytesOut, before.bytesOut) / 1024.0,
+              perSecond(total.messagesOut, before.messagesOut));
+  const DurationHistogram& interval = current_.snapshotIntervalUs;
+  ImGui::Text("Snapshot interval: p50 %.1f ms | p99 %.1f ms | max %.1f ms",
+              interval.percentile(0.5) / 1000.0, interval.percentile(0.99) / 1000.0,
+              interval.max() / 1000.0);
+  ImGui::Text("Snapshot jitter: %.1f ms", current_.snapshotJitterMs);
+
+  const NetworkQueueStats& q = current_.queues;
+  ImGui::Separator();
+  ImGui::Text("Inbound queue: %zu (high %zu, dropped %zu)", q.inboundDepth,
+              q.inboundHighWater, q.inboundDropped);
+  ImGui::Text("Outbound queue: %zu (high %zu, dropped %zu)", q.outboundDepth,
+              q.outboundHighWater, q.outboundDropped);
+  ImGui::Text("Stalled ticks: %zu", q.stalledTicks);
+
+  if (ImGui::BeginTable("opcodes", 6,
+                        ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                            ImGuiTableFlags_SizingFixedFit)) {
+    ImGui::TableSetupColumn("Opcode");
+    ImGui::TableSetupColumn("In B/s");
+    ImGui::TableSetupColumn("Out B/s");
+    ImGui::TableSetupColumn("Msgs in/out");
+    ImGui::TableSetupColumn("Decode p50 us");
+    ImGui::TableSetupColumn("p99 us");
+    ImGui::TableHeadersRow();
+    for (std::size_t i = 0; i < current_.opcodes.size(); ++i) {
+      const NetworkStats::Traffic& t = current_.opcodes[i];
+      if (t.messagesIn == 0 && t.messagesOut == 0) continue;
+      const NetworkStats::Traffic p =
+          hasPrevious_ ? previous_.opcodes[i] : NetworkStats::Traffic{};
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::Text("%zu %s", i, opCodeName(i));
+      ImGui::TableNextColumn();
+      ImGui::Text("%.0f", perSecond(t.bytesIn, p.bytesIn));
+      ImGui::TableNextColumn();
+      ImGui::Text("%.0f", perSecond(t.bytesOut, p.bytesOut));
+      ImGui::TableNextColumn();
+      ImGui::Text("%" PRIu64 " / %" PRIu64, t.messagesIn, t.messagesOut);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.0f", current_.decodeUs[i].percentile(0.5));
+      ImGui::TableNextColumn();
+      ImGui::Text("%.0f", current_.decodeUs[i].percentile(0.99));
+    }
+    ImGui::EndTable();
+  }
+
+  ImGui::End();
+}
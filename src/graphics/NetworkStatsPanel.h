@@ -0,0 +1,31 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef GRAPHICS_NETWORKSTATSPANEL_H_
+#define GRAPHICS_NETWORKSTATSPANEL_H_
+
+#include "../networking/NetworkStats.h"
+
+// ImGui window showing Networking's NetworkStats: RTT and jitter, bandwidth,
+// per-opcode traffic and decode times, snapshot intervals and queue depths.
+// Rates are computed between the last two samples, so feed it at a steady
+// interval (GameScene does once a second). Draw from a scene's renderUi().
+class NetworkStatsPanel {
+ public:
+  void setVisible(bool visible) { visible_ = visible; }
+  bool isVisible() const { return visible_; }
+  void toggle() { visible_ = !visible_; }
+
+  void sample(double seconds, const NetworkStats& stats);
+  void draw();
+
+ private:
+  bool visible_ = false;
+  bool hasCurrent_ = false;
+  bool hasPrevious_ = false;
+  double previousAt_ = 0.0;
+  double currentAt_ = 0.0;
+  NetworkStats previous_;
+  NetworkStats current_;
+};
+
+#endif  // GRAPHICS_NETWORKSTATSPANEL_H_
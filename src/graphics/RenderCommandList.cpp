@@ -0,0 +1,138 @@
+// Copyright 2025 WildSpark Authors
+
+#include "RenderCommandList.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr std::uint64_t kFnvOffset = 1469598103934665603ull;
+constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+
+std::uint32_t floatBits(float f) {
+  std::uint32_t bits = 0;
+  std::memcpy(&bits, &f, sizeof(bits));
+  return bits;
+}
+
+}  // namespace
+
+void RenderCommandList::draw(const sf::Vertex* vertices, std::size_t count,
+                             sf::PrimitiveType type,
+                             const sf::RenderStates& states) {
+  if (count == 0) return;
+  DrawRecord rec;
+  rec.texture = states.texture;
+  rec.primitive = type;
+  rec.firstVertex = static_cast<std::uint32_t>(vertices_.size());
+  rec.vertexCount = static_cast<std::uint32_t>(count);
+  rec.transform = states.transform;
+  rec.blendMode = states.blendMode;
+  vertices_.insert(vertices_.end(), vertices, vertices + count);
+  records_.push_back(rec);
+}
+
+void RenderCommandList::draw(const sf::Drawable& /*drawable*/,
+                             const sf::RenderStates& /*states*/) {
+  ++droppedDrawables_;
+}
+
+void RenderCommandList::clear() {
+  records_.clear();
+  vertices_.clear();
+  droppedDrawables_ = 0;
+}
+
+void RenderCommandList::addActorMarker(std::uint32_t actor) {
+  DrawRecord rec;
+  rec.firstVertex = static_cast<std::uint32_t>(vertices_.size());
+  rec.actor = actor;
+  records_.push_back(rec);
+}
+
+void RenderCommandList::replay(RenderSink& sink) const {
+  replay(sink, nullptr);
+}
+
+void RenderCommandList::replay(sf::RenderTarget& target) const {
+  TargetRenderSink sink(target);
+  replay(sink);
+}
+
+void RenderCommandList::replay(
+    sf::RenderTarget& target,
+    const std::function<void(std::uint32_t)>& onActor) const {
+  TargetRenderSink sink(target);
+  replay(sink, onActor);
+}
+
+void RenderCommandList::replay(
+    RenderSink& sink, const std::function<void(std::uint32_t)>& onActor) const {
+  for (const auto& rec : records_) {
+    if (rec.actor != DrawRecord::kNoActor) {
+      if (onActor) onActor(rec.actor);
+      continue;
+    }
+    sf::RenderStates states;
+    states.texture = rec.texture;
+    states.transform = rec.transform;
+    states.blendMode = rec.blendMode;
+    sink.draw(vertices_.data() + rec.firstVertex, rec.vertexCount,
+              rec.primitive, states);
+  }
+}
+
+void NullRenderSink::draw(const sf::Vertex* vertices, std::size_t count,
+                          sf::PrimitiveType type,
+                          const sf::RenderStates& states) {
+  ++drawCalls_;
+  vertexCount_ += count;
+
+  mix(textureOrdinal(states.texture));
+  mix(static_cast<std::uint64_t>(type));
+  mix(count);
+  const float* m = states.transform.getMatrix();
+  mix(floatBits(m[12]));
+  mix(floatBits(m[13]));
+  for (std::size_t i = 0; i < count; ++i) {
+    const sf::Vertex& v = vertices[i];
+    mix((static_cast<std::uint64_t>(floatBits(v.position.x)) << 32) |
+        floatBits(v.position.y));
+    mix((static_cast<std::uint64_t>(floatBits(v.texCoords.x)) << 32) |
+        floatBits(v.texCoords.y));
+    mix(v.color.toInteger());
+  }
+}
+
+void NullRenderSink::draw(const sf::Drawable& /*drawable*/,
+                          const sf::RenderStates& states) {
+  ++drawableCount_;
+  mix(textureOrdinal(states.texture));
+}
+
+void NullRenderSink::reset() {
+  textures_.clear();
+  hash_ = 0;
+  drawCalls_ = 0;
+  vertexCount_ = 0;
+  drawableCount_ = 0;
+}
+
+std::uint32_t NullRenderSink::textureOrdinal(const sf::Texture* texture) {
+  if (!texture) return 0;
+  auto it = std::find(textures_.begin(), textures_.end(), texture);
+  if (it != textures_.end()) {
+    return static_cast<std::uint32_t>(it - textures_.begin()) + 1;
+  }
+  textures_.push_back(texture);
+  return static_cast<std::uint32_t>(textures_.size());
+}
+
+void NullRenderSink::mix(std::uint64_t value) {
+  if (hash_ == 0) hash_ = kFnvOffset;
+  for (int i = 0; i < 8; ++i) {
+    hash_ ^= (value >> (i * 8)) & 0xFFu;
+    hash_ *= kFnvPrime;
+  }
+}
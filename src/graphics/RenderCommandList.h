@@ -0,0 +1,146 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef GRAPHICS_RENDERCOMMANDLIST_H_
+#define GRAPHICS_RENDERCOMMANDLIST_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+// Destination for renderer output. WorldRenderer emits into a sink instead of
+// straight into an sf::RenderTarget so the same code path can draw to a
+// window, record a command list, or run headless for benchmarks.
+class RenderSink {
+ public:
+  virtual ~RenderSink() = default;
+
+  // View used for culling. Sinks that wrap a target return the target view.
+  virtual const sf::View& getView() const = 0;
+
+  virtual void draw(const sf::Vertex* vertices, std::size_t count,
+                    sf::PrimitiveType type, const sf::RenderStates& states) = 0;
+
+  // Arbitrary drawables (shapes, text). Only immediate sinks can execute
+  // these; recording sinks count them and drop them.
+  virtual void draw(const sf::Drawable& drawable,
+                    const sf::RenderStates& states) = 0;
+
+  void draw(const sf::VertexArray& va, const sf::RenderStates& states) {
+    if (va.getVertexCount() == 0) return;
+    draw(&va[0], va.getVertexCount(), va.getPrimitiveType(), states);
+  }
+};
+
+// Immediate sink: forwards every draw to an SFML render target.
+class TargetRenderSink : public RenderSink {
+ public:
+  explicit TargetRenderSink(sf::RenderTarget& target) : target_(target) {}
+
+  const sf::View& getView() const override { return target_.getView(); }
+  void draw(const sf::Vertex* vertices, std::size_t count,
+            sf::PrimitiveType type, const sf::RenderStates& states) override {
+    target_.draw(vertices, count, type, states);
+  }
+  void draw(const sf::Drawable& drawable,
+            const sf::RenderStates& states) override {
+    target_.draw(drawable, states);
+  }
+  using RenderSink::draw;
+
+ private:
+  sf::RenderTarget& target_;
+};
+
+// One recorded draw: a vertex range in the owning list plus the render
+// states needed to replay it.
+struct DrawRecord {
+  const sf::Texture* texture = nullptr;
+  sf::PrimitiveType primitive = sf::PrimitiveType::Triangles;
+  std::uint32_t firstVertex = 0;
+  std::uint32_t vertexCount = 0;
+  sf::Transform transform;
+  sf::BlendMode blendMode;
+
+  // Marker records carry no geometry; they stand for an actor drawn at this
+  // point of the stream (see RenderCommandList::addActorMarker).
+  static constexpr std::uint32_t kNoActor = UINT32_MAX;
+  std::uint32_t actor = kNoActor;
+};
+
+// Recording sink. Vertices are copied into a single arena so the list stays
+// valid after the source meshes change and can be replayed later (or on
+// another thread). Storage is reused across clear() calls.
+class RenderCommandList : public RenderSink {
+ public:
+  void setView(const sf::View& view) { view_ = view; }
+  const sf::View& getView() const override { return view_; }
+
+  void draw(const sf::Vertex* vertices, std::size_t count,
+            sf::PrimitiveType type, const sf::RenderStates& states) override;
+  void draw(const sf::Drawable& drawable,
+            const sf::RenderStates& states) override;
+  using RenderSink::draw;
+
+  // Records a placeholder for an actor so depth-sorted streams can be
+  // replayed with actors drawn in between world geometry.
+  void addActorMarker(std::uint32_t actor);
+
+  void clear();
+  // Plain replay skips actor markers; the callback overloads invoke
+  // onActor(actor) at each marker's position in the stream.
+  void replay(RenderSink& sink) const;
+  void replay(sf::RenderTarget& target) const;
+  void replay(RenderSink& sink,
+              const std::function<void(std::uint32_t)>& onActor) const;
+  void replay(sf::RenderTarget& target,
+              const std::function<void(std::uint32_t)>& onActor) const;
+
+  const std::vector<DrawRecord>& records() const { return records_; }
+  const std::vector<sf::Vertex>& vertices() const { return vertices_; }
+  std::size_t droppedDrawables() const { return droppedDrawables_; }
+
+ private:
+  sf::View view_;
+  std::vector<DrawRecord> records_;
+  std::vector<sf::Vertex> vertices_;
+  std::size_t droppedDrawables_ = 0;
+};
+
+// Headless sink: counts draws and folds them into a deterministic hash so
+// benchmark runs can be compared without a window or GPU. Texture pointers
+// are mapped to first-seen ordinals so the hash does not depend on heap
+// addresses.
+class NullRenderSink : public RenderSink {
+ public:
+  void setView(const sf::View& view) { view_ = view; }
+  const sf::View& getView() const override { return view_; }
+
+  void draw(const sf::Vertex* vertices, std::size_t count,
+            sf::PrimitiveType type, const sf::RenderStates& states) override;
+  void draw(const sf::Drawable& drawable,
+            const sf::RenderStates& states) override;
+  using RenderSink::draw;
+
+  void reset();
+
+  std::uint64_t hash() const { return hash_; }
+  std::size_t drawCalls() const { return drawCalls_; }
+  std::size_t vertexCount() const { return vertexCount_; }
+  std::size_t drawableCount() const { return drawableCount_; }
+
+ private:
+  std::uint32_t textureOrdinal(const sf::Texture* texture);
+  void mix(std::uint64_t value);
+
+  sf::View view_;
+  std::vector<const sf::Texture*> textures_;
+  std::uint64_t hash_ = 0;
+  std::size_t drawCalls_ = 0;
+  std::size_t vertexCount_ = 0;
+  std::size_t drawableCount_ = 0;
+};
+
+#endif  // GRAPHICS_RENDERCOMMANDLIST_H_
@@ -0,0 +1,35 @@
+// Copyright 2025 WildSpark Authors
+
+#include "RenderSnapshot.h"
+
+ActorSnapshot& RenderSnapshot::addActor() {
+  if (actorCount == actors.size()) actors.emplace_back();
+  return actors[actorCount++];
+}
+
+void RenderSnapshot::clear() {
+  ground.clear();
+  depth.clear();
+  overlays.clear();
+  actorCount = 0;
+}
+
+void drawActorSnapshot(sf::RenderTarget& target, const ActorSnapshot& actor,
+                       sf::CircleShape& shape, TextBatch* labels) {
+  shape.setRadius(actor.radius);
+  shape.setOrigin({actor.radius, actor.radius});
+  shape.setFillColor(actor.color);
+  shape.setPosition(actor.position);
+  target.draw(shape);
+
+  if (!labels) return;
+  if (!actor.label.empty()) {
+    labels->add(actor.label,
+                {actor.position.x, actor.position.y - actor.radius - 10.f}, 12,
+                sf::Color::White, TextBatch::Anchor::Center);
+  }
+  if (!actor.debugText.empty()) {
+    labels->add(actor.debugText,
+                {actor.position.x - actor.radius, actor.position.y + actor.radius + 5.f}, 10);
+  }
+}
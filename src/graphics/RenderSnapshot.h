@@ -0,0 +1,58 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef GRAPHICS_RENDERSNAPSHOT_H_
+#define GRAPHICS_RENDERSNAPSHOT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "RenderCommandList.h"
+#include "TextBatch.h"
+
+#include <SFML/Graphics.hpp>
+
+// Render-side description of one actor (player, NPC). Plain data so it can
+// be handed to the render thread without touching the owning entity.
+struct ActorSnapshot {
+  sf::Vector2f position;
+  float radius = 0.f;
+  sf::Color color = sf::Color::White;
+  std::string label;
+  std::string debugText;
+};
+
+// Everything the render thread needs to draw one frame: camera, recorded
+// world geometry (already culled) and actors. Produced on the game thread,
+// then treated as immutable until the render thread is done with it.
+//
+// Snapshots are reused frame to frame, so the command lists and actor
+// strings keep their capacity and steady-state capture does not allocate.
+struct RenderSnapshot {
+  std::uint64_t frame = 0;
+  sf::Color clearColor = sf::Color(30, 30, 30);
+  sf::View worldView;
+  RenderCommandList ground;
+  // Depth-sorted objects with actor markers (index into actors).
+  RenderCommandList depth;
+  RenderCommandList overlays;
+
+  // Only the first actorCount entries are valid; the rest are kept around
+  // for reuse.
+  std::vector<ActorSnapshot> actors;
+  std::size_t actorCount = 0;
+
+  // Returns a slot for the next actor, reusing storage when possible.
+  ActorSnapshot& addActor();
+
+  void clear();
+};
+
+// Draws an actor the way Player does: a filled circle now, plus a centred
+// name label above it and debug text below appended to `labels` (if given),
+// which the caller draws once after the world.
+void drawActorSnapshot(sf::RenderTarget& target, const ActorSnapshot& actor,
+                       sf::CircleShape& shape, TextBatch* labels);
+
+#endif  // GRAPHICS_RENDERSNAPSHOT_H_
@@ -0,0 +1,63 @@
+// Copyright 2025 WildSpark Authors
+
+#include "RenderStats.h"
+
+#include <algorithm>
+#include <cmath>
+
+void RenderStats::reset() {
+  drawCalls = 0;
+  vertices = 0;
+  chunksDrawn = 0;
+  chunksCulled = 0;
+  textureSwitches = 0;
+  actorsDrawn = 0;
+  animatedTiles = 0;
+  groundMs = 0.f;
+  depthMs = 0.f;
+  overlaysMs = 0.f;
+  frameMs = 0.f;
+  layers.clear();
+}
+
+FrameTimeHistory::FrameTimeHistory(std::size_t capacity)
+    : samples_(std::max<std::size_t>(capacity, 1), 0.f) {
+  scratch_.reserve(samples_.size());
+}
+
+void FrameTimeHistory::push(float ms) {
+  samples_[head_] = ms;
+  head_ = (head_ + 1) % samples_.size();
+  if (count_ < samples_.size()) ++count_;
+}
+
+void FrameTimeHistory::clear() {
+  std::fill(samples_.begin(), samples_.end(), 0.f);
+  head_ = 0;
+  count_ = 0;
+}
+
+float FrameTimeHistory::percentile(float p) const {
+  if (count_ == 0) return 0.f;
+  scratch_.assign(samples_.begin(), samples_.begin() + count_);
+  const float clamped = std::clamp(p, 0.f, 1.f);
+  // Nearest-rank percentile: the smallest sample with at least p of the
+  // distribution at or below it.
+  std::size_t rank = static_cast<std::size_t>(
+      std::ceil(clamped * static_cast<float>(count_)));
+  if (rank > 0) --rank;
+  std::nth_element(scratch_.begin(), scratch_.begin() + rank, scratch_.end());
+  return scratch_[rank];
+}
+
+float FrameTimeHistory::average() const {
+  if (count_ == 0) return 0.f;
+  float sum = 0.f;
+  for (std::size_t i = 0; i < count_; ++i) sum += samples_[i];
+  return sum / static_cast<float>(count_);
+}
+
+float FrameTimeHistory::max() const {
+  if (count_ == 0) return 0.f;
+  return *std::max_element(samples_.begin(), samples_.begin() + count_);
+}
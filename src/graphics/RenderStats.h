@@ -0,0 +1,71 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef GRAPHICS_RENDERSTATS_H_
+#define GRAPHICS_RENDERSTATS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Counters collected while drawing a single frame. WorldRenderer fills the
+// world part (chunks, draw calls, per-layer timings, the depth-sorted actor
+// pass) and GameScene adds the total frame cost.
+struct RenderStats {
+  struct LayerTiming {
+    std::string_view name;  // points into WorldMap::LayerMesh::name
+    float ms = 0.f;
+    std::uint32_t drawCalls = 0;
+    std::uint32_t vertices = 0;
+  };
+
+  std::uint32_t drawCalls = 0;
+  std::uint32_t vertices = 0;
+  std::uint32_t chunksDrawn = 0;
+  std::uint32_t chunksCulled = 0;
+  std::uint32_t textureSwitches = 0;
+  std::uint32_t actorsDrawn = 0;
+  std::uint32_t animatedTiles = 0;  // animated tiles whose UVs were rewritten
+
+  float groundMs = 0.f;
+  float depthMs = 0.f;  // depth-sorted objects + actors
+  float overlaysMs = 0.f;
+  float frameMs = 0.f;
+
+  std::vector<LayerTiming> layers;
+
+  // Clears all counters but keeps the layer vector capacity so resetting
+  // every frame does not allocate.
+  void reset();
+};
+
+// Fixed-size ring of frame times (milliseconds) used for the rolling graph
+// and percentile readouts.
+class FrameTimeHistory {
+ public:
+  explicit FrameTimeHistory(std::size_t capacity = 240);
+
+  void push(float ms);
+  void clear();
+
+  std::size_t size() const { return count_; }
+  std::size_t capacity() const { return samples_.size(); }
+
+  // p in [0, 1]. Returns 0 when no samples were recorded.
+  float percentile(float p) const;
+  float average() const;
+  float max() const;
+
+  // Raw ring storage and the index of the oldest sample, in the layout
+  // ImGui::PlotLines expects (values + values_offset).
+  const float* data() const { return samples_.data(); }
+  std::size_t offset() const { return count_ < samples_.size() ? 0 : head_; }
+
+ private:
+  std::vector<float> samples_;
+  mutable std::vector<float> scratch_;
+  std::size_t head_ = 0;
+  std::size_t count_ = 0;
+};
+
+#endif  // GRAPHICS_RENDERSTATS_H_
@@ -0,0 +1,69 @@
+// Copyright 2025 WildSpark Authors
+
+#include "RenderStatsPanel.h"
+
+#include "imgui.h"
+
+void RenderStatsPanel::draw(const RenderStats& stats,
+                            const FrameTimeHistory& frameTimes) {
+  if (!visible_) return;
+
+  ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_FirstUseEver);
+  ImGui::SetNextWindowBgAlpha(0.8f);
+  if (!ImGui::Begin("Render Stats", &visible_,
+                    ImGuiWindowFlags_AlwaysAutoResize |
+                        ImGuiWindowFlags_NoFocusOnAppearing)) {
+    ImGui::End();
+    return;
+  }
+
+  const float p50 = frameTimes.percentile(0.50f);
+  const float p95 = frameTimes.percentile(0.95f);
+  const float p99 = frameTimes.percentile(0.99f);
+
+  ImGui::Text("Frame: %.2f ms (avg %.2f, max %.2f)", stats.frameMs,
+              frameTimes.average(), frameTimes.max());
+  ImGui::Text("p50 %.2f ms | p95 %.2f ms | p99 %.2f ms", p50, p95, p99);
+
+  const float graphMax = p99 > 0.f ? p99 * 1.5f : 33.3f;
+  ImGui::PlotLines("##frametimes", frameTimes.data(),
+                   static_cast<int>(frameTimes.size()),
+                   static_cast<int>(frameTimes.offset()), "frame ms", 0.f,
+                   graphMax, ImVec2(320, 60));
+
+  ImGui::Separator();
+  ImGui::Text("Draw calls: %u  Vertices: %u", stats.drawCalls, stats.vertices);
+  ImGui::Text("Chunks drawn: %u  culled: %u", stats.chunksDrawn,
+              stats.chunksCulled);
+  ImGui::Text("Texture switches: %u  Actors: %u", stats.textureSwitches,
+              stats.actorsDrawn);
+  ImGui::Text("Animated tiles updated: %u", stats.animatedTiles);
+  ImGui::Text("Ground %.2f ms | Depth %.2f ms | Overlays %.2f ms",
+              stats.groundMs, stats.depthMs, stats.overlaysMs);
+
+  if (!stats.layers.empty() &&
+      ImGui::BeginTable("layers", 4,
+                        ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                            ImGuiTableFlags_SizingFixedFit)) {
+    ImGui::TableSetupColumn("Layer");
+    ImGui::TableSetupColumn("ms");
+    ImGui::TableSetupColumn("Draws");
+    ImGui::TableSetupColumn("Verts");
+    ImGui::TableHeadersRow();
+    for (const auto& layer : stats.layers) {
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::Text("%.*s", static_cast<int>(layer.name.size()),
+                  layer.name.data());
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", layer.ms);
+      ImGui::TableNextColumn();
+      ImGui::Text("%u", layer.drawCalls);
+      ImGui::TableNextColumn();
+      ImGui::Text("%u", layer.vertices);
+    }
+    ImGui::EndTable();
+  }
+
+  ImGui::End();
+}
@@ -0,0 +1,23 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef GRAPHICS_RENDERSTATSPANEL_H_
+#define GRAPHICS_RENDERSTATSPANEL_H_
+
+#include "RenderStats.h"
+
+// ImGui window showing the last frame's RenderStats and a rolling frame-time
+// graph. Must be drawn between ImGui::SFML::Update and ImGui::SFML::Render,
+// i.e. from a scene's render().
+class RenderStatsPanel {
+ public:
+  void setVisible(bool visible) { visible_ = visible; }
+  bool isVisible() const { return visible_; }
+  void toggle() { visible_ = !visible_; }
+
+  void draw(const RenderStats& stats, const FrameTimeHistory& frameTimes);
+
+ private:
+  bool visible_ = false;
+};
+
+#endif  // GRAPHICS_RENDERSTATSPANEL_H_
@@ -0,0 +1,163 @@
+// Copyright 2025 WildSpark Authors
+
+#include "RenderThread.h"
+
+#include <iostream>
+
+#include "FontCache.h"
+#include "imgui-SFML.h"
+
+RenderThread::RenderThread(sf::RenderWindow& window)
+    : window_(window), labels_(FontCache::instance().defaultFont()) {}
+
+RenderThread::~RenderThread() { stop(); }
+
+void RenderThread::start() {
+  if (running_) return;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopRequested_ = false;
+    pendingIndex_ = -1;
+    pendingSync_ = nullptr;
+  }
+  // A context can only be active on one thread at a time.
+  if (!window_.setActive(false)) {
+    std::cerr << "RenderThread: Failed to release the window context." << std::endl;
+  }
+  running_ = true;
+  thread_ = std::thread(&RenderThread::run, this);
+  std::cout << "RenderThread started" << std::endl;
+}
+
+void RenderThread::stop() {
+  if (!running_) return;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopRequested_ = true;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) thread_.join();
+  running_ = false;
+  cv_.notify_all();
+  if (!window_.setActive(true)) {
+    std::cerr << "RenderThread: Failed to re-activate the window context." << std::endl;
+  }
+  std::cout << "RenderThread stopped after " << framesRendered_ << " frames" << std::endl;
+}
+
+RenderSnapshot& RenderThread::beginFrame() {
+  // Safe without locking: the render thread only reads the buffer it picked
+  // up last, and publish() waits for that frame's UI (and therefore its world
+  // pass) before flipping, so this buffer is no longer in use.
+  RenderSnapshot& snapshot = buffers_[writeIndex_];
+  snapshot.clear();
+  return snapshot;
+}
+
+void RenderThread::publish() {
+  waitForUi();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffers_[writeIndex_].frame = ++publishedFrame_;
+    pendingIndex_ = writeIndex_;
+  }
+  cv_.notify_all();
+  writeIndex_ ^= 1;
+}
+
+void RenderThread::waitForUi() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return uiFrame_ >= publishedFrame_ || !running_; });
+}
+
+void RenderThread::runSync(const std::function<void(sf::RenderWindow&)>& fn) {
+  if (!running_) {
+    fn(window_);
+    window_.display();
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  pendingSync_ = &fn;
+  const std::uint64_t ticket = ++syncRequested_;
+  cv_.notify_all();
+  cv_.wait(lock, [this, ticket] { return syncDone_ >= ticket || !running_; });
+}
+
+void RenderThread::setUiView(const sf::View& view) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  uiView_ = view;
+}
+
+void RenderThread::run() {
+  if (!window_.setActive(true)) {
+    std::cerr << "RenderThread: Failed to activate the window context." << std::endl;
+  }
+
+  for (;;) {
+    int index = -1;
+    const std::function<void(sf::RenderWindow&)>* sync = nullptr;
+    sf::View uiView = window_.getDefaultView();
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] {
+        return stopRequested_ || pendingIndex_ >= 0 || pendingSync_ != nullptr;
+      });
+      // Snapshots published before a sync request are drawn first.
+      if (pendingIndex_ >= 0) {
+        index = pendingIndex_;
+        pendingIndex_ = -1;
+      } else if (pendingSync_) {
+        sync = pendingSync_;
+        pendingSync_ = nullptr;
+      } else {
+        break;  // stop requested and nothing left to draw
+      }
+      if (uiView_) uiView = *uiView_;
+    }
+
+    sf::Clock clock;
+    if (sync) {
+      (*sync)(window_);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++syncDone_;
+      }
+      cv_.notify_all();
+    } else {
+      const RenderSnapshot& snapshot = buffers_[index];
+      renderSnapshot(snapshot);
+      window_.setView(uiView);
+      ImGui::SFML::Render(window_);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uiFrame_ = snapshot.frame;
+      }
+      cv_.notify_all();
+    }
+
+    // Present outside the lock; the game thread is already simulating the
+    // next frame.
+    window_.display();
+    lastRenderMs_ = clock.getElapsedTime().asMicroseconds() / 1000.f;
+    ++framesRendered_;
+  }
+
+  if (!window_.setActive(false)) {
+    std::cerr << "RenderThread: Failed to release the window context." << std::endl;
+  }
+}
+
+void RenderThread::renderSnapshot(const RenderSnapshot& snapshot) {
+  window_.clear(snapshot.clearColor);
+  window_.setView(snapshot.worldView);
+
+  snapshot.ground.replay(window_);
+  labels_.clear();
+  snapshot.depth.replay(window_, [&](std::uint32_t index) {
+    if (index < snapshot.actorCount) {
+      drawActorSnapshot(window_, snapshot.actors[index], actorShape_, &labels_);
+    }
+  });
+  snapshot.overlays.replay(window_);
+  labels_.draw(window_);
+}
@@ -0,0 +1,100 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef GRAPHICS_RENDERTHREAD_H_
+#define GRAPHICS_RENDERTHREAD_H_
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "RenderSnapshot.h"
+#include "TextBatch.h"
+
+#include <SFML/Graphics.hpp>
+
+// Dedicated render thread that owns the window's OpenGL context.
+//
+// The game thread fills a RenderSnapshot (double-buffered), publishes it and
+// moves on to simulating the next frame while the render thread replays the
+// snapshot, renders ImGui and presents. ImGui is not thread-safe, so the
+// game thread must call waitForUi() before touching ImGui again; that only
+// blocks until the previous frame's UI has been submitted, not until
+// display() returns.
+//
+// Per frame on the game thread:
+//   RenderSnapshot& s = rt.beginFrame();   // free buffer, already cleared
+//   ...fill s...
+//   rt.waitForUi();
+//   ImGui::SFML::Update(...); emit widgets;
+//   rt.publish();
+class RenderThread {
+ public:
+  explicit RenderThread(sf::RenderWindow& window);
+  ~RenderThread();
+
+  RenderThread(const RenderThread&) = delete;
+  RenderThread& operator=(const RenderThread&) = delete;
+
+  // Deactivates the window context on the calling thread and starts the
+  // render thread. stop() joins it and re-activates the context on the
+  // caller so shutdown code (ImGui::SFML::Shutdown) can release GL objects.
+  void start();
+  void stop();
+  bool isRunning() const { return running_; }
+
+  // Buffer for the next frame. The render thread never reads it until
+  // publish() is called.
+  RenderSnapshot& beginFrame();
+  void publish();
+
+  // Block until the render thread has rendered the UI of the last published
+  // frame, so ImGui may be updated for the next one.
+  void waitForUi();
+
+  // Run fn on the render thread with the context active, then present.
+  // Blocks the caller until fn has run. Used for scenes that draw straight
+  // into the window instead of producing snapshots.
+  void runSync(const std::function<void(sf::RenderWindow&)>& fn);
+
+  // View used for the UI pass. Set from the game thread on resize.
+  void setUiView(const sf::View& view);
+
+  std::uint64_t framesRendered() const { return framesRendered_; }
+  float lastRenderMs() const { return lastRenderMs_; }
+
+ private:
+  void run();
+  void renderSnapshot(const RenderSnapshot& snapshot);
+
+  sf::RenderWindow& window_;
+  std::thread thread_;
+  std::atomic<bool> running_{false};
+
+  std::array<RenderSnapshot, 2> buffers_;
+  int writeIndex_ = 0;  // game thread only
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopRequested_ = false;
+  int pendingIndex_ = -1;  // published, not yet picked up
+  const std::function<void(sf::RenderWindow&)>* pendingSync_ = nullptr;
+  std::uint64_t publishedFrame_ = 0;
+  std::uint64_t uiFrame_ = 0;
+  std::uint64_t syncDone_ = 0;
+  std::uint64_t syncRequested_ = 0;
+  std::optional<sf::View> uiView_;
+
+  // Render-thread resources for actor drawing.
+  TextBatch labels_;
+  sf::CircleShape actorShape_;
+
+  std::atomic<std::uint64_t> framesRendered_{0};
+  std::atomic<float> lastRenderMs_{0.f};
+};
+
+#endif  // GRAPHICS_RENDERTHREAD_H_
@@ -0,0 +1,114 @@
+// Copyright 2025 WildSpark Authors
+
+#include "TextBatch.h"
+
+#include <algorithm>
+#include <limits>
+
+TextBatch::TextBatch(const sf::Font* font, unsigned int atlasSize)
+    : font_(font), atlasSize_(atlasSize) {}
+
+void TextBatch::layout(std::string_view text, unsigned int characterSize,
+                       sf::Color color, TextLayout& out) const {
+  out.vertices.clear();
+  out.bounds = sf::FloatRect();
+  if (!font_ || text.empty()) return;
+
+  // Same layout rules as sf::Text (regular style, no outline), computed at
+  // the atlas size and scaled to the requested size.
+  const float scale = static_cast<float>(characterSize) / static_cast<float>(atlasSize_);
+  const float whitespace = font_->getGlyph(U' ', atlasSize_, false).advance;
+  const float lineSpacing = font_->getLineSpacing(atlasSize_);
+
+  float x = 0.f;
+  float y = static_cast<float>(atlasSize_);
+  float minX = std::numeric_limits<float>::max(), minY = minX;
+  float maxX = std::numeric_limits<float>::lowest(), maxY = maxX;
+  char32_t prev = 0;
+
+  for (const char c : text) {
+    const char32_t cp = static_cast<unsigned char>(c);
+    if (cp == U'\r') continue;
+    x += font_->getKerning(prev, cp, atlasSize_, false);
+    prev = cp;
+
+    if (cp == U' ' || cp == U'\t' || cp == U'\n') {
+      minX = std::min(minX, x);
+      minY = std::min(minY, y);
+      if (cp == U' ') {
+        x += whitespace;
+      } else if (cp == U'\t') {
+        x += whitespace * 4.f;
+      } else {
+        y += lineSpacing;
+        x = 0.f;
+      }
+      maxX = std::max(maxX, x);
+      maxY = std::max(maxY, y);
+      continue;
+    }
+
+    const sf::Glyph& g = font_->getGlyph(cp, atlasSize_, false);
+    // One pixel of padding around each glyph, as sf::Text does, so bilinear
+    // filtering does not cut off the edges.
+    const float padding = 1.f;
+    const float left = g.bounds.position.x - padding;
+    const float top = g.bounds.position.y - padding;
+    const float right = g.bounds.position.x + g.bounds.size.x + padding;
+    const float bottom = g.bounds.position.y + g.bounds.size.y + padding;
+    const float u1 = static_cast<float>(g.textureRect.position.x) - padding;
+    const float v1 = static_cast<float>(g.textureRect.position.y) - padding;
+    const float u2 = static_cast<float>(g.textureRect.position.x + g.textureRect.size.x) + padding;
+    const float v2 = static_cast<float>(g.textureRect.position.y + g.textureRect.size.y) + padding;
+
+    const sf::Vertex tl{{(x + left) * scale, (y + top) * scale}, color, {u1, v1}};
+    const sf::Vertex tr{{(x + right) * scale, (y + top) * scale}, color, {u2, v1}};
+    const sf::Vertex bl{{(x + left) * scale, (y + bottom) * scale}, color, {u1, v2}};
+    const sf::Vertex br{{(x + right) * scale, (y + bottom) * scale}, color, {u2, v2}};
+    out.vertices.push_back(tl);
+    out.vertices.push_back(tr);
+    out.vertices.push_back(bl);
+    out.vertices.push_back(bl);
+    out.vertices.push_back(tr);
+    out.vertices.push_back(br);
+
+    minX = std::min(minX, x + g.bounds.position.x);
+    maxX = std::max(maxX, x + g.bounds.position.x + g.bounds.size.x);
+    minY = std::min(minY, y + g.bounds.position.y);
+    maxY = std::max(maxY, y + g.bounds.position.y + g.bounds.size.y);
+    x += g.advance;
+  }
+
+  if (minX <= maxX && minY <= maxY) {
+    out.bounds = sf::FloatRect({minX * scale, minY * scale},
+                               {(maxX - minX) * scale, (maxY - minY) * scale});
+  }
+}
+
+void TextBatch::add(const TextLayout& text, sf::Vector2f position, Anchor anchor) {
+  sf::Vector2f origin = text.bounds.position;
+  if (anchor == Anchor::Center) origin += text.bounds.size / 2.f;
+  const sf::Vector2f offset = position - origin;
+  for (sf::Vertex v : text.vertices) {
+    v.position += offset;
+    vertices_.push_back(v);
+  }
+}
+
+void TextBatch::add(std::string_view text, sf::Vector2f position,
+                    unsigned int characterSize, sf::Color color, Anchor anchor) {
+  layout(text, characterSize, color, scratch_);
+  add(scratch_, position, anchor);
+}
+
+void TextBatch::draw(RenderSink& sink, sf::RenderStates states) const {
+  if (vertices_.empty() || !font_) return;
+  // Fetched at draw time: adding glyphs may have grown the atlas.
+  states.texture = &font_->getTexture(atlasSize_);
+  sink.draw(vertices_.data(), vertices_.size(), sf::PrimitiveType::Triangles, states);
+}
+
+void TextBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+  TargetRenderSink sink(target);
+  draw(sink, states);
+}
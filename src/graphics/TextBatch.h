@@ -0,0 +1,68 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef GRAPHICS_TEXTBATCH_H_
+#define GRAPHICS_TEXTBATCH_H_
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "RenderCommandList.h"
+
+#include <SFML/Graphics.hpp>
+
+// Glyph quads for one string, laid out at the origin. Keeping a layout
+// around lets callers re-place unchanged text by translation only.
+struct TextLayout {
+  std::vector<sf::Vertex> vertices;  // triangles, local coordinates
+  sf::FloatRect bounds;              // same convention as sf::Text local bounds
+};
+
+// Batched text renderer. All strings are rasterised at one character size
+// from one shared font, so every glyph lives in the same atlas texture and
+// the whole batch is drawn with a single draw call. Strings requested at
+// other sizes are scaled from the atlas size.
+//
+// Usage per frame:
+//   batch.clear();
+//   batch.add("name", pos, 12, sf::Color::White, TextBatch::Anchor::Center);
+//   ...
+//   batch.draw(target);
+class TextBatch {
+ public:
+  enum class Anchor { TopLeft, Center };
+
+  explicit TextBatch(const sf::Font* font = nullptr, unsigned int atlasSize = 12);
+
+  void setFont(const sf::Font* font) { font_ = font; }
+  const sf::Font* font() const { return font_; }
+  unsigned int atlasSize() const { return atlasSize_; }
+
+  // Builds glyph geometry for `text` (ASCII/Latin-1) at `characterSize`.
+  // Does nothing but clear `out` when no font is set.
+  void layout(std::string_view text, unsigned int characterSize,
+              sf::Color color, TextLayout& out) const;
+
+  // Appends a laid-out string so that the anchor point of its bounds lands
+  // on `position`.
+  void add(const TextLayout& text, sf::Vector2f position, Anchor anchor = Anchor::TopLeft);
+  void add(std::string_view text, sf::Vector2f position, unsigned int characterSize,
+           sf::Color color = sf::Color::White, Anchor anchor = Anchor::TopLeft);
+
+  void clear() { vertices_.clear(); }
+  bool empty() const { return vertices_.empty(); }
+  std::size_t glyphCount() const { return vertices_.size() / 6; }
+  const std::vector<sf::Vertex>& vertices() const { return vertices_; }
+
+  // One draw call for everything added since clear().
+  void draw(RenderSink& sink, sf::RenderStates states = {}) const;
+  void draw(sf::RenderTarget& target, sf::RenderStates states = {}) const;
+
+ private:
+  const sf::Font* font_ = nullptr;
+  unsigned int atlasSize_ = 12;
+  std::vector<sf::Vertex> vertices_;
+  TextLayout scratch_;
+};
+
+#endif  // GRAPHICS_TEXTBATCH_H_
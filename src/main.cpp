@@ -7,6 +7,7 @@
 #include "vendor/dotenv-cpp/dotenv.h"
 #include "account/AccountManager.h"
 #include "auth/AuthManager.h"
+#include "graphics/RenderThread.h"
 #include "input/InputManager.h"
 #include "scenes/CharacterScene/CharacterCreationScene.h"
 #include "scenes/CharacterScene/CharacterSelectionScene.h"
@@ -52,6 +53,15 @@ int main() {
 
   sceneManager.switchTo(SceneType::Login);
 
+  // Optional render thread (RENDER_THREAD=1 in .env). The game thread then
+  // only produces snapshots and the render thread draws and presents them.
+  RenderThread renderThread(window);
+  const bool useRenderThread = dotenv::getenv("RENDER_THREAD", "0") == "1";
+  if (useRenderThread) {
+    renderThread.start();
+    sceneManager.attachRenderThread(&renderThread);
+  }
+
   sf::Clock clock;
 
   while (window.isOpen()) {
@@ -62,6 +72,9 @@ int main() {
         const sf::Event event = oEvent.value();
 
         if (event.is<sf::Event::Closed>()) {
+          // Stop drawing before the context goes away.
+          sceneManager.attachRenderThread(nullptr);
+          renderThread.stop();
           window.close();
         }
 
@@ -72,7 +85,11 @@ int main() {
           sf::Vector2<float> size = {static_cast<float>(resized->size.x),
                                      static_cast<float>(resized->size.y)};
           sf::FloatRect visibleArea({0, 0}, size);
-          window.setView(sf::View(visibleArea));
+          if (renderThread.isRunning()) {
+            renderThread.setUiView(sf::View(visibleArea));
+          } else {
+            window.setView(sf::View(visibleArea));
+          }
         }
       }
     }
@@ -80,6 +97,13 @@ int main() {
     sceneManager.update(window, deltaTime);
     authManager.tick();
 
+    if (renderThread.isRunning()) {
+      // Hands the frame to the render thread, which clears and presents.
+      sceneManager.render(window);
+      inputManager.update();
+      continue;
+    }
+
     // Render the scene manager
     window.clear(sf::Color(30, 30, 30));
     sceneManager.render(window);
@@ -91,6 +115,8 @@ int main() {
     window.display();
   }
 
+  sceneManager.attachRenderThread(nullptr);
+  renderThread.stop();
   sceneManager.shutdown();
 
   return 0;
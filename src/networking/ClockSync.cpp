@@ -0,0 +1,78 @@
+// Copyright 2025 WildSpark Authors
+
+#include "ClockSync.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+double ClockSync::localTime() {
+  using Clock = std::chrono::steady_clock;
+  return std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+}
+
+void ClockSync::reset() {
+  pending_ = {};
+  nextPingAt_ = 0.0;
+  samplesTaken_ = 0;
+  head_ = 0;
+  count_ = 0;
+  lastRtt_ = -1.0;
+  offset_ = rtt_ = jitter_ = 0.0;
+}
+
+bool ClockSync::pollPing(double localNow, std::uint32_t& pingId) {
+  if (localNow < nextPingAt_) return false;
+
+  // Reuse a free or timed-out slot; if all are in flight, skip this ping.
+  PendingPing* slot = nullptr;
+  for (auto& p : pending_) {
+    if (!p.active || localNow - p.sentAt > settings_.timeout) {
+      slot = &p;
+      break;
+    }
+  }
+  if (!slot) return false;
+
+  pingId = nextPingId_++;
+  *slot = {pingId, localNow, true};
+  nextPingAt_ = localNow + (samplesTaken_ < settings_.burstSamples
+                                ? settings_.burstInterval
+                                : settings_.interval);
+  return true;
+}
+
+bool ClockSync::onPong(std::uint32_t pingId, double serverTime, double localNow) {
+  for (auto& p : pending_) {
+    if (!p.active || p.id != pingId) continue;
+    p.active = false;
+    const double rtt = localNow - p.sentAt;
+    if (rtt < 0.0 || rtt > settings_.timeout) return false;
+    addSample(rtt, serverTime + rtt * 0.5 - localNow);
+    return true;
+  }
+  return false;
+}
+
+void ClockSync::addSample(double rtt, double offset) {
+  ++samplesTaken_;
+  samples_[head_] = {rtt, offset};
+  head_ = (head_ + 1) % kWindow;
+  if (count_ < kWindow) ++count_;
+
+  if (lastRtt_ >= 0.0) jitter_ += (std::abs(rtt - lastRtt_) - jitter_) / 16.0;
+  lastRtt_ = rtt;
+
+  // Sort a copy by RTT; the window is tiny, so this is cheap.
+  std::array<Sample, kWindow> sorted;
+  std::copy_n(samples_.begin(), count_, sorted.begin());
+  std::sort(sorted.begin(), sorted.begin() + count_,
+            [](const Sample& a, const Sample& b) { return a.rtt < b.rtt; });
+  rtt_ = sorted[0].rtt;
+
+  const std::size_t best = (count_ + 1) / 2;
+  std::array<double, kWindow> offsets;
+  for (std::size_t i = 0; i < best; ++i) offsets[i] = sorted[i].offset;
+  std::nth_element(offsets.begin(), offsets.begin() + best / 2, offsets.begin() + best);
+  offset_ = offsets[best / 2];
+}
@@ -0,0 +1,80 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef NETWORKING_CLOCKSYNC_H_
+#define NETWORKING_CLOCKSYNC_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Estimates the server clock from ping/pong round trips.
+//
+// Each pong yields one (RTT, offset) sample, offset being
+// serverTime + RTT/2 - localReceiveTime. Samples go into a fixed window:
+// the reported RTT is the window minimum (queueing delay only ever adds),
+// the offset is the median over the lower-RTT half of the window, which
+// rejects samples skewed by asymmetric delays. Jitter is the RFC 3550
+// running mean of RTT deltas.
+//
+// All times are seconds. Local time comes from a steady clock; the methods
+// taking an explicit `localNow` exist so tests can drive the clock.
+class ClockSync {
+ public:
+  static constexpr std::size_t kWindow = 16;
+
+  struct Settings {
+    double interval = 1.0;        // seconds between pings once synced
+    double burstInterval = 0.2;   // until burstSamples have been taken
+    std::size_t burstSamples = 5;
+    double timeout = 5.0;         // pings older than this are forgotten
+  };
+
+  static double localTime();
+
+  void setSettings(const Settings& settings) { settings_ = settings; }
+  const Settings& settings() const { return settings_; }
+  void reset();
+
+  // Returns true and a fresh ping id when a ping is due.
+  bool pollPing(double localNow, std::uint32_t& pingId);
+  // Matches a pong to its ping; unknown or timed-out ids are ignored.
+  bool onPong(std::uint32_t pingId, double serverTime, double localNow);
+
+  bool synced() const { return count_ > 0; }
+  std::size_t sampleCount() const { return count_; }
+  double serverNow() const { return serverNow(localTime()); }
+  double serverNow(double localNow) const { return localNow + offset_; }
+  double offset() const { return offset_; }
+  double rtt() const { return rtt_; }
+  double jitter() const { return jitter_; }
+
+ private:
+  struct Sample {
+    double rtt = 0.0;
+    double offset = 0.0;
+  };
+  struct PendingPing {
+    std::uint32_t id = 0;
+    double sentAt = 0.0;
+    bool active = false;
+  };
+
+  void addSample(double rtt, double offset);
+
+  Settings settings_;
+  std::array<PendingPing, 8> pending_{};
+  std::uint32_t nextPingId_ = 1;
+  double nextPingAt_ = 0.0;
+  std::size_t samplesTaken_ = 0;
+
+  std::array<Sample, kWindow> samples_{};
+  std::size_t head_ = 0;
+  std::size_t count_ = 0;
+  double lastRtt_ = -1.0;
+
+  double offset_ = 0.0;
+  double rtt_ = 0.0;
+  double jitter_ = 0.0;
+};
+
+#endif  // NETWORKING_CLOCKSYNC_H_
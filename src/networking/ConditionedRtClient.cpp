@@ -0,0 +1,247 @@
+// Copyright 2025 WildSpark Authors
+
+#include "ConditionedRtClient.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+#include "../vendor/dotenv-cpp/dotenv.h"
+#include "ClockSync.h"
+
+namespace {
+
+double envNumber(const char* name) {
+  const std::string value = dotenv::getenv(name, "");
+  return value.empty() ? 0.0 : std::max(0.0, std::strtod(value.c_str(), nullptr));
+}
+
+// Heap order for Link::queue_: the earliest packet on top.
+bool releasedAfter(const auto& a, const auto& b) {
+  return a.deliverAt != b.deliverAt ? a.deliverAt > b.deliverAt : a.order > b.order;
+}
+
+}  // namespace
+
+NetworkConditions NetworkConditions::fromEnvironment() {
+  LinkConditions link;
+  link.latencyMs = envNumber("NET_SIM_LATENCY_MS");
+  link.jitterMs = envNumber("NET_SIM_JITTER_MS");
+  link.lossPercent = envNumber("NET_SIM_LOSS");
+  link.reorderPercent = envNumber("NET_SIM_REORDER");
+  link.bandwidthKbps = envNumber("NET_SIM_BANDWIDTH_KBPS");
+
+  NetworkConditions conditions;
+  conditions.send = link;
+  conditions.receive = link;
+  const std::string seed = dotenv::getenv("NET_SIM_SEED", "");
+  if (!seed.empty()) {
+    conditions.seed = static_cast<std::uint32_t>(std::strtoul(seed.c_str(), nullptr, 10));
+  }
+  return conditions;
+}
+
+// ---- Link ----
+
+ConditionedRtClient::Link::Link(const LinkConditions& conditions, std::uint32_t seed)
+    : conditions_(conditions), rng_(seed) {}
+
+void ConditionedRtClient::Link::push(Packet packet, double now) {
+  // Every packet takes the same three draws, so one packet's fate does not
+  // shift the random stream of the next.
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  const double lossDraw = unit(rng_);
+  const double jitterDraw = unit(rng_);
+  const double reorderDraw = unit(rng_);
+
+  if (lossDraw * 100.0 < conditions_.lossPercent) {
+    ++stats_.dropped;
+    return;
+  }
+
+  double sentAt = now;
+  if (conditions_.bandwidthKbps > 0.0) {
+    const double transmit =
+        static_cast<double>(packet.data.data.size()) * 8.0 / (conditions_.bandwidthKbps * 1000.0);
+    sentAt = std::max(now, linkFreeAt_) + transmit;
+    linkFreeAt_ = sentAt;
+  }
+  const double delayMs = conditions_.latencyMs + conditions_.jitterMs * (2.0 * jitterDraw - 1.0);
+  packet.deliverAt = sentAt + std::max(0.0, delayMs) / 1000.0;
+
+  if (reorderDraw * 100.0 < conditions_.reorderPercent) {
+    packet.deliverAt =
+        std::max(packet.deliverAt, lastDeliverAt_) + conditions_.reorderDelayMs / 1000.0;
+    ++stats_.reordered;
+  } else {
+    packet.deliverAt = std::max(packet.deliverAt, lastDeliverAt_);
+    lastDeliverAt_ = packet.deliverAt;
+  }
+  packet.order = nextOrder_++;
+  ++stats_.queued;
+  queue_.push_back(std::move(packet));
+  std::push_heap(queue_.begin(), queue_.end(),
+                 [](const Packet& a, const Packet& b) { return releasedAfter(a, b); });
+}
+
+void ConditionedRtClient::Link::pushInOrder(Packet packet, double now) {
+  const double sentAt = std::max(now, linkFreeAt_);
+  packet.deliverAt = std::max(sentAt + conditions_.latencyMs / 1000.0, lastDeliverAt_);
+  lastDeliverAt_ = packet.deliverAt;
+  packet.order = nextOrder_++;
+  ++stats_.queued;
+  queue_.push_back(std::move(packet));
+  std::push_heap(queue_.begin(), queue_.end(),
+                 [](const Packet& a, const Packet& b) { return releasedAfter(a, b); });
+}
+
+bool ConditionedRtClient::Link::popDue(double now, Packet& out) {
+  if (queue_.empty() || queue_.front().deliverAt > now) return false;
+  std::pop_heap(queue_.begin(), queue_.end(),
+                [](const Packet& a, const Packet& b) { return releasedAfter(a, b); });
+  out = std::move(queue_.back());
+  queue_.pop_back();
+  ++stats_.delivered;
+  stats_.bytesDelivered += out.data.data.size();
+  return true;
+}
+
+void ConditionedRtClient::Link::clear() {
+  stats_.dropped += queue_.size();
+  queue_.clear();
+  lastDeliverAt_ = 0.0;
+  linkFreeAt_ = 0.0;
+}
+
+// ---- ConditionedRtClient ----
+
+ConditionedRtClient::ConditionedRtClient(Nakama::NRtClientPtr inner,
+                                         const NetworkConditions& conditions, Clock clock)
+    : ForwardingRtClient(std::move(inner)),
+      conditions_(conditions),
+      clock_(clock ? std::move(clock) : Clock(&ClockSync::localTime)),
+      send_(conditions.send, conditions.seed),
+      receive_(conditions.receive, conditions.seed ^ 0x9e3779b9u) {}
+
+void ConditionedRtClient::tick() {
+  const double current = now();
+  while (send_.popDue(current, released_)) {
+    inner_->sendMatchData(released_.data.matchId, released_.data.opCode, released_.data.data,
+                          released_.presences);
+  }
+  inner_->tick();
+  while (receive_.popDue(current, released_)) {
+    if (!listener_) continue;
+    if (released_.isPresence) {
+      listener_->onMatchPresence(released_.presence);
+    } else {
+      listener_->onMatchData(released_.data);
+    }
+  }
+}
+
+void ConditionedRtClient::setListener(Nakama::NRtClientListenerInterface* listener) {
+  listener_ = listener;
+  inner_->setListener(listener ? static_cast<Nakama::NRtClientListenerInterface*>(this) : nullptr);
+}
+
+void ConditionedRtClient::disconnect() {
+  send_.clear();
+  receive_.clear();
+  inner_->disconnect();
+}
+
+void ConditionedRtClient::sendMatchData(const std::string& matchId, int64_t opCode,
+                                        const Nakama::NBytes& data,
+                                        const std::vector<Nakama::NUserPresence>& presences) {
+  Link::Packet packet;
+  packet.data.matchId = matchId;
+  packet.data.opCode = opCode;
+  packet.data.data = data;
+  packet.presences = presences;
+  send_.push(std::move(packet), now());
+}
+
+void ConditionedRtClient::onMatchData(const Nakama::NMatchData& data) {
+  Link::Packet packet;
+  packet.data = data;
+  receive_.push(std::move(packet), now());
+}
+
+void ConditionedRtClient::onMatchPresence(const Nakama::NMatchPresenceEvent& presence) {
+  // A leave must not overtake the player's last world updates.
+  Link::Packet packet;
+  packet.isPresence = true;
+  packet.presence = presence;
+  receive_.pushInOrder(std::move(packet), now());
+}
+
+// Everything else reaches the listener as it happens.
+
+void ConditionedRtClient::onConnect() {
+  if (listener_) listener_->onConnect();
+}
+
+void ConditionedRtClient::onDisconnect(const Nakama::NRtClientDisconnectInfo& info) {
+  if (listener_) listener_->onDisconnect(info);
+}
+
+void ConditionedRtClient::onError(const Nakama::NRtError& error) {
+  if (listener_) listener_->onError(error);
+}
+
+void ConditionedRtClient::onChannelMessage(const Nakama::NChannelMessage& message) {
+  if (listener_) listener_->onChannelMessage(message);
+}
+
+void ConditionedRtClient::onChannelPresence(const Nakama::NChannelPresenceEvent& presence) {
+  if (listener_) listener_->onChannelPresence(presence);
+}
+
+void ConditionedRtClient::onMatchmakerMatched(Nakama::NMatchmakerMatchedPtr matched) {
+  if (listener_) listener_->onMatchmakerMatched(std::move(matched));
+}
+
+void ConditionedRtClient::onNotifications(const Nakama::NNotificationList& notifications) {
+  if (listener_) listener_->onNotifications(notifications);
+}
+
+void ConditionedRtClient::onParty(const Nakama::NParty& party) {
+  if (listener_) listener_->onParty(party);
+}
+
+void ConditionedRtClient::onPartyClosed(const Nakama::NPartyClose& close) {
+  if (listener_) listener_->onPartyClosed(close);
+}
+
+void ConditionedRtClient::onPartyData(const Nakama::NPartyData& data) {
+  if (listener_) listener_->onPartyData(data);
+}
+
+void ConditionedRtClient::onPartyJoinRequest(const Nakama::NPartyJoinRequest& request) {
+  if (listener_) listener_->onPartyJoinRequest(request);
+}
+
+void ConditionedRtClient::onPartyLeader(const Nakama::NPartyLeader& leader) {
+  if (listener_) listener_->onPartyLeader(leader);
+}
+
+void ConditionedRtClient::onPartyMatchmakerTicket(const Nakama::NPartyMatchmakerTicket& ticket) {
+  if (listener_) listener_->onPartyMatchmakerTicket(ticket);
+}
+
+void ConditionedRtClient::onPartyPresence(const Nakama::NPartyPresenceEvent& presence) {
+  if (listener_) listener_->onPartyPresence(presence);
+}
+
+void ConditionedRtClient::onStatusPresence(const Nakama::NStatusPresenceEvent& presence) {
+  if (listener_) listener_->onStatusPresence(presence);
+}
+
+void ConditionedRtClient::onStreamData(const Nakama::NStreamData& data) {
+  if (listener_) listener_->onStreamData(data);
+}
+
+void ConditionedRtClient::onStreamPresence(const Nakama::NStreamPresenceEvent& presence) {
+  if (listener_) listener_->onStreamPresence(presence);
+}
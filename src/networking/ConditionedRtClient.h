@@ -0,0 +1,161 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef NETWORKING_CONDITIONEDRTCLIENT_H_
+#define NETWORKING_CONDITIONEDRTCLIENT_H_
+
+#include <nakama-cpp/Nakama.h>
+#include <nakama-cpp/realtime/NRtClientListenerInterface.h>
+#include <nakama-cpp/realtime/rtdata/NMatchData.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ForwardingRtClient.h"
+
+// What one direction of a simulated link does to match data.
+struct LinkConditions {
+  double latencyMs = 0.0;  // one way
+  // Each packet's delay is latencyMs +- up to jitterMs (never below zero).
+  // Jitter alone keeps packets in order.
+  double jitterMs = 0.0;
+  double lossPercent = 0.0;
+  // Share of packets held back reorderDelayMs past their slot, so packets
+  // sent after them overtake them.
+  double reorderPercent = 0.0;
+  double reorderDelayMs = 20.0;
+  // Packets are serialized onto the link at this rate; 0 is unlimited.
+  double bandwidthKbps = 0.0;
+
+  bool active() const {
+    return latencyMs > 0.0 || jitterMs > 0.0 || lossPercent > 0.0 || reorderPercent > 0.0 ||
+           bandwidthKbps > 0.0;
+  }
+};
+
+struct NetworkConditions {
+  LinkConditions send;     // client to server
+  LinkConditions receive;  // server to client
+  std::uint32_t seed = 1;
+
+  bool active() const { return send.active() || receive.active(); }
+
+  // From .env: NET_SIM_LATENCY_MS, NET_SIM_JITTER_MS, NET_SIM_LOSS and
+  // NET_SIM_REORDER (percent), NET_SIM_BANDWIDTH_KBPS and NET_SIM_SEED,
+  // applied to both directions. Unset values are zero.
+  static NetworkConditions fromEnvironment();
+};
+
+// Realtime client decorator that simulates a bad network for match data:
+// latency, jitter, loss, reordering and a bandwidth cap, separately for
+// sends and receives. Random choices come from generators seeded with
+// NetworkConditions::seed, so with a fixed clock and the same calls a run
+// repeats exactly.
+//
+// Held packets are released from tick(): due sends go to the wrapped
+// client, then it is ticked, then due receives reach the listener. Match
+// presence events travel the receive line too, as the server sends them
+// on the same socket: they take the latency and keep their order against
+// match data, but are never lost, jittered or reordered. Connection and
+// join events pass straight through. Like the client it wraps, use it from
+// one thread.
+class ConditionedRtClient : public ForwardingRtClient,
+                            private Nakama::NRtClientListenerInterface {
+ public:
+  using Clock = std::function<double()>;  // seconds
+
+  struct LinkStats {
+    std::uint64_t queued = 0;
+    std::uint64_t delivered = 0;
+    std::uint64_t dropped = 0;
+    std::uint64_t reordered = 0;
+    std::uint64_t bytesDelivered = 0;
+  };
+
+  // `clock` defaults to ClockSync::localTime.
+  ConditionedRtClient(Nakama::NRtClientPtr inner, const NetworkConditions& conditions,
+                      Clock clock = nullptr);
+
+  const NetworkConditions& conditions() const { return conditions_; }
+  const LinkStats& sendStats() const { return send_.stats(); }
+  const LinkStats& receiveStats() const { return receive_.stats(); }
+  std::size_t pendingSends() const { return send_.pending(); }
+  std::size_t pendingReceives() const { return receive_.pending(); }
+
+  void tick() override;
+  void setListener(Nakama::NRtClientListenerInterface* listener) override;
+  void disconnect() override;
+  void sendMatchData(const std::string& matchId, int64_t opCode, const Nakama::NBytes& data,
+                     const std::vector<Nakama::NUserPresence>& presences) override;
+
+ private:
+  // Delay line for one direction.
+  class Link {
+   public:
+    struct Packet {
+      double deliverAt = 0.0;
+      std::uint64_t order = 0;  // ties release in send order
+      Nakama::NMatchData data;
+      std::vector<Nakama::NUserPresence> presences;  // sends only
+      bool isPresence = false;                       // receives only: `presence`, not `data`
+      Nakama::NMatchPresenceEvent presence;
+    };
+
+    Link(const LinkConditions& conditions, std::uint32_t seed);
+
+    void push(Packet packet, double now);
+    // For reliable, ordered traffic: the base latency only, behind
+    // everything already queued.
+    void pushInOrder(Packet packet, double now);
+    // Moves the next packet due by `now` into `out`.
+    bool popDue(double now, Packet& out);
+    void clear();
+
+    std::size_t pending() const { return queue_.size(); }
+    const LinkStats& stats() const { return stats_; }
+
+   private:
+    LinkConditions conditions_;
+    std::mt19937 rng_;
+    std::vector<Packet> queue_;  // min-heap on (deliverAt, order)
+    double lastDeliverAt_ = 0.0;
+    double linkFreeAt_ = 0.0;
+    std::uint64_t nextOrder_ = 0;
+    LinkStats stats_;
+  };
+
+  // Listener side, installed on the wrapped client.
+  void onConnect() override;
+  void onDisconnect(const Nakama::NRtClientDisconnectInfo& info) override;
+  void onError(const Nakama::NRtError& error) override;
+  void onChannelMessage(const Nakama::NChannelMessage& message) override;
+  void onChannelPresence(const Nakama::NChannelPresenceEvent& presence) override;
+  void onMatchmakerMatched(Nakama::NMatchmakerMatchedPtr matched) override;
+  void onMatchData(const Nakama::NMatchData& data) override;
+  void onMatchPresence(const Nakama::NMatchPresenceEvent& presence) override;
+  void onNotifications(const Nakama::NNotificationList& notifications) override;
+  void onParty(const Nakama::NParty& party) override;
+  void onPartyClosed(const Nakama::NPartyClose& close) override;
+  void onPartyData(const Nakama::NPartyData& data) override;
+  void onPartyJoinRequest(const Nakama::NPartyJoinRequest& request) override;
+  void onPartyLeader(const Nakama::NPartyLeader& leader) override;
+  void onPartyMatchmakerTicket(const Nakama::NPartyMatchmakerTicket& ticket) override;
+  void onPartyPresence(const Nakama::NPartyPresenceEvent& presence) override;
+  void onStatusPresence(const Nakama::NStatusPresenceEvent& presence) override;
+  void onStreamData(const Nakama::NStreamData& data) override;
+  void onStreamPresence(const Nakama::NStreamPresenceEvent& presence) override;
+
+  double now() const { return clock_(); }
+
+  NetworkConditions conditions_;
+  Clock clock_;
+  Nakama::NRtClientListenerInterface* listener_ = nullptr;
+  Link send_;
+  Link receive_;
+  Link::Packet released_;  // reused while releasing
+};
+
+#endif  // NETWORKING_CONDITIONEDRTCLIENT_H_
@@ -0,0 +1,388 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef NETWORKING_FORWARDINGRTCLIENT_H_
+#define NETWORKING_FORWARDINGRTCLIENT_H_
+
+#include <nakama-cpp/Nakama.h>
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Realtime client that hands every call to another one. Decorators derive
+// from it and override only what they change; see ConditionedRtClient.
+class ForwardingRtClient : public Nakama::NRtClientInterface {
+ public:
+  explicit ForwardingRtClient(Nakama::NRtClientPtr inner) : inner_(std::move(inner)) {}
+
+  const Nakama::NRtClientPtr& inner() const { return inner_; }
+
+  void tick() override {
+    inner_->tick();
+  }
+
+  Nakama::NRtTransportPtr getTransport() const override {
+    return inner_->getTransport();
+  }
+
+  void setListener(Nakama::NRtClientListenerInterface* listener) override {
+    inner_->setListener(listener);
+  }
+
+  void setUserData(void* userData) override {
+    inner_->setUserData(userData);
+  }
+
+  void* getUserData() const override {
+    return inner_->getUserData();
+  }
+
+  void setHeartbeatIntervalMs(Nakama::opt::optional<int> ms) override {
+    inner_->setHeartbeatIntervalMs(ms);
+  }
+
+  Nakama::opt::optional<int> getHeartbeatIntervalMs() override {
+    return inner_->getHeartbeatIntervalMs();
+  }
+
+  void connect(Nakama::NSessionPtr session, bool createStatus,
+               Nakama::NRtClientProtocol protocol) override {
+    inner_->connect(session, createStatus, protocol);
+  }
+
+  std::future<void> connectAsync(Nakama::NSessionPtr session, bool createStatus,
+                                 Nakama::NRtClientProtocol protocol) override {
+    return inner_->connectAsync(session, createStatus, protocol);
+  }
+
+  bool isConnecting() const override {
+    return inner_->isConnecting();
+  }
+
+  bool isConnected() const override {
+    return inner_->isConnected();
+  }
+
+  void disconnect() override {
+    inner_->disconnect();
+  }
+
+  std::future<void> disconnectAsync() override {
+    return inner_->disconnectAsync();
+  }
+
+  void joinChat(const std::string& target, Nakama::NChannelType type,
+                const Nakama::opt::optional<bool>& persistence,
+                const Nakama::opt::optional<bool>& hidden,
+                std::function<void(Nakama::NChannelPtr)> successCallback,
+                Nakama::RtErrorCallback errorCallback) override {
+    inner_->joinChat(target, type, persistence, hidden, std::move(successCallback),
+                     std::move(errorCallback));
+  }
+
+  void leaveChat(const std::string& channelId, std::function<void()> successCallback,
+                 Nakama::RtErrorCallback errorCallback) override {
+    inner_->leaveChat(channelId, std::move(successCallback), std::move(errorCallback));
+  }
+
+  void writeChatMessage(const std::string& channelId, const std::string& content,
+                        std::function<void(const Nakama::NChannelMessageAck&)> successCallback,
+                        Nakama::RtErrorCallback errorCallback) override {
+    inner_->writeChatMessage(channelId, content, std::move(successCallback),
+                             std::move(errorCallback));
+  }
+
+  void updateChatMessage(const std::string& channelId, const std::string& messageId,
+                         const std::string& content,
+                         std::function<void(const Nakama::NChannelMessageAck&)> successCallback,
+                         Nakama::RtErrorCallback errorCallback) override {
+    inner_->updateChatMessage(channelId, messageId, content, std::move(successCallback),
+                              std::move(errorCallback));
+  }
+
+  void removeChatMessage(const std::string& channelId, const std::string& messageId,
+                         std::function<void(const Nakama::NChannelMessageAck&)> successCallback,
+                         Nakama::RtErrorCallback errorCallback) override {
+    inner_->removeChatMessage(channelId, messageId, std::move(successCallback),
+                              std::move(errorCallback));
+  }
+
+  void createMatch(std::function<void(const Nakama::NMatch&)> successCallback,
+                   Nakama::RtErrorCallback errorCallback) override {
+    inner_->createMatch(std::move(successCallback), std::move(errorCallback));
+  }
+
+  void joinMatch(const std::string& matchId, const Nakama::NStringMap& metadata,
+                 std::function<void(const Nakama::NMatch&)> successCallback,
+                 Nakama::RtErrorCallback errorCallback) override {
+    inner_->joinMatch(matchId, metadata, std::move(successCallback), std::move(errorCallback));
+  }
+
+  void joinMatchByToken(const std::string& token,
+                        std::function<void(const Nakama::NMatch&)> successCallback,
+                        Nakama::RtErrorCallback errorCallback) override {
+    inner_->joinMatchByToken(token, std::move(successCallback), std::move(errorCallback));
+  }
+
+  void leaveMatch(const std::string& matchId, std::function<void()> successCallback,
+                  Nakama::RtErrorCallback errorCallback) override {
+    inner_->leaveMatch(matchId, std::move(successCallback), std::move(errorCallback));
+  }
+
+  void addMatchmaker(const Nakama::opt::optional<int32_t>& minCount,
+                     const Nakama::opt::optional<int32_t>& maxCount,
+                     const Nakama::opt::optional<std::string>& query,
+                     const Nakama::NStringMap& stringProperties,
+                     const Nakama::NStringDoubleMap& numericProperties,
+                     const Nakama::opt::optional<int32_t>& countMultiple,
+                     std::function<void(const Nakama::NMatchmakerTicket&)> successCallback,
+                     Nakama::RtErrorCallback errorCallback) override {
+    inner_->addMatchmaker(minCount, maxCount, query, stringProperties, numericProperties,
+                          countMultiple, std::move(successCallback), std::move(errorCallback));
+  }
+
+  void removeMatchmaker(const std::string& ticket, std::function<void()> successCallback,
+                        Nakama::RtErrorCallback errorCallback) override {
+    inner_->removeMatchmaker(ticket, std::move(successCallback), std::move(errorCallback));
+  }
+
+  void sendMatchData(const std::string& matchId, int64_t opCode, const Nakama::NBytes& data,
+                     const std::vector<Nakama::NUserPresence>& presences) override {
+    inner_->sendMatchData(matchId, opCode, data, presences);
+  }
+
+  void followUsers(const std::vector<std::string>& userIds,
+                   std::function<void(const Nakama::NStatus&)> successCallback,
+                   Nakama::RtErrorCallback errorCallback) override {
+    inner_->followUsers(userIds, std::move(successCallback), std::move(errorCallback));
+  }
+
+  void unfollowUsers(const std::vector<std::string>& userIds, std::function<void()> successCallback,
+                     Nakama::RtErrorCallback errorCallback) override {
+    inner_->unfollowUsers(userIds, std::move(successCallback), std::move(errorCallback));
+  }
+
+  void updateStatus(const std::string& status, std::function<void()> successCallback,
+                    Nakama::RtErrorCallback errorCallback) override {
+    inner_->updateStatus(status, std::move(successCallback), std::move(errorCallback));
+  }
+
+  void rpc(const std::string& id, const Nakama::opt::optional<std::string>& payload,
+           std::function<void(const Nakama::NRpc&)> successCallback,
+           Nakama::RtErrorCallback errorCallback) override {
+    inner_->rpc(id, payload, std::move(successCallback), std::move(errorCallback));
+  }
+
+  void acceptPartyMember(const std::string& partyId, Nakama::NUserPresence& presence,
+                         std::function<void()> successCallback,
+                         Nakama::RtErrorCallback errorCallback) override {
+    inner_->acceptPartyMember(partyId, presence, std::move(successCallback),
+                              std::move(errorCallback));
+  }
+
+  void addMatchmakerParty(
+      const std::string& partyId, const std::string& query, int32_t minCount, int32_t maxCount,
+      const Nakama::NStringMap& stringProperties, const Nakama::NStringDoubleMap& numericProperties,
+      const Nakama::opt::optional<int32_t>& countMultiple,
+      std::function<void(const Nakama::NPartyMatchmakerTicket&)> successCallback,
+      Nakama::RtErrorCallback errorCallback) override {
+    inner_->addMatchmakerParty(partyId, query, minCount, maxCount, stringProperties,
+                               numericProperties, countMultiple, std::move(successCallback),
+                               std::move(errorCallback));
+  }
+
+  void closeParty(const std::string& partyId, std::function<void()> successCallback,
+                  Nakama::RtErrorCallback errorCallback) override {
+    inner_->closeParty(partyId, std::move(successCallback), std::move(errorCallback));
+  }
+
+  void createParty(bool open, int maxSize,
+                   std::function<void(const Nakama::NParty&)> successCallback,
+                   Nakama::RtErrorCallback errorCallback) override {
+    inner_->createParty(open, maxSize, std::move(successCallback), std::move(errorCallback));
+  }
+
+  void joinParty(const std::string& partyId, std::function<void()> successCallback,
+                 Nakama::RtErrorCallback errorCallback) override {
+    inner_->joinParty(partyId, std::move(successCallback), std::move(errorCallback));
+  }
+
+  void leaveParty(const std::string& partyId, std::function<void()> successCallback,
+                  Nakama::RtErrorCallback errorCallback) override {
+    inner_->leaveParty(partyId, std::move(successCallback), std::move(errorCallback));
+  }
+
+  void listPartyJoinRequests(const std::string& partyId,
+                             std::function<void(const Nakama::NPartyJoinRequest&)> successCallback,
+                             Nakama::RtErrorCallback errorCallback) override {
+    inner_->listPartyJoinRequests(partyId, std::move(successCallback), std::move(errorCallback));
+  }
+
+  void promotePartyMember(const std::string& partyId, Nakama::NUserPresence& partyMember,
+                          std::function<void()> successCallback,
+                          Nakama::RtErrorCallback errorCallback) override {
+    inner_->promotePartyMember(partyId, partyMember, std::move(successCallback),
+                               std::move(errorCallback));
+  }
+
+  void removeMatchmakerParty(const std::string& partyId, const std::string& ticket,
+                             std::function<void()> successCallback,
+                             Nakama::RtErrorCallback errorCallback) override {
+    inner_->removeMatchmakerParty(partyId, ticket, std::move(successCallback),
+                                  std::move(errorCallback));
+  }
+
+  void removePartyMember(const std::string& partyId, Nakama::NUserPresence& presence,
+                         std::function<void()> successCallback,
+                         Nakama::RtErrorCallback errorCallback) override {
+    inner_->removePartyMember(partyId, presence, std::move(successCallback),
+                              std::move(errorCallback));
+  }
+
+  void sendPartyData(const std::string& partyId, int64_t opCode, Nakama::NBytes& data) override {
+    inner_->sendPartyData(partyId, opCode, data);
+  }
+
+  std::future<Nakama::NChannelPtr> joinChatAsync(
+      const std::string& target, Nakama::NChannelType type,
+      const Nakama::opt::optional<bool>& persistence,
+      const Nakama::opt::optional<bool>& hidden) override {
+    return inner_->joinChatAsync(target, type, persistence, hidden);
+  }
+
+  std::future<void> leaveChatAsync(const std::string& channelId) override {
+    return inner_->leaveChatAsync(channelId);
+  }
+
+  std::future<Nakama::NChannelMessageAck> writeChatMessageAsync(
+      const std::string& channelId, const std::string& content) override {
+    return inner_->writeChatMessageAsync(channelId, content);
+  }
+
+  std::future<Nakama::NChannelMessageAck> updateChatMessageAsync(
+      const std::string& channelId, const std::string& messageId,
+      const std::string& content) override {
+    return inner_->updateChatMessageAsync(channelId, messageId, content);
+  }
+
+  std::future<void> removeChatMessageAsync(const std::string& channelId,
+                                           const std::string& messageId) override {
+    return inner_->removeChatMessageAsync(channelId, messageId);
+  }
+
+  std::future<Nakama::NMatch> createMatchAsync() override {
+    return inner_->createMatchAsync();
+  }
+
+  std::future<Nakama::NMatch> joinMatchAsync(const std::string& matchId,
+                                             const Nakama::NStringMap& metadata) override {
+    return inner_->joinMatchAsync(matchId, metadata);
+  }
+
+  std::future<Nakama::NMatch> joinMatchByTokenAsync(const std::string& token) override {
+    return inner_->joinMatchByTokenAsync(token);
+  }
+
+  std::future<void> leaveMatchAsync(const std::string& matchId) override {
+    return inner_->leaveMatchAsync(matchId);
+  }
+
+  std::future<Nakama::NMatchmakerTicket> addMatchmakerAsync(
+      const Nakama::opt::optional<int32_t>& minCount,
+      const Nakama::opt::optional<int32_t>& maxCount,
+      const Nakama::opt::optional<std::string>& query, const Nakama::NStringMap& stringProperties,
+      const Nakama::NStringDoubleMap& numericProperties,
+      const Nakama::opt::optional<int32_t>& countMultiple) override {
+    return inner_->addMatchmakerAsync(minCount, maxCount, query, stringProperties,
+                                      numericProperties, countMultiple);
+  }
+
+  std::future<void> removeMatchmakerAsync(const std::string& ticket) override {
+    return inner_->removeMatchmakerAsync(ticket);
+  }
+
+  std::future<void> sendMatchDataAsync(
+      const std::string& matchId, std::int64_t opCode, const Nakama::NBytes& data,
+      const std::vector<Nakama::NUserPresence>& presences) override {
+    return inner_->sendMatchDataAsync(matchId, opCode, data, presences);
+  }
+
+  std::future<Nakama::NStatus> followUsersAsync(const std::vector<std::string>& userIds) override {
+    return inner_->followUsersAsync(userIds);
+  }
+
+  std::future<void> unfollowUsersAsync(const std::vector<std::string>& userIds) override {
+    return inner_->unfollowUsersAsync(userIds);
+  }
+
+  std::future<void> updateStatusAsync(const std::string& status) override {
+    return inner_->updateStatusAsync(status);
+  }
+
+  std::future<Nakama::NRpc> rpcAsync(const std::string& id,
+                                     const Nakama::opt::optional<std::string>& payload) override {
+    return inner_->rpcAsync(id, payload);
+  }
+
+  std::future<void> acceptPartyMemberAsync(const std::string& partyId,
+                                           Nakama::NUserPresence& presence) override {
+    return inner_->acceptPartyMemberAsync(partyId, presence);
+  }
+
+  std::future<Nakama::NPartyMatchmakerTicket> addMatchmakerPartyAsync(
+      const std::string& partyId, const std::string& query, int32_t minCount, int32_t maxCount,
+      const Nakama::NStringMap& stringProperties, const Nakama::NStringDoubleMap& numericProperties,
+      const Nakama::opt::optional<int32_t>& countMultiple) override {
+    return inner_->addMatchmakerPartyAsync(partyId, query, minCount, maxCount, stringProperties,
+                                           numericProperties, countMultiple);
+  }
+
+  std::future<void> closePartyAsync(const std::string& partyId) override {
+    return inner_->closePartyAsync(partyId);
+  }
+
+  std::future<Nakama::NParty> createPartyAsync(bool open, int maxSize) override {
+    return inner_->createPartyAsync(open, maxSize);
+  }
+
+  std::future<void> joinPartyAsync(const std::string& partyId) override {
+    return inner_->joinPartyAsync(partyId);
+  }
+
+  std::future<void> leavePartyAsync(const std::string& partyId) override {
+    return inner_->leavePartyAsync(partyId);
+  }
+
+  std::future<Nakama::NPartyJoinRequest> listPartyJoinRequestsAsync(
+      const std::string& partyId) override {
+    return inner_->listPartyJoinRequestsAsync(partyId);
+  }
+
+  std::future<void> promotePartyMemberAsync(const std::string& partyId,
+                                            Nakama::NUserPresence& partyMember) override {
+    return inner_->promotePartyMemberAsync(partyId, partyMember);
+  }
+
+  std::future<void> removeMatchmakerPartyAsync(const std::string& partyId,
+                                               const std::string& ticket) override {
+    return inner_->removeMatchmakerPartyAsync(partyId, ticket);
+  }
+
+  std::future<void> removePartyMemberAsync(const std::string& partyId,
+                                           Nakama::NUserPresence& presence) override {
+    return inner_->removePartyMemberAsync(partyId, presence);
+  }
+
+  std::future<void> sendPartyDataAsync(const std::string& partyId, int64_t opCode,
+                                       Nakama::NBytes& data) override {
+    return inner_->sendPartyDataAsync(partyId, opCode, data);
+  }
+
+ protected:
+  Nakama::NRtClientPtr inner_;
+};
+
+#endif  // NETWORKING_FORWARDINGRTCLIENT_H_
@@ -0,0 +1,58 @@
+// Copyright 2025 WildSpark Authors
+
+#include "IdInterner.h"
+
+#include <utility>
+
+PlayerHandle IdInterner::intern(std::string_view id) {
+  auto it = handles_.find(id);
+  if (it != handles_.end()) return it->second;
+
+  PlayerHandle handle;
+  if (!freeHandles_.empty()) {
+    handle = freeHandles_.back();
+    freeHandles_.pop_back();
+    names_[handle].assign(id);
+  } else {
+    handle = static_cast<PlayerHandle>(names_.size());
+    names_.emplace_back(id);
+  }
+
+  if (!freeNodes_.empty()) {
+    // Reuse a released node (and its key's buffer) instead of allocating.
+    Map::node_type node = std::move(freeNodes_.back());
+    freeNodes_.pop_back();
+    node.key().assign(id);
+    node.mapped() = handle;
+    handles_.insert(std::move(node));
+  } else {
+    handles_.emplace(names_[handle], handle);
+  }
+  return handle;
+}
+
+void IdInterner::release(PlayerHandle handle) {
+  if (handle >= names_.size()) return;
+  auto it = handles_.find(names_[handle]);
+  if (it == handles_.end() || it->second != handle) return;
+  freeNodes_.push_back(handles_.extract(it));
+  names_[handle].clear();
+  freeHandles_.push_back(handle);
+}
+
+PlayerHandle IdInterner::find(std::string_view id) const {
+  auto it = handles_.find(id);
+  return it == handles_.end() ? kInvalidPlayerHandle : it->second;
+}
+
+const std::string& IdInterner::name(PlayerHandle handle) const {
+  static const std::string kEmpty;
+  return handle < names_.size() ? names_[handle] : kEmpty;
+}
+
+void IdInterner::clear() {
+  handles_.clear();
+  names_.clear();
+  freeHandles_.clear();
+  freeNodes_.clear();
+}
@@ -0,0 +1,55 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef NETWORKING_IDINTERNER_H_
+#define NETWORKING_IDINTERNER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Compact handle for a network user id. Handles are dense (0, 1, 2, ...) so
+// they can index plain arrays.
+using PlayerHandle = std::uint32_t;
+constexpr PlayerHandle kInvalidPlayerHandle = UINT32_MAX;
+
+// Maps network user ids to 32-bit handles. An id is copied once, the first
+// time it is seen (on join); after that, lookups take a string_view and cost
+// a single hash probe with no allocation. A handle stays valid until it is
+// released (on leave); released handles and their storage are reused by
+// later joins, so join/leave churn does not grow the table.
+class IdInterner {
+ public:
+  // Handle for `id`, assigning a new one if the id has not been seen yet.
+  PlayerHandle intern(std::string_view id);
+  // Handle for `id`, or kInvalidPlayerHandle. Never allocates.
+  PlayerHandle find(std::string_view id) const;
+
+  // Network id for a handle (empty for unknown handles).
+  const std::string& name(PlayerHandle handle) const;
+  // Forget a handle; the next new id may be given the same handle.
+  void release(PlayerHandle handle);
+  // Number of live handles.
+  std::size_t size() const { return handles_.size(); }
+  void clear();
+
+ private:
+  // Transparent hash so string_view lookups do not build a std::string.
+  struct Hash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const {
+      return std::hash<std::string_view>{}(s);
+    }
+  };
+
+  using Map = std::unordered_map<std::string, PlayerHandle, Hash, std::equal_to<>>;
+  Map handles_;
+  std::vector<std::string> names_;
+  std::vector<PlayerHandle> freeHandles_;
+  std::vector<Map::node_type> freeNodes_;  // map nodes kept for reuse
+};
+
+#endif  // NETWORKING_IDINTERNER_H_
@@ -0,0 +1,60 @@
+// Copyright 2025 WildSpark Authors
+
+#include "InputScheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+InputScheduler::InputScheduler(const InputSchedulerSettings& settings) {
+  setSettings(settings);
+}
+
+void InputScheduler::setSettings(const InputSchedulerSettings& settings) {
+  settings_ = settings;
+  settings_.sendRate = std::max(settings_.sendRate, 1.f);
+  settings_.redundancy = std::min(settings_.redundancy, kMaxRedundancy);
+}
+
+bool InputScheduler::intentChanged() const {
+  // Before the first input the server assumes the player stands still.
+  const sf::Vector2f last = historySize_ ? history_[historySize_ - 1].velocity : sf::Vector2f();
+  const sf::Vector2f d = intent_ - last;
+  return d.x * d.x + d.y * d.y > settings_.mergeTolerance * settings_.mergeTolerance;
+}
+
+bool InputScheduler::update(sf::Time dt, const std::function<unsigned int()>& nextSequence) {
+  const float interval = 1.f / settings_.sendRate;
+  sinceTick_ += dt.asSeconds();
+  if (sinceTick_ < interval) return false;
+  sinceTick_ -= interval;
+  // A long frame sends once rather than catching up on missed ticks.
+  if (sinceTick_ >= interval) sinceTick_ = 0.f;
+
+  if (intentChanged()) {
+    if (historySize_ == history_.size()) {
+      std::move(history_.begin() + 1, history_.end(), history_.begin());
+      --historySize_;
+    }
+    history_[historySize_++] = {nextSequence(), intent_};
+    resendsLeft_ = settings_.redundancy;
+    ++inputsCommitted_;
+  } else if (resendsLeft_ > 0) {
+    --resendsLeft_;
+  } else {
+    return false;
+  }
+  ++packetsSent_;
+  return true;
+}
+
+std::span<const wire::PlayerInput> InputScheduler::packet() const {
+  const std::size_t n = std::min(historySize_, settings_.redundancy + 1);
+  return {history_.data() + historySize_ - n, n};
+}
+
+void InputScheduler::reset() {
+  intent_ = {};
+  sinceTick_ = 0.f;
+  resendsLeft_ = 0;
+  historySize_ = 0;
+}
@@ -0,0 +1,76 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef NETWORKING_INPUTSCHEDULER_H_
+#define NETWORKING_INPUTSCHEDULER_H_
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <span>
+
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "WireProtocol.h"
+
+struct InputSchedulerSettings {
+  float sendRate = 20.f;       // packets per second at most
+  std::size_t redundancy = 2;  // earlier inputs repeated in each packet
+  float mergeTolerance = 1.f;  // velocity change (px/s) still treated as the same input
+};
+
+// Decouples movement input from the frame rate.
+//
+// The scene samples the movement intent every frame; on each network tick
+// the latest intent becomes a new numbered input only if it differs from
+// the previous one. Each packet carries the newest input plus up to
+// `redundancy` earlier ones, and is resent on the following ticks until it
+// has gone out `redundancy` more times, so a single lost packet never
+// loses an input. Holding one direction therefore costs a few packets, not
+// one per frame.
+class InputScheduler {
+ public:
+  static constexpr std::size_t kMaxRedundancy = 7;
+
+  explicit InputScheduler(const InputSchedulerSettings& settings = {});
+
+  void setSettings(const InputSchedulerSettings& settings);
+  const InputSchedulerSettings& settings() const { return settings_; }
+
+  // Latest movement intent; cheap, call every frame.
+  void sample(sf::Vector2f velocity) { intent_ = velocity; }
+  // Advances the send clock. On a tick where the intent changed, a new
+  // input is numbered by `nextSequence`. True when a packet is due; its
+  // inputs are then in packet().
+  bool update(sf::Time dt, const std::function<unsigned int()>& nextSequence);
+  // Inputs for the due packet, oldest first.
+  std::span<const wire::PlayerInput> packet() const;
+  // Newest committed input, which is what the server moves the player with
+  // once it arrives; sequence 0 and no velocity before the first.
+  wire::PlayerInput latest() const {
+    return historySize_ ? history_[historySize_ - 1] : wire::PlayerInput{};
+  }
+
+  // Forgets history and pending resends, e.g. on match change.
+  void reset();
+
+  std::size_t packetsSent() const { return packetsSent_; }
+  std::size_t inputsCommitted() const { return inputsCommitted_; }
+
+ private:
+  bool intentChanged() const;
+
+  InputSchedulerSettings settings_;
+  sf::Vector2f intent_;
+  float sinceTick_ = 0.f;
+  std::size_t resendsLeft_ = 0;
+
+  // Newest inputs, oldest first.
+  std::array<wire::PlayerInput, kMaxRedundancy + 1> history_{};
+  std::size_t historySize_ = 0;
+
+  std::size_t packetsSent_ = 0;
+  std::size_t inputsCommitted_ = 0;
+};
+
+#endif  // NETWORKING_INPUTSCHEDULER_H_
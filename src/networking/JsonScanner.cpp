@@ -0,0 +1,234 @@
+// Copyright 2025 WildSpark Authors
+
+#include "JsonScanner.h"
+
+#include <bit>
+#include <charconv>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define WILDSPARK_JSON_SSE2 1
+#endif
+
+namespace {
+
+// Byte scans used by strings and skipped values. With SSE2 they test 16
+// bytes per step; elsewhere they fall back to a plain loop.
+
+bool isQuoteOrEscape(char c) { return c == '"' || c == '\\'; }
+
+bool isStructural(char c) {
+  return c == '"' || c == '\\' || c == '{' || c == '}' || c == '[' || c == ']';
+}
+
+#ifdef WILDSPARK_JSON_SSE2
+// Bit i of the result is set when byte i of the block equals any of `cs`.
+template <typename... Chars>
+unsigned matchMask(__m128i block, Chars... cs) {
+  __m128i hits = _mm_setzero_si128();
+  ((hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8(cs)))), ...);
+  return static_cast<unsigned>(_mm_movemask_epi8(hits));
+}
+#endif
+
+// First byte in [p, end) that is '"' or '\\', or end.
+const char* findQuoteOrEscape(const char* p, const char* end) {
+#ifdef WILDSPARK_JSON_SSE2
+  for (; end - p >= 16; p += 16) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    if (const unsigned mask = matchMask(block, '"', '\\')) return p + std::countr_zero(mask);
+  }
+#endif
+  while (p < end && !isQuoteOrEscape(*p)) ++p;
+  return p;
+}
+
+// First byte in [p, end) that is a quote, escape or bracket, or end.
+const char* findStructural(const char* p, const char* end) {
+#ifdef WILDSPARK_JSON_SSE2
+  for (; end - p >= 16; p += 16) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    if (const unsigned mask = matchMask(block, '"', '\\', '{', '}', '[', ']')) {
+      return p + std::countr_zero(mask);
+    }
+  }
+#endif
+  while (p < end && !isStructural(*p)) ++p;
+  return p;
+}
+
+}  // namespace
+
+void JsonScanner::skipWhitespace() {
+  while (p_ < end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\n' || *p_ == '\r')) ++p_;
+}
+
+bool JsonScanner::consume(char c) {
+  skipWhitespace();
+  if (p_ < end_ && *p_ == c) {
+    ++p_;
+    return true;
+  }
+  return false;
+}
+
+char JsonScanner::peek() {
+  skipWhitespace();
+  return ok_ && p_ < end_ ? *p_ : '\0';
+}
+
+bool JsonScanner::enterObject() {
+  if (!ok_ || !consume('{')) return fail();
+  afterMember_ = false;
+  return true;
+}
+
+bool JsonScanner::nextKey(std::string_view& key) {
+  if (!ok_) return false;
+  if (consume('}')) {
+    afterMember_ = true;  // the object itself was a member value
+    return false;
+  }
+  if (afterMember_ && !consume(',')) return fail();
+  if (!readString(key) || !consume(':')) return fail();
+  afterMember_ = false;
+  return true;
+}
+
+bool JsonScanner::readString(std::string_view& out) {
+  if (!ok_ || !consume('"')) return fail();
+  const char* start = p_;
+  lastEscaped_ = false;
+  if (!skipStringBody()) return fail();
+  out = std::string_view(start, static_cast<std::size_t>(p_ - start));
+  ++p_;
+  afterMember_ = true;
+  return true;
+}
+
+bool JsonScanner::readNumber(float& out) {
+  if (!ok_) return false;
+  skipWhitespace();
+  // from_chars rejects the leading '+' JSON rejects too, and stops at the
+  // first character that can't continue the number.
+  const auto [next, ec] = std::from_chars(p_, end_, out);
+  if (ec != std::errc()) return fail();
+  p_ = next;
+  afterMember_ = true;
+  return true;
+}
+
+bool JsonScanner::readNumber(double& out) {
+  if (!ok_) return false;
+  skipWhitespace();
+  const auto [next, ec] = std::from_chars(p_, end_, out);
+  if (ec != std::errc()) return fail();
+  p_ = next;
+  afterMember_ = true;
+  return true;
+}
+
+bool JsonScanner::readBool(bool& out) {
+  if (!ok_) return false;
+  skipWhitespace();
+  const std::string_view rest(p_, static_cast<std::size_t>(end_ - p_));
+  if (rest.starts_with("true")) {
+    out = true;
+    p_ += 4;
+  } else if (rest.starts_with("false")) {
+    out = false;
+    p_ += 5;
+  } else {
+    return fail();
+  }
+  afterMember_ = true;
+  return true;
+}
+
+bool JsonScanner::skipValue(std::string_view* raw) {
+  if (!ok_) return false;
+  skipWhitespace();
+  const char* start = p_;
+  bool skipped = false;
+  if (p_ < end_) {
+    switch (*p_) {
+      case '"':
+        ++p_;
+        skipped = skipStringBody();
+        if (skipped) ++p_;
+        break;
+      case '{':
+      case '[':
+        skipped = skipContainer();
+        break;
+      default:
+        // Number or literal: everything up to the next delimiter.
+        while (p_ < end_ && *p_ != ',' && *p_ != '}' && *p_ != ']' && *p_ != ' ' &&
+               *p_ != '\t' && *p_ != '\n' && *p_ != '\r') {
+          ++p_;
+        }
+        skipped = p_ != start;
+    }
+  }
+  if (!skipped) return fail();
+  if (raw) *raw = std::string_view(start, static_cast<std::size_t>(p_ - start));
+  afterMember_ = true;
+  return true;
+}
+
+bool JsonScanner::skipStringBody() {
+  for (;;) {
+    p_ = findQuoteOrEscape(p_, end_);
+    if (p_ == end_) return false;
+    if (*p_ == '"') return true;
+    lastEscaped_ = true;
+    if (end_ - p_ < 2) return false;
+    p_ += 2;  // the escaped character can't end the string
+  }
+}
+
+bool JsonScanner::skipContainer() {
+  // Only brackets and strings matter for finding the end, so the scan jumps
+  // between structural bytes; the values in between are not validated.
+  char closers[kMaxDepth];
+  int depth = 0;
+  for (;;) {
+    p_ = findStructural(p_, end_);
+    if (p_ == end_) return false;
+    switch (*p_++) {
+      case '{':
+      case '[':
+        if (depth == kMaxDepth) return false;
+        closers[depth++] = p_[-1] == '{' ? '}' : ']';
+        break;
+      case '}':
+      case ']':
+        if (closers[--depth] != p_[-1]) return false;
+        if (depth == 0) return true;
+        break;
+      case '"':
+        if (!skipStringBody()) return false;
+        ++p_;
+        break;
+      default:  // an escape outside a string
+        return false;
+    }
+  }
+}
+
+bool splitJsonMessage(std::string_view bytes, std::string_view& type, std::string_view& data) {
+  JsonScanner message(bytes);
+  std::string_view key;
+  type = {};
+  data = {};
+  if (message.enterObject()) {
+    while (message.nextKey(key)) {
+      if (key == "type" && message.peek() == '"') {
+        message.readString(type);
+      } else {
+        message.skipValue(key == "data" ? &data : nullptr);
+      }
+    }
+  }
+  return message.ok();
+}
@@ -0,0 +1,70 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef NETWORKING_JSONSCANNER_H_
+#define NETWORKING_JSONSCANNER_H_
+
+#include <cstddef>
+#include <string_view>
+
+// Forward-only JSON reader over a byte buffer, for the hot match messages
+// where building an nlohmann DOM per message is too expensive. Strings come
+// back as views into the buffer and numbers are parsed in place, so reading
+// never allocates.
+//
+// Strings are returned raw: escape sequences are left as written and
+// reported through lastStringEscaped(), so callers needing the decoded text
+// must treat those strings specially. Any syntax error clears ok() and
+// every later call fails.
+class JsonScanner {
+ public:
+  explicit JsonScanner(std::string_view text) : p_(text.data()), end_(p_ + text.size()) {}
+
+  bool ok() const { return ok_; }
+  // Whether the last key or string read contained a backslash escape.
+  bool lastStringEscaped() const { return lastEscaped_; }
+  // Next significant character without consuming it; '\0' at the end.
+  char peek();
+
+  // Consumes '{'. Then call nextKey() until it returns false, reading or
+  // skipping each member's value in between.
+  bool enterObject();
+  // Reads the next member key and its ':'; false (and the closing '}'
+  // consumed) at the end of the object.
+  bool nextKey(std::string_view& key);
+
+  bool readString(std::string_view& out);
+  bool readNumber(float& out);
+  bool readNumber(double& out);
+  bool readBool(bool& out);
+  // Skips one value of any type; `raw` receives its exact text. Objects and
+  // arrays are skipped by a vectorised scan for brackets and quotes, which
+  // checks nesting but not the values inside.
+  bool skipValue(std::string_view* raw = nullptr);
+
+ private:
+  static constexpr int kMaxDepth = 64;
+
+  void skipWhitespace();
+  bool consume(char c);
+  bool fail() {
+    ok_ = false;
+    return false;
+  }
+  // Advance p_ to the closing quote / past the closing bracket.
+  bool skipStringBody();
+  bool skipContainer();
+
+  const char* p_;
+  const char* end_;
+  bool ok_ = true;
+  bool lastEscaped_ = false;
+  bool afterMember_ = false;  // a member was read; ',' or '}' must follow
+};
+
+// Splits a match message {"type": "...", "data": ...} into the type string
+// and the raw text of the data value, without decoding either. Members may
+// come in any order; a missing one leaves its view empty. False when the
+// message is not a well-formed object.
+bool splitJsonMessage(std::string_view bytes, std::string_view& type, std::string_view& data);
+
+#endif  // NETWORKING_JSONSCANNER_H_
@@ -0,0 +1,74 @@
+// Copyright 2025 WildSpark Authors
+
+#include "JsonWorldUpdateReader.h"
+
+namespace {
+
+bool isNumberStart(char c) { return c == '-' || (c >= '0' && c <= '9'); }
+
+// The value of top-level "data". "type" may come after "data" (sorted-key
+// encoders put it last), so the data is skipped first and read by a second
+// scanner.
+std::string_view findData(std::string_view bytes, bool& isWorldUpdate, bool& ok) {
+  std::string_view type, data;
+  ok = splitJsonMessage(bytes, type, data);
+  isWorldUpdate = ok && type == "world_update";
+  return isWorldUpdate ? data : std::string_view();
+}
+
+}  // namespace
+
+JsonWorldUpdateReader::JsonWorldUpdateReader(std::string_view bytes)
+    : scanner_(findData(bytes, isWorldUpdate_, ok_)) {
+  if (!isWorldUpdate_ || scanner_.peek() != '{') return;
+
+  scanner_.enterObject();
+  std::string_view key;
+  while (scanner_.nextKey(key)) {
+    if (key == "players" && scanner_.peek() == '{') {
+      scanner_.enterObject();
+      inPlayers_ = true;
+      return;
+    }
+    scanner_.skipValue();
+  }
+}
+
+bool JsonWorldUpdateReader::next(Entry& out) {
+  JsonScanner& s = scanner_;
+  while (inPlayers_ && s.nextKey(out.userId)) {
+    // User ids never need escaping; an escaped one can't be looked up raw.
+    const bool usable = !s.lastStringEscaped();
+    if (s.peek() != '{') {
+      s.skipValue();
+      continue;
+    }
+    s.enterObject();
+    bool hasPosition = false;
+    out.position = {};
+    std::string_view field;
+    while (s.nextKey(field)) {
+      if (field != "position" || s.peek() != '{') {
+        s.skipValue();
+        continue;
+      }
+      hasPosition = true;
+      s.enterObject();
+      std::string_view axis;
+      while (s.nextKey(axis)) {
+        const bool number = isNumberStart(s.peek());
+        if (number && axis == "x") {
+          s.readNumber(out.position.x);
+        } else if (number && axis == "y") {
+          s.readNumber(out.position.y);
+        } else {
+          s.skipValue();
+        }
+      }
+    }
+    if (!s.ok()) break;
+    if (hasPosition && usable) return true;
+  }
+  inPlayers_ = false;
+  return false;
+}
@@ -0,0 +1,42 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef NETWORKING_JSONWORLDUPDATEREADER_H_
+#define NETWORKING_JSONWORLDUPDATEREADER_H_
+
+#include <string_view>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "JsonScanner.h"
+
+// On-demand decoder for the JSON world_update schema
+//   {"type": "world_update",
+//    "data": {"players": {"<userId>": {"position": {"x": 1, "y": 2}}}}}
+// mirroring wire::WorldUpdateReader: players are read one at a time
+// straight from the message bytes, with no DOM and no allocation. Members
+// may come in any order and unknown ones are skipped.
+class JsonWorldUpdateReader {
+ public:
+  struct Entry {
+    std::string_view userId;  // points into the message
+    sf::Vector2f position;
+  };
+
+  explicit JsonWorldUpdateReader(std::string_view bytes);
+
+  // False when the message has another type; next() then returns nothing.
+  bool isWorldUpdate() const { return isWorldUpdate_; }
+  bool ok() const { return ok_ && scanner_.ok(); }
+  // False once all players are read or the message is malformed. Players
+  // without a position, or whose id needs unescaping, are skipped.
+  bool next(Entry& out);
+
+ private:
+  // Set by the scanner's initialiser, so declared before it.
+  bool isWorldUpdate_ = false;
+  bool ok_ = false;
+  JsonScanner scanner_;
+  bool inPlayers_ = false;
+};
+
+#endif  // NETWORKING_JSONWORLDUPDATEREADER_H_
@@ -0,0 +1,261 @@
+// Copyright 2025 WildSpark Authors
+
+#include "MessageRegistry.h"
+
+#include <limits>
+#include <type_traits>
+
+#include "ClockSync.h"
+#include "JsonScanner.h"
+#include "JsonWorldUpdateReader.h"
+#include "WireProtocol.h"
+
+namespace {
+
+bool isNumberStart(char c) { return c == '-' || (c >= '0' && c <= '9'); }
+
+// Member values of an unexpected type are skipped, leaving `out` untouched;
+// the return value says whether `out` was set.
+template <typename T>
+bool readNumberValue(JsonScanner& s, T& out) {
+  if (!isNumberStart(s.peek())) {
+    s.skipValue();
+    return false;
+  }
+  double value = 0.0;
+  if (!s.readNumber(value)) return false;
+  if constexpr (std::is_unsigned_v<T>) {
+    if (value < 0.0 || value > static_cast<double>(std::numeric_limits<T>::max())) return false;
+  }
+  out = static_cast<T>(value);
+  return true;
+}
+
+bool readBoolValue(JsonScanner& s, bool& out) {
+  const char c = s.peek();
+  if (c != 't' && c != 'f') {
+    s.skipValue();
+    return false;
+  }
+  return s.readBool(out);
+}
+
+// The "data" object of a JSON message of the given type. False (with
+// `malformed` set accordingly) when there is nothing to decode.
+bool enterJsonData(std::string_view bytes, std::string_view type, JsonScanner& scanner,
+                   bool& malformed) {
+  std::string_view actualType, data;
+  malformed = !splitJsonMessage(bytes, actualType, data);
+  if (malformed || actualType != type) return false;
+  scanner = JsonScanner(data);
+  return scanner.peek() == '{' && scanner.enterObject();
+}
+
+// ---- world_update (opcode 2) ----
+
+bool decodeJsonWorldUpdate(std::string_view bytes, InboundMessage& message, MessageSink& sink,
+                           void*) {
+  JsonWorldUpdateReader reader(bytes);
+  if (!reader.isWorldUpdate()) return reader.ok();
+  message.kind = InboundMessage::Kind::PlayerState;
+  message.netId = InboundMessage::kNoNetId;
+  message.sequence = 0;
+  JsonWorldUpdateReader::Entry entry;
+  while (reader.next(entry)) {
+    if (!message.userId.assign(entry.userId)) continue;  // not a Nakama id
+    message.position = entry.position;
+    sink.emit(message);
+  }
+  return reader.ok();
+}
+
+bool decodeBinaryWorldUpdate(std::string_view bytes, InboundMessage& message, MessageSink& sink,
+                             void*) {
+  wire::WorldUpdateReader reader(bytes);
+  wire::PlayerState state;
+  message.kind = InboundMessage::Kind::PlayerState;
+  while (reader.next(state)) {
+    if (state.netId > InboundMessage::kMaxNetId) return false;
+    if (!message.userId.assign(state.userId)) continue;
+    message.netId = state.netId;
+    message.position = state.position;
+    message.sequence = state.lastSequence;
+    sink.emit(message);
+  }
+  return reader.ok();
+}
+
+// ---- input_ack (opcode 4) ----
+
+bool decodeJsonInputAck(std::string_view bytes, InboundMessage& message, MessageSink& sink,
+                        void*) {
+  JsonScanner s{std::string_view()};
+  bool malformed = false;
+  if (!enterJsonData(bytes, "input_ack", s, malformed)) return !malformed;
+
+  message.kind = InboundMessage::Kind::InputAck;
+  message.sequence = 0;
+  message.approved = false;
+  message.position = {};
+  std::string_view key, playerId;
+  bool escaped = false, hasX = false, hasY = false;
+  while (s.nextKey(key)) {
+    if (key == "playerId" && s.peek() == '"') {
+      s.readString(playerId);
+      escaped = s.lastStringEscaped();
+    } else if (key == "inputSequence") {
+      readNumberValue(s, message.sequence);
+    } else if (key == "approved") {
+      readBoolValue(s, message.approved);
+    } else if (key == "x") {
+      hasX = readNumberValue(s, message.position.x);
+    } else if (key == "y") {
+      hasY = readNumberValue(s, message.position.y);
+    } else {
+      s.skipValue();
+    }
+  }
+  if (!s.ok()) return false;
+  // User ids never need escaping; an escaped one can't be looked up raw.
+  if (escaped || !message.userId.assign(playerId)) return true;
+  message.hasPosition = hasX && hasY;
+  sink.emit(message);
+  return true;
+}
+
+bool decodeBinaryInputAck(std::string_view bytes, InboundMessage& message, MessageSink& sink,
+                          void*) {
+  wire::InputAck ack;
+  if (!wire::decode(bytes, ack)) return false;
+  if (!message.userId.assign(ack.playerId)) return true;
+  message.kind = InboundMessage::Kind::InputAck;
+  message.sequence = ack.sequence;
+  message.approved = ack.approved;
+  message.hasPosition = ack.hasPosition;
+  message.position = ack.hasPosition ? ack.position : sf::Vector2f();
+  sink.emit(message);
+  return true;
+}
+
+// ---- object_update (opcode 5) ----
+
+bool decodeJsonObjectUpdate(std::string_view bytes, InboundMessage& message, MessageSink& sink,
+                            void*) {
+  JsonScanner s{std::string_view()};
+  bool malformed = false;
+  if (!enterJsonData(bytes, "object_update", s, malformed)) return !malformed;
+
+  using Update = wire::ObjectUpdate;
+  Update& update = message.object;
+  update = Update();
+  bool hasObjectId = false;
+  std::string_view key;
+  while (s.nextKey(key)) {
+    if (key == "objectId") {
+      hasObjectId = readNumberValue(s, update.objectId);
+    } else if (key == "gid") {
+      if (readNumberValue(s, update.gid)) update.fields |= Update::kGid;
+    } else if (key == "visible") {
+      if (readBoolValue(s, update.visible)) update.fields |= Update::kVisible;
+    } else if (key == "opacity") {
+      if (readNumberValue(s, update.opacity)) update.fields |= Update::kOpacity;
+    } else if (key == "pos" && s.peek() == '{') {
+      s.enterObject();
+      bool hasX = false, hasY = false;
+      std::string_view axis;
+      while (s.nextKey(axis)) {
+        if (axis == "x") {
+          hasX = readNumberValue(s, update.pos.x);
+        } else if (axis == "y") {
+          hasY = readNumberValue(s, update.pos.y);
+        } else {
+          s.skipValue();
+        }
+      }
+      if (hasX && hasY) update.fields |= Update::kPos;
+    } else {
+      s.skipValue();
+    }
+  }
+  if (!s.ok()) return false;
+  if (!hasObjectId) return true;
+  message.kind = InboundMessage::Kind::ObjectUpdate;
+  sink.emit(message);
+  return true;
+}
+
+bool decodeBinaryObjectUpdate(std::string_view bytes, InboundMessage& message, MessageSink& sink,
+                              void*) {
+  if (!wire::decode(bytes, message.object)) return false;
+  message.kind = InboundMessage::Kind::ObjectUpdate;
+  sink.emit(message);
+  return true;
+}
+
+// ---- pong (opcode 6) ----
+
+bool decodeJsonPong(std::string_view bytes, InboundMessage& message, MessageSink& sink,
+                    void*) {
+  JsonScanner s{std::string_view()};
+  bool malformed = false;
+  if (!enterJsonData(bytes, "pong", s, malformed)) return !malformed;
+
+  message.kind = InboundMessage::Kind::Pong;
+  message.pingId = 0;
+  double serverMs = 0.0;
+  std::string_view key;
+  while (s.nextKey(key)) {
+    if (key == "id") {
+      readNumberValue(s, message.pingId);
+    } else if (key == "serverTime") {
+      readNumberValue(s, serverMs);
+    } else {
+      s.skipValue();
+    }
+  }
+  if (!s.ok()) return false;
+  message.serverTime = serverMs / 1000.0;
+  message.receivedAt = ClockSync::localTime();
+  sink.emit(message);
+  return true;
+}
+
+MessageRegistry makeMatchRegistry() {
+  using Encoding = MessageRegistry::Encoding;
+  MessageRegistry registry;
+  registry.add(opcode::kWorldUpdate, Encoding::Json, decodeJsonWorldUpdate);
+  registry.add(opcode::kWorldUpdate, Encoding::Binary, decodeBinaryWorldUpdate);
+  registry.add(opcode::kInputAck, Encoding::Json, decodeJsonInputAck);
+  registry.add(opcode::kInputAck, Encoding::Binary, decodeBinaryInputAck);
+  registry.add(opcode::kObjectUpdate, Encoding::Json, decodeJsonObjectUpdate);
+  registry.add(opcode::kObjectUpdate, Encoding::Binary, decodeBinaryObjectUpdate);
+  registry.add(opcode::kPing, Encoding::Json, decodeJsonPong);
+  return registry;
+}
+
+}  // namespace
+
+void MessageRegistry::add(std::int64_t opCode, Encoding encoding, Decoder decoder,
+                          void* context) {
+  if (opCode < 0 || opCode >= static_cast<std::int64_t>(kOpCodeCount)) return;
+  decoders_[static_cast<std::size_t>(opCode)][static_cast<std::size_t>(encoding)] = {decoder,
+                                                                                     context};
+}
+
+MessageRegistry::Result MessageRegistry::decode(std::int64_t opCode, std::string_view bytes,
+                                                InboundMessage& scratch,
+                                                MessageSink& sink) const {
+  if (opCode < 0 || opCode >= static_cast<std::int64_t>(kOpCodeCount)) {
+    return Result::UnknownOpCode;
+  }
+  const Encoding encoding = wire::isBinary(bytes) ? Encoding::Binary : Encoding::Json;
+  const Slot& slot =
+      decoders_[static_cast<std::size_t>(opCode)][static_cast<std::size_t>(encoding)];
+  if (!slot.decoder) return Result::UnknownOpCode;
+  return slot.decoder(bytes, scratch, sink, slot.context) ? Result::Decoded : Result::Malformed;
+}
+
+const MessageRegistry& MessageRegistry::match() {
+  static const MessageRegistry registry = makeMatchRegistry();
+  return registry;
+}
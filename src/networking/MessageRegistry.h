@@ -0,0 +1,75 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef NETWORKING_MESSAGEREGISTRY_H_
+#define NETWORKING_MESSAGEREGISTRY_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "NetMessages.h"
+
+// Match opcodes. Both directions share the numbering; see WireProtocol.h
+// for the binary layouts.
+namespace opcode {
+constexpr std::int64_t kPlayerInput = 1;    // c->s
+constexpr std::int64_t kWorldUpdate = 2;    // s->c
+constexpr std::int64_t kWorldSnapshot = 3;  // s->c (binary only)
+constexpr std::int64_t kInputAck = 4;       // s->c
+constexpr std::int64_t kObjectUpdate = 5;   // s->c; c->s it carries an action
+constexpr std::int64_t kPing = 6;           // c->s ping, s->c pong (JSON only)
+constexpr std::int64_t kInterest = 7;       // c->s (JSON only)
+constexpr std::int64_t kSnapshotAck = 8;    // c->s (binary only)
+}  // namespace opcode
+
+// Receives the messages a decoder produces.
+class MessageSink {
+ public:
+  virtual void emit(InboundMessage& message) = 0;
+
+ protected:
+  ~MessageSink() = default;
+};
+
+// Incoming match data is decoded through a flat table indexed by opcode,
+// with one decoder per encoding. A decoder turns the payload into typed
+// InboundMessages (a world_update yields one per player), so each message
+// is decoded exactly once and the receiver dispatches on the message kind
+// instead of comparing "type" strings. Adding a message means adding a
+// Kind, registering its decoders and handling the kind on delivery.
+class MessageRegistry {
+ public:
+  enum class Encoding : std::uint8_t { Json, Binary };
+  enum class Result : std::uint8_t { Decoded, UnknownOpCode, Malformed };
+
+  // Fills `scratch` and emits it to `sink` once per decoded message. JSON
+  // decoders ignore (and return true for) messages whose "type" belongs to
+  // another message sharing the opcode. False when the payload is malformed.
+  // `context` is the pointer given to add(), for decoders that keep state.
+  using Decoder = bool (*)(std::string_view bytes, InboundMessage& scratch, MessageSink& sink,
+                           void* context);
+
+  static constexpr std::size_t kOpCodeCount = 16;
+
+  // Registers the decoder for one opcode and encoding, replacing any
+  // earlier one. Opcodes outside [0, kOpCodeCount) are ignored.
+  void add(std::int64_t opCode, Encoding encoding, Decoder decoder, void* context = nullptr);
+
+  // The encoding is told from the payload (see wire::isBinary).
+  Result decode(std::int64_t opCode, std::string_view bytes, InboundMessage& scratch,
+                MessageSink& sink) const;
+
+  // The stateless server -> client messages; Networking copies it and adds
+  // the ones needing per-connection state.
+  static const MessageRegistry& match();
+
+ private:
+  struct Slot {
+    Decoder decoder = nullptr;
+    void* context = nullptr;
+  };
+  std::array<std::array<Slot, 2>, kOpCodeCount> decoders_{};
+};
+
+#endif  // NETWORKING_MESSAGEREGISTRY_H_
@@ -0,0 +1,102 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef NETWORKING_NETMESSAGES_H_
+#define NETWORKING_NETMESSAGES_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "InputScheduler.h"
+#include "WireProtocol.h"
+
+// Decoded messages exchanged between the network thread and the game
+// thread (see Networking::startNetworkThread). Inbound ones hold no heap
+// data, so decoding and queueing them never allocates.
+
+// A user id stored inline. Nakama ids are 36-character UUIDs.
+class UserIdText {
+ public:
+  static constexpr std::size_t kCapacity = 63;
+
+  // False when the id doesn't fit; the text is cleared then.
+  bool assign(std::string_view id) {
+    size_ = id.size() <= kCapacity ? static_cast<std::uint8_t>(id.size()) : 0;
+    std::memcpy(data_.data(), id.data(), size_);
+    return size_ == id.size();
+  }
+  void clear() { size_ = 0; }
+  bool empty() const { return size_ == 0; }
+  std::string_view view() const { return {data_.data(), size_}; }
+
+ private:
+  std::array<char, kCapacity> data_;
+  std::uint8_t size_ = 0;
+};
+
+// Network thread -> game thread. Handles are resolved on the game thread,
+// which owns the IdInterner.
+struct InboundMessage {
+  enum class Kind : std::uint8_t {
+    PlayerState,   // netId and/or userId, position, sequence
+    Presence,      // userId, joined
+    InputAck,      // userId (may be empty), sequence, approved, position if hasPosition
+    ObjectUpdate,  // object
+    Pong,          // pingId, serverTime, receivedAt
+  };
+  static constexpr std::uint32_t kNoNetId = std::numeric_limits<std::uint32_t>::max();
+  // Largest netId accepted from the wire. Networking indexes a table by
+  // netId, so larger ones make the message malformed.
+  static constexpr std::uint32_t kMaxNetId = (std::uint32_t{1} << 20) - 1;
+
+  Kind kind = Kind::PlayerState;
+  std::uint32_t netId = kNoNetId;  // binary world_update only
+  UserIdText userId;
+  sf::Vector2f position;
+  std::uint32_t sequence = 0;
+  bool joined = false;
+  bool approved = false;
+  bool hasPosition = false;
+
+  wire::ObjectUpdate object;
+
+  std::uint32_t pingId = 0;
+  double serverTime = 0.0;  // seconds
+  double receivedAt = 0.0;  // ClockSync::localTime() at receipt
+};
+
+// Game thread -> network thread; encoded and sent on the network thread.
+struct OutboundMessage {
+  enum class Kind : std::uint8_t {
+    Inputs,       // inputs[0, inputCount), oldest first
+    Action,       // sequence, objectId, action
+    Interest,     // rect
+    Ping,         // pingId, sentAt
+    SnapshotAck,  // snapshotId
+  };
+  static constexpr std::size_t kMaxInputs = InputScheduler::kMaxRedundancy + 1;
+
+  Kind kind = Kind::Inputs;
+  std::array<wire::PlayerInput, kMaxInputs> inputs{};
+  std::uint8_t inputCount = 0;
+
+  std::uint32_t sequence = 0;
+  int objectId = 0;
+  std::string action;  // short names stay in the small-string buffer
+
+  sf::FloatRect rect;
+
+  std::uint32_t pingId = 0;
+  double sentAt = 0.0;
+
+  std::uint32_t snapshotId = 0;
+};
+
+#endif  // NETWORKING_NETMESSAGES_H_
@@ -0,0 +1,238 @@
+// Copyright 2025 WildSpark Authors
+
+#include "NetworkStats.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include <nlohmann/json.hpp>
+
+namespace {
+
+// Per-opcode CSV columns cover the protocol's opcodes; the JSON lines
+// carry every opcode with traffic.
+constexpr std::int64_t kFirstCsvOpCode = opcode::kPlayerInput;
+constexpr std::int64_t kLastCsvOpCode = opcode::kSnapshotAck;
+
+double percentileMs(const DurationHistogram& h, double p) { return h.percentile(p) / 1000.0; }
+
+nlohmann::json histogramJson(const DurationHistogram& h) {
+  nlohmann::json buckets = nlohmann::json::array();
+  std::size_t last = 0;
+  for (std::size_t i = 0; i < DurationHistogram::kBuckets; ++i) {
+    if (h.bucket(i)) last = i + 1;
+  }
+  for (std::size_t i = 0; i < last; ++i) buckets.push_back(h.bucket(i));
+  return {{"count", h.count()},   {"mean_us", h.mean()},
+          {"max_us", h.max()},    {"p50_us", h.percentile(0.5)},
+          {"p99_us", h.percentile(0.99)}, {"buckets", buckets}};
+}
+
+}  // namespace
+
+// ---- DurationHistogram ----
+
+void DurationHistogram::add(double us) {
+  us = std::max(us, 0.0);
+  const auto whole = static_cast<std::uint64_t>(std::min(us, 1e18));
+  // floor(log2(us)), with [0, 2) sharing bucket 0.
+  const std::size_t i = whole < 2 ? 0 : static_cast<std::size_t>(std::bit_width(whole) - 1);
+  ++buckets_[std::min(i, kBuckets - 1)];
+  ++count_;
+  total_ += us;
+  max_ = std::max(max_, us);
+}
+
+double DurationHistogram::bucketUpperBound(std::size_t i) {
+  return std::ldexp(1.0, static_cast<int>(i) + 1);
+}
+
+double DurationHistogram::percentile(double p) const {
+  if (count_ == 0) return 0.0;
+  // Nearest rank, as FrameTimeHistory does.
+  const auto rank = std::max<std::uint64_t>(
+      1, static_cast<std::uint64_t>(std::ceil(std::clamp(p, 0.0, 1.0) * count_)));
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < kBuckets; ++i) {
+    seen += buckets_[i];
+    if (seen >= rank) return std::min(bucketUpperBound(i), max_);
+  }
+  return max_;
+}
+
+// ---- NetworkStats ----
+
+NetworkStats::Traffic NetworkStats::total() const {
+  Traffic sum;
+  for (const Traffic& t : opcodes) {
+    sum.messagesIn += t.messagesIn;
+    sum.bytesIn += t.bytesIn;
+    sum.messagesOut += t.messagesOut;
+    sum.bytesOut += t.bytesOut;
+  }
+  return sum;
+}
+
+// ---- NetworkTelemetry ----
+
+std::size_t NetworkTelemetry::slot(std::int64_t opCode) {
+  constexpr auto kLast = static_cast<std::int64_t>(MessageRegistry::kOpCodeCount) - 1;
+  return static_cast<std::size_t>(std::clamp<std::int64_t>(opCode, 0, kLast));
+}
+
+void NetworkTelemetry::onReceived(std::int64_t opCode, std::size_t bytes, double decodeUs,
+                                  double localNow) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const std::size_t i = slot(opCode);
+  ++stats_.opcodes[i].messagesIn;
+  stats_.opcodes[i].bytesIn += bytes;
+  stats_.decodeUs[i].add(decodeUs);
+
+  if (opCode != opcode::kWorldUpdate && opCode != opcode::kWorldSnapshot) return;
+  if (lastSnapshotAt_ >= 0.0) {
+    const double intervalMs = (localNow - lastSnapshotAt_) * 1000.0;
+    stats_.snapshotIntervalUs.add(intervalMs * 1000.0);
+    if (lastIntervalMs_ >= 0.0) {
+      stats_.snapshotJitterMs +=
+          (std::abs(intervalMs - lastIntervalMs_) - stats_.snapshotJitterMs) / 16.0;
+    }
+    lastIntervalMs_ = intervalMs;
+  }
+  lastSnapshotAt_ = localNow;
+}
+
+void NetworkTelemetry::onSent(std::int64_t opCode, std::size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const std::size_t i = slot(opCode);
+  ++stats_.opcodes[i].messagesOut;
+  stats_.opcodes[i].bytesOut += bytes;
+}
+
+void NetworkTelemetry::onInputSent(std::uint32_t sequence, double localNow) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  PendingInput& p = pending_[sequence % kPendingInputs];
+  if (p.sentAt >= 0.0 && p.sequence == sequence) return;  // a redundant resend
+  if (p.sentAt < 0.0) ++pendingCount_;  // else an unacked input falls out of the window
+  p.sequence = sequence;
+  p.sentAt = localNow;
+}
+
+void NetworkTelemetry::onInputAck(std::uint32_t sequence, double localNow) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  PendingInput& p = pending_[sequence % kPendingInputs];
+  if (p.sentAt < 0.0 || p.sequence != sequence) return;  // unknown or acked already
+  const double rttMs = (localNow - p.sentAt) * 1000.0;
+  p.sentAt = -1.0;
+  --pendingCount_;
+
+  if (stats_.ackSamples == 0) {
+    stats_.ackRttMs = rttMs;
+    stats_.ackRttMinMs = rttMs;
+  } else {
+    stats_.ackRttMs += (rttMs - stats_.ackRttMs) / 8.0;
+    stats_.ackRttMinMs = std::min(stats_.ackRttMinMs, rttMs);
+  }
+  if (lastAckRttMs_ >= 0.0) {
+    stats_.ackRttJitterMs += (std::abs(rttMs - lastAckRttMs_) - stats_.ackRttJitterMs) / 16.0;
+  }
+  lastAckRttMs_ = rttMs;
+  ++stats_.ackSamples;
+}
+
+bool NetworkTelemetry::awaitingInputAcks() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pendingCount_ != 0;
+}
+
+NetworkStats NetworkTelemetry::snapshot() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+// ---- NetworkStatsLog ----
+
+bool NetworkStatsLog::open(const std::string& path) {
+  out_.open(path, std::ios::out | std::ios::trunc);
+  if (!out_) return false;
+  json_ = path.ends_with(".json") || path.ends_with(".jsonl");
+  if (!json_) writeCsvHeader(out_);
+  return true;
+}
+
+void NetworkStatsLog::write(double seconds, const NetworkStats& stats) {
+  if (!out_.is_open()) return;
+  if (json_) {
+    writeJsonLine(out_, seconds, stats);
+  } else {
+    writeCsvRow(out_, seconds, stats);
+  }
+  out_.flush();  // a crashed session should still leave its samples
+}
+
+void NetworkStatsLog::writeCsvHeader(std::ostream& out) {
+  out << "time_s,messages_in,bytes_in,messages_out,bytes_out,"
+         "ack_samples,ack_rtt_ms,ack_rtt_min_ms,ack_rtt_jitter_ms,ping_rtt_ms,ping_jitter_ms,"
+         "snapshot_interval_p50_ms,snapshot_interval_p99_ms,snapshot_jitter_ms,"
+         "inbound_depth,inbound_high_water,inbound_dropped,"
+         "outbound_depth,outbound_high_water,outbound_dropped,stalled_ticks";
+  for (std::int64_t op = kFirstCsvOpCode; op <= kLastCsvOpCode; ++op) {
+    out << ",op" << op << "_messages_in,op" << op << "_bytes_in,op" << op
+        << "_messages_out,op" << op << "_bytes_out,op" << op << "_decode_p99_us";
+  }
+  out << '\n';
+}
+
+void NetworkStatsLog::writeCsvRow(std::ostream& out, double seconds, const NetworkStats& stats) {
+  const NetworkStats::Traffic total = stats.total();
+  const NetworkQueueStats& q = stats.queues;
+  out << seconds << ',' << total.messagesIn << ',' << total.bytesIn << ','
+      << total.messagesOut << ',' << total.bytesOut << ',' << stats.ackSamples << ','
+      << stats.ackRttMs << ',' << stats.ackRttMinMs << ',' << stats.ackRttJitterMs << ','
+      << stats.pingRttMs << ',' << stats.pingJitterMs << ','
+      << percentileMs(stats.snapshotIntervalUs, 0.5) << ','
+      << percentileMs(stats.snapshotIntervalUs, 0.99) << ',' << stats.snapshotJitterMs << ','
+      << q.inboundDepth << ',' << q.inboundHighWater << ',' << q.inboundDropped << ','
+      << q.outboundDepth << ',' << q.outboundHighWater << ',' << q.outboundDropped << ','
+      << q.stalledTicks;
+  for (std::int64_t op = kFirstCsvOpCode; op <= kLastCsvOpCode; ++op) {
+    const auto i = static_cast<std::size_t>(op);
+    const NetworkStats::Traffic& t = stats.opcodes[i];
+    out << ',' << t.messagesIn << ',' << t.bytesIn << ',' << t.messagesOut << ','
+        << t.bytesOut << ',' << stats.decodeUs[i].percentile(0.99);
+  }
+  out << '\n';
+}
+
+void NetworkStatsLog::writeJsonLine(std::ostream& out, double seconds,
+                                    const NetworkStats& stats) {
+  nlohmann::json opcodes = nlohmann::json::object();
+  for (std::size_t i = 0; i < stats.opcodes.size(); ++i) {
+    const NetworkStats::Traffic& t = stats.opcodes[i];
+    if (t.messagesIn == 0 && t.messagesOut == 0) continue;
+    opcodes[std::to_string(i)] = {{"messages_in", t.messagesIn},
+                                  {"bytes_in", t.bytesIn},
+                                  {"messages_out", t.messagesOut},
+                                  {"bytes_out", t.bytesOut},
+                                  {"decode", histogramJson(stats.decodeUs[i])}};
+  }
+  const NetworkQueueStats& q = stats.queues;
+  const nlohmann::json line = {
+      {"time_s", seconds},
+      {"opcodes", opcodes},
+      {"ack_rtt", {{"samples", stats.ackSamples},
+                   {"ms", stats.ackRttMs},
+                   {"min_ms", stats.ackRttMinMs},
+                   {"jitter_ms", stats.ackRttJitterMs}}},
+      {"ping", {{"rtt_ms", stats.pingRttMs}, {"jitter_ms", stats.pingJitterMs}}},
+      {"snapshot_interval", histogramJson(stats.snapshotIntervalUs)},
+      {"snapshot_jitter_ms", stats.snapshotJitterMs},
+      {"queues", {{"inbound_depth", q.inboundDepth},
+                  {"inbound_high_water", q.inboundHighWater},
+                  {"inbound_dropped", q.inboundDropped},
+                  {"outbound_depth", q.outboundDepth},
+                  {"outbound_high_water", q.outboundHighWater},
+                  {"outbound_dropped", q.outboundDropped},
+                  {"stalled_ticks", q.stalledTicks}}}};
+  out << line.dump() << '\n';
+}
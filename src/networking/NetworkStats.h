@@ -0,0 +1,138 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef NETWORKING_NETWORKSTATS_H_
+#define NETWORKING_NETWORKSTATS_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+#include "MessageRegistry.h"
+
+// Queue depths and overflow counters for the network thread.
+struct NetworkQueueStats {
+  std::size_t inboundDepth = 0;
+  std::size_t inboundHighWater = 0;
+  std::size_t inboundDropped = 0;  // decoded messages lost to a full queue
+  std::size_t outboundDepth = 0;
+  std::size_t outboundHighWater = 0;
+  std::size_t outboundDropped = 0;
+  // Socket polls skipped because the game thread is behind on draining.
+  std::size_t stalledTicks = 0;
+};
+
+// Histogram of durations in microseconds with power-of-two buckets: bucket
+// 0 holds [0, 2) us, bucket i holds [2^i, 2^(i+1)) us and the last bucket
+// everything longer. Percentiles report the upper edge of their bucket.
+class DurationHistogram {
+ public:
+  static constexpr std::size_t kBuckets = 24;  // the last one starts at ~8.4 s
+
+  void add(double us);
+  void clear() { *this = DurationHistogram(); }
+
+  std::uint64_t count() const { return count_; }
+  double mean() const { return count_ ? total_ / static_cast<double>(count_) : 0.0; }
+  double max() const { return max_; }
+  // p in [0, 1]; 0 when empty.
+  double percentile(double p) const;
+  std::uint64_t bucket(std::size_t i) const { return buckets_[i]; }
+  static double bucketUpperBound(std::size_t i);
+
+ private:
+  std::array<std::uint64_t, kBuckets> buckets_{};
+  std::uint64_t count_ = 0;
+  double total_ = 0.0;
+  double max_ = 0.0;
+};
+
+// Everything Networking measures about the match connection, as a value.
+// Counters are cumulative since the Networking was created.
+struct NetworkStats {
+  struct Traffic {
+    std::uint64_t messagesIn = 0;
+    std::uint64_t bytesIn = 0;
+    std::uint64_t messagesOut = 0;
+    std::uint64_t bytesOut = 0;
+  };
+
+  // Indexed by opcode; opcodes past the table are counted in the last slot.
+  std::array<Traffic, MessageRegistry::kOpCodeCount> opcodes{};
+  std::array<DurationHistogram, MessageRegistry::kOpCodeCount> decodeUs{};
+
+  // Round trip from sending an input to its ack for the local player.
+  std::uint64_t ackSamples = 0;
+  double ackRttMs = 0.0;        // smoothed (1/8 gain)
+  double ackRttMinMs = 0.0;
+  double ackRttJitterMs = 0.0;  // RFC 3550 running mean of RTT deltas
+
+  // Time between world_update / world_snapshot arrivals.
+  DurationHistogram snapshotIntervalUs;
+  double snapshotJitterMs = 0.0;
+
+  // From ClockSync's pings.
+  double pingRttMs = 0.0;
+  double pingJitterMs = 0.0;
+
+  NetworkQueueStats queues;
+
+  Traffic total() const;
+};
+
+// Collects NetworkStats on the thread that owns the realtime client (the
+// network thread when it runs) and hands out copies to any thread.
+class NetworkTelemetry {
+ public:
+  void onReceived(std::int64_t opCode, std::size_t bytes, double decodeUs, double localNow);
+  void onSent(std::int64_t opCode, std::size_t bytes);
+  // The newest input of a packet, at its first send; later redundant
+  // copies keep the first send time.
+  void onInputSent(std::uint32_t sequence, double localNow);
+  void onInputAck(std::uint32_t sequence, double localNow);
+  // Whether any sent input is still waiting for its ack.
+  bool awaitingInputAcks() const;
+
+  NetworkStats snapshot() const;
+
+ private:
+  static constexpr std::size_t kPendingInputs = 64;
+  struct PendingInput {
+    std::uint32_t sequence = 0;
+    double sentAt = -1.0;  // < 0: free
+  };
+
+  static std::size_t slot(std::int64_t opCode);
+
+  mutable std::mutex mutex_;
+  NetworkStats stats_;
+  std::array<PendingInput, kPendingInputs> pending_{};
+  std::size_t pendingCount_ = 0;
+  double lastAckRttMs_ = -1.0;
+  double lastSnapshotAt_ = -1.0;
+  double lastIntervalMs_ = -1.0;
+};
+
+// Appends NetworkStats samples to a file for offline analysis: one CSV row
+// per sample, or one JSON object per line when the path ends in ".json" or
+// ".jsonl". The JSON lines also carry the histograms.
+class NetworkStatsLog {
+ public:
+  bool open(const std::string& path);
+  bool isOpen() const { return out_.is_open(); }
+  void write(double seconds, const NetworkStats& stats);
+
+  // The formats, for writing to any stream.
+  static void writeCsvHeader(std::ostream& out);
+  static void writeCsvRow(std::ostream& out, double seconds, const NetworkStats& stats);
+  static void writeJsonLine(std::ostream& out, double seconds, const NetworkStats& stats);
+
+ private:
+  std::ofstream out_;
+  bool json_ = false;
+};
+
+#endif  // NETWORKING_NETWORKSTATS_H_
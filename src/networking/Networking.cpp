@@ -2,13 +2,29 @@
 
 #include "Networking.h"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <nlohmann/json.hpp>
 
+
+namespace {
+
+// Logs the start of a dropped payload; the whole thing can be megabytes.
+void logDroppedMessage(const char* reason, std::string_view bytes) {
+  constexpr std::size_t kMaxLogged = 256;
+  std::cerr << "Networking: Dropped " << reason << " (" << bytes.size()
+            << " bytes): " << bytes.substr(0, kMaxLogged)
+            << (bytes.size() > kMaxLogged ? "..." : "") << std::endl;
+}
+
+}  // namespace
+
 InternalRtListener::InternalRtListener(Networking* networkingService)
     : m_networkingService(networkingService) {}
 
@@ -31,44 +47,152 @@ void InternalRtListener::onError(const Nakama::NRtError& error) {
 }
 
 void InternalRtListener::onMatchData(const Nakama::NMatchData& data) {
-  if (m_networkingService) {
-    try {
-      std::string jsonDataStr(data.data.begin(), data.data.end());
-      nlohmann::json gameMessage = nlohmann::json::parse(jsonDataStr);
-      std::string messageType = gameMessage.value("type", "");
-      nlohmann::json messageData =
-          gameMessage.value("data", nlohmann::json::object());
-
-      if (data.opCode == 2 && messageType == "world_update") {
-        if (m_networkingService->m_onPlayerStateUpdateCallback) {
-          if (messageData.contains("players") &&
-              messageData["players"].is_object()) {
-            for (auto& [playerId, playerDataJson] :
-                 messageData["players"].items()) {
-              if (playerDataJson.contains("position")) {
-                float x = playerDataJson["position"].value("x", 0.0f);
-                float y = playerDataJson["position"].value("y", 0.0f);
-                m_networkingService->m_onPlayerStateUpdateCallback(
-                    playerId, sf::Vector2f(x, y), 0);
-              }
-            }
+  if (m_networkingService) m_networkingService->onMatchData(data);
+}
+
+void InternalRtListener::onMatchPresence(
+    const Nakama::NMatchPresenceEvent& event) {
+  if (m_networkingService) m_networkingService->onMatchPresence(event);
+}
+
+void Networking::onMatchData(const Nakama::NMatchData& data) {
+  const std::string_view bytes(data.data);
+  // The server speaks binary, so answer in kind from now on.
+  if (wire::isBinary(bytes)) m_wireFormat.store(WireFormat::Binary, std::memory_order_relaxed);
+  const double receivedAt = ClockSync::localTime();
+  m_deliverSeconds = 0.0;
+  const MessageRegistry::Result result = m_registry.decode(data.opCode, bytes, m_decoded, *this);
+  // Without the network thread emit() runs the callbacks inline; their time
+  // is not decoding.
+  const double decodeUs = (ClockSync::localTime() - receivedAt - m_deliverSeconds) * 1e6;
+  m_telemetry.onReceived(data.opCode, bytes.size(), decodeUs, receivedAt);
+  if (result == MessageRegistry::Result::Malformed) {
+    logDroppedMessage("malformed match data", bytes);
+  }
+}
+
+void Networking::onMatchPresence(const Nakama::NMatchPresenceEvent& event) {
+  // Our own presence is tracked by the scene, never released here.
+  const std::string* self = m_sessionPtr ? &m_sessionPtr->getUserId() : nullptr;
+
+  InboundMessage& message = m_decoded;
+  message.kind = InboundMessage::Kind::Presence;
+  for (const auto* presences : {&event.joins, &event.leaves}) {
+    message.joined = presences == &event.joins;
+    for (const auto& presence : *presences) {
+      if (self && presence.userId == *self) continue;
+      if (!message.userId.assign(presence.userId)) continue;
+      emit(message);
+    }
+  }
+}
+
+void Networking::emit(InboundMessage& message) {
+  // Acks for the local player's inputs give the input round trip.
+  if (message.kind == InboundMessage::Kind::InputAck && m_sessionPtr &&
+      m_telemetry.awaitingInputAcks() && message.userId.view() == m_sessionPtr->getUserId()) {
+    m_telemetry.onInputAck(message.sequence, ClockSync::localTime());
+  }
+  if (!m_threaded) {
+    const double start = ClockSync::localTime();
+    deliver(message);
+    m_deliverSeconds += ClockSync::localTime() - start;
+    return;
+  }
+  if (!m_inbound->tryPush(std::move(message))) {
+    m_inboundDropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void Networking::deliver(InboundMessage& message) {
+  switch (message.kind) {
+    case InboundMessage::Kind::PlayerState: {
+      if (!m_onPlayerStateUpdateCallback) return;
+      PlayerHandle player;
+      if (message.netId == InboundMessage::kNoNetId) {
+        // One hash probe for a known player; only a first-seen id is copied.
+        player = resolvePlayer(message.userId.view());
+        if (player == kInvalidPlayerHandle) return;  // left already
+      } else {
+        const std::uint32_t netId = message.netId;
+        if (netId > InboundMessage::kMaxNetId) return;  // decoders reject these
+        if (!message.userId.empty()) {
+          if (netId >= m_netIdHandles.size()) {
+            m_netIdHandles.resize(netId + 1, kInvalidPlayerHandle);
           }
+          m_netIdHandles[netId] = resolvePlayer(message.userId.view());
         }
-      } else if (data.opCode == 4 && messageType == "input_ack") {
-        if (m_networkingService->m_onInputAckCallback) {
-          m_networkingService->m_onInputAckCallback(gameMessage);
-        }
-      } else if (data.opCode == 5 && messageType == "object_update") {
-        if (m_networkingService->m_onInputAckCallback) {
-          m_networkingService->m_onInputAckCallback(gameMessage);
-        }
+        if (netId >= m_netIdHandles.size()) return;
+        player = m_netIdHandles[netId];
+        if (player == kInvalidPlayerHandle) return;  // id not introduced yet
       }
-    } catch (const nlohmann::json::parse_error& e) {
-      std::cerr << "Failed to parse match data JSON: " << e.what()
-                << " Raw data: "
-                << std::string(data.data.begin(), data.data.end()) << std::endl;
+      m_onPlayerStateUpdateCallback(player, message.position, message.sequence);
+      return;
     }
+    case InboundMessage::Kind::Presence: {
+      if (message.joined) {
+        if (UserIdText* departed = findDeparted(message.userId.view())) departed->clear();
+        const PlayerHandle player = m_playerIds.intern(message.userId.view());
+        if (m_onPresenceCallback) m_onPresenceCallback(player, true);
+        return;
+      }
+      if (!findDeparted(message.userId.view())) {
+        m_departedIds[m_nextDeparted].assign(message.userId.view());
+        m_nextDeparted = (m_nextDeparted + 1) % kDepartedIds;
+      }
+      const PlayerHandle player = m_playerIds.find(message.userId.view());
+      if (player == kInvalidPlayerHandle) return;
+      if (m_onPresenceCallback) m_onPresenceCallback(player, false);
+      m_playerIds.release(player);
+      std::replace(m_netIdHandles.begin(), m_netIdHandles.end(), player,
+                   kInvalidPlayerHandle);
+      return;
+    }
+    case InboundMessage::Kind::InputAck: {
+      if (!m_onInputAckCallback) return;
+      PlayerHandle player = kInvalidPlayerHandle;
+      if (!message.userId.empty()) {
+        player = resolvePlayer(message.userId.view());
+        if (player == kInvalidPlayerHandle) return;  // left already
+      }
+      const wire::InputAck ack{message.sequence, message.approved, message.hasPosition,
+                               message.userId.view(), message.position};
+      m_onInputAckCallback(player, ack);
+      return;
+    }
+    case InboundMessage::Kind::ObjectUpdate:
+      if (m_onObjectUpdateCallback) m_onObjectUpdateCallback(message.object);
+      return;
+    case InboundMessage::Kind::Pong:
+      m_clockSync.onPong(message.pingId, message.serverTime, message.receivedAt);
+      return;
+  }
+}
+
+PlayerHandle Networking::resolvePlayer(std::string_view userId) {
+  const PlayerHandle known = m_playerIds.find(userId);
+  if (known != kInvalidPlayerHandle) return known;
+  if (findDeparted(userId)) return kInvalidPlayerHandle;
+  return m_playerIds.intern(userId);
+}
+
+UserIdText* Networking::findDeparted(std::string_view userId) {
+  if (userId.empty()) return nullptr;  // free slots are empty
+  for (UserIdText& departed : m_departedIds) {
+    if (departed.view() == userId) return &departed;
   }
+  return nullptr;
+}
+
+void Networking::drainInbound() {
+  // Only what was queued when the frame started; the worker keeps pushing.
+  for (std::size_t n = m_inbound->size(); n > 0 && m_inbound->tryPop(m_drained); --n) {
+    deliver(m_drained);
+  }
+}
+
+Nakama::NStringMap Networking::joinMetadata() {
+  return {{"wire_protocol", std::to_string(wire::kVersion)}, {"world_snapshot", "1"}};
 }
 
 Networking::Networking(Nakama::NClientPtr nakamaClientPtr)
@@ -77,7 +201,10 @@ Networking::Networking(Nakama::NClientPtr nakamaClientPtr)
       m_rtClient(nullptr),
       m_listener(nullptr),
       m_onPlayerStateUpdateCallback(nullptr),
-      m_onInputAckCallback(nullptr) {
+      m_onInputAckCallback(nullptr),
+      m_registry(MessageRegistry::match()) {
+  m_registry.add(opcode::kWorldSnapshot, MessageRegistry::Encoding::Binary,
+                 &SnapshotHistory::decode, &m_snapshots);
   if (!m_nakamaClientPtr) {
     std::cerr << "Networking Constructor Error: Nakama::NClientPtr is null!"
               << std::endl;
@@ -87,6 +214,8 @@ Networking::Networking(Nakama::NClientPtr nakamaClientPtr)
 }
 
 Networking::~Networking() {
+  clearCallbacks();
+  stopNetworkThread(false);
   if (m_rtClient && m_rtClient->isConnected()) {
     m_rtClient->disconnect();
   }
@@ -161,7 +290,7 @@ void Networking::joinMatch(const std::string& matchId,
       if (callback) callback(false);
       return;
     }
-    m_rtClient = m_nakamaClientPtr->createRtClient();
+    m_rtClient = m_rtClientFactory ? m_rtClientFactory() : m_nakamaClientPtr->createRtClient();
     if (m_rtClient) {
       if (!m_listener) {
         std::cerr << "Networking: m_listener is null, cannot set listener for "
@@ -185,11 +314,13 @@ void Networking::joinMatch(const std::string& matchId,
     m_rtClient->connect(m_sessionPtr, true);
   } else {
     m_rtClient->joinMatch(
-        matchId, {},
+        matchId, joinMetadata(),
         [this, matchId, callback](Nakama::NMatch match) {
           std::cout << "Successfully joined match: " << match.matchId
                     << std::endl;
           m_currentMatchId = match.matchId;
+          m_snapshots.reset();
+          m_ackedSnapshot = 0;
           if (callback) callback(true);
         },
         [this, callback](const Nakama::NRtError& err) {
@@ -209,11 +340,13 @@ void Networking::completePendingMatchJoin() {
 
     if (m_rtClient && m_rtClient->isConnected()) {
       m_rtClient->joinMatch(
-          matchIdToJoin, {},
+          matchIdToJoin, joinMetadata(),
           [this, matchIdToJoin, joinCallback](Nakama::NMatch match) {
             std::cout << "Successfully joined match via onConnect: "
                       << match.matchId << std::endl;
             m_currentMatchId = match.matchId;
+            m_snapshots.reset();
+            m_ackedSnapshot = 0;
             if (joinCallback) joinCallback(true);
           },
           [this, joinCallback](const Nakama::NRtError& err) {
@@ -230,70 +363,244 @@ void Networking::completePendingMatchJoin() {
   }
 }
 
+bool Networking::sendInterestRect(const sf::FloatRect& rect) {
+  // Called whenever the view moves; not being in a match yet is expected.
+  if (!m_rtClient || m_currentMatchId.empty()) return false;
+  if (!m_threaded && !m_rtClient->isConnected()) return false;
+
+  m_outgoing.kind = OutboundMessage::Kind::Interest;
+  m_outgoing.rect = rect;
+  submit(m_outgoing);
+  return true;
+}
+
 void Networking::tick() {
-  if (m_rtClient) {
+  if (m_threaded) {
+    drainInbound();
+  } else if (m_rtClient) {
     m_rtClient->tick();
+    acknowledgeSnapshot();
+  }
+
+  if (m_rtClient && !m_currentMatchId.empty() &&
+      (m_threaded || m_rtClient->isConnected())) {
+    const double now = ClockSync::localTime();
+    std::uint32_t pingId;
+    if (m_clockSync.pollPing(now, pingId)) {
+      m_outgoing.kind = OutboundMessage::Kind::Ping;
+      m_outgoing.pingId = pingId;
+      m_outgoing.sentAt = now;
+      submit(m_outgoing);
+    }
   }
 }
 
 void Networking::sendPlayerUpdate(const sf::Vector2f& direction, float speed,
                                   unsigned int sequenceNumber) {
+  const wire::PlayerInput input{sequenceNumber, direction * speed};
+  sendPlayerInputs({&input, 1});
+}
+
+void Networking::sendPlayerInputs(std::span<const wire::PlayerInput> inputs) {
+  if (inputs.empty()) return;
+  if (inputs.size() > OutboundMessage::kMaxInputs) {
+    inputs = inputs.last(OutboundMessage::kMaxInputs);
+  }
+  m_outgoing.kind = OutboundMessage::Kind::Inputs;
+  std::copy(inputs.begin(), inputs.end(), m_outgoing.inputs.begin());
+  m_outgoing.inputCount = static_cast<std::uint8_t>(inputs.size());
+  submit(m_outgoing);
+}
+
+void Networking::sendPlayerAction(const int objectId, const std::string& action,
+                                  unsigned int sequenceNumber) {
+  m_outgoing.kind = OutboundMessage::Kind::Action;
+  m_outgoing.objectId = objectId;
+  m_outgoing.action = action;
+  m_outgoing.sequence = sequenceNumber;
+  submit(m_outgoing);
+}
+
+void Networking::submit(OutboundMessage& message) {
+  if (!m_threaded) {
+    transmit(message);
+    return;
+  }
+  if (!m_outbound->tryPush(std::move(message))) {
+    m_outboundDropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void Networking::transmit(const OutboundMessage& message) {
+  using Kind = OutboundMessage::Kind;
+  const bool quiet = message.kind == Kind::Interest || message.kind == Kind::Ping ||
+                     message.kind == Kind::SnapshotAck;
   if (!m_rtClient || !m_rtClient->isConnected() || m_currentMatchId.empty()) {
-    std::cerr << "Networking::sendPlayerUpdate: Not connected to a match or "
-                 "rtClient is invalid."
-              << std::endl;
+    if (!quiet) {
+      std::cerr << "Networking::transmit: Not connected to a match or "
+                   "rtClient is invalid."
+                << std::endl;
+    }
     return;
   }
   if (!m_sessionPtr) {
-    std::cerr << "Networking::sendPlayerUpdate: Session pointer is null."
-              << std::endl;
+    std::cerr << "Networking::transmit: Session pointer is null." << std::endl;
     return;
   }
-
-  int64_t opCode = 1;
+  const bool binary = m_wireFormat.load(std::memory_order_relaxed) == WireFormat::Binary;
 
   nlohmann::json payload;
-  payload["playerId"] = m_sessionPtr->getUserId();
-  payload["action"] = "move";
-  payload["inputSequence"] = sequenceNumber;
-  payload["velocityX"] = direction.x * speed;
-  payload["velocityY"] = direction.y * speed;
+  int64_t opCode = 0;
+  switch (message.kind) {
+    case Kind::Inputs: {
+      opCode = opcode::kPlayerInput;
+      const std::span<const wire::PlayerInput> inputs(message.inputs.data(),
+                                                      message.inputCount);
+      if (binary) {
+        // The server knows the sender from its presence; no player id needed.
+        wire::encode(inputs, m_sendBuffer);
+        break;
+      }
+      // The newest input keeps the original top-level fields, so servers
+      // that don't read "inputs" still work.
+      const wire::PlayerInput& newest = inputs.back();
+      payload["playerId"] = m_sessionPtr->getUserId();
+      payload["action"] = "move";
+      payload["inputSequence"] = newest.sequence;
+      payload["velocityX"] = newest.velocity.x;
+      payload["velocityY"] = newest.velocity.y;
+      if (inputs.size() > 1) {
+        auto& earlier = payload["inputs"] = nlohmann::json::array();
+        for (std::size_t i = inputs.size() - 1; i-- > 0;) {  // newest first
+          earlier.push_back({{"inputSequence", inputs[i].sequence},
+                             {"velocityX", inputs[i].velocity.x},
+                             {"velocityY", inputs[i].velocity.y}});
+        }
+      }
+      break;
+    }
+    case Kind::Action:
+      opCode = opcode::kObjectUpdate;
+      if (binary) {
+        wire::encode(wire::PlayerAction{message.sequence,
+                                        static_cast<std::uint32_t>(message.objectId),
+                                        message.action},
+                     m_sendBuffer);
+        break;
+      }
+      payload["playerId"] = m_sessionPtr->getUserId();
+      payload["action"] = message.action;
+      payload["objectId"] = message.objectId;
+      payload["inputSequence"] = message.sequence;
+      break;
+    case Kind::Interest:
+      opCode = opcode::kInterest;
+      payload["type"] = "interest";
+      payload["data"]["x"] = message.rect.position.x;
+      payload["data"]["y"] = message.rect.position.y;
+      payload["data"]["width"] = message.rect.size.x;
+      payload["data"]["height"] = message.rect.size.y;
+      break;
+    case Kind::Ping:
+      opCode = opcode::kPing;
+      payload["type"] = "ping";
+      payload["data"]["id"] = message.pingId;
+      payload["data"]["clientTime"] = message.sentAt * 1000.0;
+      break;
+    case Kind::SnapshotAck:
+      // Snapshots only come from a server speaking binary.
+      opCode = opcode::kSnapshotAck;
+      wire::encode(wire::SnapshotAck{message.snapshotId}, m_sendBuffer);
+      break;
+  }
 
-  std::string data = payload.dump();
+  // Interest and ping have no binary form yet.
+  if (!payload.is_null()) {
+    const std::string data = payload.dump();
+    m_sendBuffer.assign(data.begin(), data.end());
+  }
+  m_rtClient->sendMatchData(m_currentMatchId, opCode, m_sendBuffer);
+  m_telemetry.onSent(opCode, m_sendBuffer.size());
+  if (message.kind == Kind::Inputs) {
+    m_telemetry.onInputSent(message.inputs[message.inputCount - 1].sequence,
+                            ClockSync::localTime());
+  }
+}
 
-  Nakama::NBytes bytesData(data.begin(), data.end());
+void Networking::acknowledgeSnapshot() {
+  const std::uint32_t latest = m_snapshots.latestId();
+  if (latest == m_ackedSnapshot) return;
+  m_ackedSnapshot = latest;
+  // Acks are not retried: a lost one only makes the server diff against an
+  // older baseline, which the ring still holds.
+  OutboundMessage ack;
+  ack.kind = OutboundMessage::Kind::SnapshotAck;
+  ack.snapshotId = latest;
+  transmit(ack);
+}
 
-  m_rtClient->sendMatchData(m_currentMatchId, opCode, bytesData);
+void Networking::startNetworkThread(std::chrono::microseconds interval) {
+  if (m_threaded || !m_rtClient) return;
+  if (!m_inbound) m_inbound = std::make_unique<InboundQueue>();
+  if (!m_outbound) m_outbound = std::make_unique<OutboundQueue>();
+  m_stopWorker.store(false, std::memory_order_relaxed);
+  m_threaded = true;
+  m_worker = std::thread([this, interval] { workerLoop(interval); });
 }
 
-void Networking::sendPlayerAction(const int objectId, const std::string& action,
-                                  unsigned int sequenceNumber) {
-  if (!m_rtClient || !m_rtClient->isConnected() || m_currentMatchId.empty()) {
-    std::cerr << "Networking::sendPlayerAction: Not connected to a match or "
-                 "rtClient is invalid."
-              << std::endl;
-    return;
+void Networking::stopNetworkThread(bool deliverQueued) {
+  if (!m_threaded) return;
+  m_stopWorker.store(true, std::memory_order_release);
+  m_worker.join();
+  if (deliverQueued) {
+    drainInbound();
+  } else {
+    while (m_inbound->tryPop(m_drained)) continue;
   }
+  m_threaded = false;
+  OutboundMessage pending;
+  while (m_outbound->tryPop(pending)) transmit(pending);
+}
 
-  if (!m_sessionPtr) {
-    std::cerr << "Networking::sendPlayerAction: Session pointer is null."
-              << std::endl;
-    return;
+void Networking::workerLoop(std::chrono::microseconds interval) {
+  OutboundMessage pending;
+  while (!m_stopWorker.load(std::memory_order_acquire)) {
+    while (m_outbound->tryPop(pending)) transmit(pending);
+    // Backpressure: while the game thread is far behind, leave new data in
+    // the socket rather than decoding it into a queue that is about to
+    // overflow.
+    if (m_inbound->size() < kInboundCapacity / 2) {
+      m_rtClient->tick();
+      acknowledgeSnapshot();
+    } else {
+      m_stalledTicks.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::this_thread::sleep_for(interval);
   }
+}
 
-  int64_t opCode = 5;
-
-  nlohmann::json payload;
-  payload["playerId"] = m_sessionPtr->getUserId();
-  payload["action"] = action;
-  payload["objectId"] = objectId;
-  payload["inputSequence"] = sequenceNumber;
-
-  std::string data = payload.dump();
-
-  Nakama::NBytes bytesData(data.begin(), data.end());
+NetworkQueueStats Networking::queueStats() const {
+  NetworkQueueStats stats;
+  if (m_inbound) {
+    stats.inboundDepth = m_inbound->size();
+    stats.inboundHighWater = m_inbound->highWater();
+  }
+  if (m_outbound) {
+    stats.outboundDepth = m_outbound->size();
+    stats.outboundHighWater = m_outbound->highWater();
+  }
+  stats.inboundDropped = m_inboundDropped.load(std::memory_order_relaxed);
+  stats.outboundDropped = m_outboundDropped.load(std::memory_order_relaxed);
+  stats.stalledTicks = m_stalledTicks.load(std::memory_order_relaxed);
+  return stats;
+}
 
-  m_rtClient->sendMatchData(m_currentMatchId, opCode, bytesData);
+NetworkStats Networking::networkStats() const {
+  NetworkStats stats = m_telemetry.snapshot();
+  stats.pingRttMs = m_clockSync.rtt() * 1000.0;
+  stats.pingJitterMs = m_clockSync.jitter() * 1000.0;
+  stats.queues = queueStats();
+  return stats;
 }
 
 void Networking::setPlayerStateUpdateCallback(
@@ -304,3 +611,18 @@ void Networking::setPlayerStateUpdateCallback(
 void Networking::setInputAckCallback(InputAckCallback callback) {
   m_onInputAckCallback = callback;
 }
+
+void Networking::setObjectUpdateCallback(ObjectUpdateCallback callback) {
+  m_onObjectUpdateCallback = callback;
+}
+
+void Networking::setPresenceCallback(PresenceCallback callback) {
+  m_onPresenceCallback = callback;
+}
+
+void Networking::clearCallbacks() {
+  m_onPlayerStateUpdateCallback = nullptr;
+  m_onInputAckCallback = nullptr;
+  m_onObjectUpdateCallback = nullptr;
+  m_onPresenceCallback = nullptr;
+}
@@ -8,16 +8,35 @@
 #include <nakama-cpp/realtime/NRtClientDisconnectInfo.h>
 #include <nakama-cpp/realtime/NRtClientListenerInterface.h>
 #include <nakama-cpp/realtime/rtdata/NMatchData.h>
+#include <nakama-cpp/realtime/rtdata/NMatchPresenceEvent.h>
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <nlohmann/json.hpp>
 
+#include "ClockSync.h"
+#include "IdInterner.h"
+#include "MessageRegistry.h"
+#include "NetworkStats.h"
+#include "NetMessages.h"
+#include "SnapshotHistory.h"
+#include "SpscQueue.h"
+#include "WireProtocol.h"
+
 class NakamaClient;  // Forward declaration
 class Networking;    // Forward declaration for listener reference
 
@@ -29,6 +48,7 @@ class InternalRtListener : public Nakama::NRtClientListenerInterface {
   void onDisconnect(const Nakama::NRtClientDisconnectInfo& info) override;
   void onError(const Nakama::NRtError& error) override;
   void onMatchData(const Nakama::NMatchData& data) override;
+  void onMatchPresence(const Nakama::NMatchPresenceEvent& event) override;
 
   void onChannelMessage(const Nakama::NChannelMessage& /*message*/) override {}
   void onMatchmakerMatched(Nakama::NMatchmakerMatchedPtr /*matched*/) override {
@@ -43,7 +63,7 @@ class InternalRtListener : public Nakama::NRtClientListenerInterface {
 
 class TestableNetworking;  // Forward declaration
 
-class Networking {
+class Networking : private MessageSink {
  public:
   friend class InternalRtListener;
   friend class TestableNetworking;
@@ -62,27 +82,99 @@ class Networking {
 
   void setCurrentMatchId(const std::string& matchId);
   Nakama::NRtClientPtr getRtClient() { return m_rtClient; }
+
+  // Makes the realtime client on the first joinMatch() instead of
+  // NClientInterface::createRtClient(), e.g. to wrap it in a
+  // ConditionedRtClient.
+  using RtClientFactory = std::function<Nakama::NRtClientPtr()>;
+  void setRtClientFactory(RtClientFactory factory) { m_rtClientFactory = std::move(factory); }
   std::string getCurrentMatchId() const { return m_currentMatchId; }
 
   void completePendingMatchJoin();
 
   void sendPlayerUpdate(const sf::Vector2f& direction, float speed,
                         unsigned int sequenceNumber);
+  // Movement inputs in one packet, oldest first; the last one is current
+  // and the earlier ones let the server recover lost packets. See
+  // InputScheduler.
+  void sendPlayerInputs(std::span<const wire::PlayerInput> inputs);
   void sendPlayerAction(const int objectId, const std::string& action,
                         unsigned int sequenceNumber);
+  // Area of the world the client cares about (opcode 7); the server may
+  // send players outside it less often. Returns false when not in a match.
+  bool sendInterestRect(const sf::FloatRect& rect);
 
+  // Players are identified by interned handles; resolve names through
+  // playerIds().
   using PlayerStateUpdateCallback = std::function<void(
-      const std::string& playerId, const sf::Vector2f& position,
+      PlayerHandle player, const sf::Vector2f& position,
       unsigned int lastProcessedSequence)>;
   void setPlayerStateUpdateCallback(PlayerStateUpdateCallback callback);
 
-  using InputAckCallback = std::function<void(const nlohmann::json& ack)>;
+  // Match joins and leaves. A leaving player's handle is released right
+  // after the callback returns and may be reused by a later join.
+  using PresenceCallback = std::function<void(PlayerHandle player, bool joined)>;
+  void setPresenceCallback(PresenceCallback callback);
+
+  IdInterner& playerIds() { return m_playerIds; }
+  const IdInterner& playerIds() const { return m_playerIds; }
+
+  // Server verdict on an input (opcode 4). `player` is invalid when the
+  // ack names no player; ack.playerId is only valid during the call.
+  using InputAckCallback = std::function<void(PlayerHandle player, const wire::InputAck& ack)>;
   void setInputAckCallback(InputAckCallback callback);
 
+  // Changes to a map object (opcode 5); only the fields in update.fields
+  // were sent.
+  using ObjectUpdateCallback = std::function<void(const wire::ObjectUpdate& update)>;
+  void setObjectUpdateCallback(ObjectUpdateCallback callback);
+
+  // Drops every callback above, e.g. before their owner is destroyed.
+  void clearCallbacks();
+
+  // Match messages are sent as JSON until the server has sent a binary
+  // message (it was offered wire::kVersion at join); from then on the
+  // client sends binary too. Both are always accepted on receive.
+  enum class WireFormat { Json, Binary };
+  WireFormat wireFormat() const { return m_wireFormat.load(std::memory_order_relaxed); }
+
+  // Moves socket polling, decoding and encoding to a worker thread. The
+  // worker ticks the realtime client every `interval` and queues decoded
+  // messages; tick() then drains them on the calling thread and runs the
+  // callbacks there, so a burst of traffic costs the game thread only the
+  // callbacks. Sends are queued the other way.
+  //
+  // Start it once joined and with callbacks set. While it runs the worker
+  // owns the realtime client: from the game thread only tick(), the send
+  // functions and the accessors may be used.
+  void startNetworkThread(std::chrono::microseconds interval = std::chrono::milliseconds(1));
+  // Joins the worker, then sends whatever was still queued. Queued inbound
+  // messages are delivered, or dropped when `deliverQueued` is false, as
+  // on destruction, when the callbacks' owners may already be gone.
+  void stopNetworkThread(bool deliverQueued = true);
+  bool networkThreadRunning() const { return m_threaded; }
+  NetworkQueueStats queueStats() const;
+
+  // Traffic per opcode, decode times, input-ack RTT, snapshot arrival
+  // intervals, ping RTT and queue depths; safe to call every frame.
+  NetworkStats networkStats() const;
+
+  // Server clock estimate, kept up to date by pings sent from tick() while
+  // in a match (opcode 6, answered by the match handler with a pong).
+  ClockSync& clockSync() { return m_clockSync; }
+  const ClockSync& clockSync() const { return m_clockSync; }
+  double serverNow() const { return m_clockSync.serverNow(); }
+
+  // Delta world snapshots (opcode 3) rebuilt so far; the newest is
+  // acknowledged to the server after each socket poll. Belongs to the
+  // receive path, so only read it while the network thread is stopped.
+  const SnapshotHistory& snapshots() const { return m_snapshots; }
+
  private:
   Nakama::NClientPtr m_nakamaClientPtr;
   Nakama::NSessionPtr m_sessionPtr;
   Nakama::NRtClientPtr m_rtClient;
+  RtClientFactory m_rtClientFactory;
   std::shared_ptr<InternalRtListener> m_listener;
   std::string m_currentMatchId;
 
@@ -91,7 +183,74 @@ class Networking {
 
   PlayerStateUpdateCallback m_onPlayerStateUpdateCallback;
   InputAckCallback m_onInputAckCallback;
+  ObjectUpdateCallback m_onObjectUpdateCallback;
+  PresenceCallback m_onPresenceCallback;
+  IdInterner m_playerIds;
+  ClockSync m_clockSync;
+
+  std::atomic<WireFormat> m_wireFormat{WireFormat::Json};
+  // Receive-path decoders: MessageRegistry::match() plus world snapshots.
+  MessageRegistry m_registry;
+  SnapshotHistory m_snapshots;
+  std::uint32_t m_ackedSnapshot = 0;
+  NetworkTelemetry m_telemetry;
+  double m_deliverSeconds = 0.0;  // inline delivery during the current decode
+  std::vector<PlayerHandle> m_netIdHandles;  // binary world_update netId -> handle
+  // Recently left players. Their late updates and acks are dropped instead
+  // of interning them again, until they rejoin. A fixed ring of inline ids,
+  // overwritten oldest first, so join/leave churn never allocates here.
+  static constexpr std::size_t kDepartedIds = 64;
+  std::array<UserIdText, kDepartedIds> m_departedIds{};
+  std::size_t m_nextDeparted = 0;
+  Nakama::NBytes m_sendBuffer;               // reused by binary sends
+
+  // Network thread. Queues are created on first start; the capacity of the
+  // inbound one covers a few full world_updates of a large crowd.
+  static constexpr std::size_t kInboundCapacity = std::size_t{1} << 14;
+  static constexpr std::size_t kOutboundCapacity = 256;
+  using InboundQueue = SpscQueue<InboundMessage, kInboundCapacity>;
+  using OutboundQueue = SpscQueue<OutboundMessage, kOutboundCapacity>;
+  std::unique_ptr<InboundQueue> m_inbound;
+  std::unique_ptr<OutboundQueue> m_outbound;
+  std::thread m_worker;
+  std::atomic<bool> m_stopWorker{false};
+  bool m_threaded = false;
+  std::atomic<std::size_t> m_inboundDropped{0};
+  std::atomic<std::size_t> m_outboundDropped{0};
+  std::atomic<std::size_t> m_stalledTicks{0};
+
+  // Scratch messages: m_decoded is filled by the receive path (worker when
+  // threaded), m_drained and m_outgoing belong to the game thread.
+  InboundMessage m_decoded;
+  InboundMessage m_drained;
+  OutboundMessage m_outgoing;
+
+  // Receive path: decode into m_decoded (match data through
+  // MessageRegistry::match()), then emit() it.
+  void onMatchData(const Nakama::NMatchData& data);
+  void onMatchPresence(const Nakama::NMatchPresenceEvent& event);
+  // Queues a decoded message for the game thread, or delivers it directly
+  // when there is no network thread.
+  void emit(InboundMessage& message) override;
+  // Resolves handles and runs the callbacks; game thread only.
+  void deliver(InboundMessage& message);
+  // Handle for a player the server names, or kInvalidPlayerHandle for one
+  // that has left.
+  PlayerHandle resolvePlayer(std::string_view userId);
+  // Slot of m_departedIds holding `userId`, or null.
+  UserIdText* findDeparted(std::string_view userId);
+  void drainInbound();
+
+  // Send path: the game thread fills a message and submit()s it; transmit()
+  // encodes and sends on the thread owning the realtime client.
+  void submit(OutboundMessage& message);
+  void transmit(const OutboundMessage& message);
+  // Acknowledges the newest rebuilt snapshot if not done yet; called right
+  // after polling the socket, on the thread owning the realtime client.
+  void acknowledgeSnapshot();
+  void workerLoop(std::chrono::microseconds interval);
 
+  static Nakama::NStringMap joinMetadata();
   void connect_rt_client(
       std::function<void()> onSuccess = nullptr,
       std::function<void(const Nakama::NRtError&)> onError = nullptr);
@@ -0,0 +1,117 @@
+// Copyright 2025 WildSpark Authors
+
+#include "SnapshotHistory.h"
+
+#include <span>
+#include <utility>
+
+#include "WireProtocol.h"
+
+namespace {
+
+void emitPlayer(const SnapshotHistory::Player& player, std::string_view userId,
+                InboundMessage& message, MessageSink& sink) {
+  message.netId = player.netId;
+  if (!message.userId.assign(userId)) return;  // not a Nakama id
+  message.position = {wire::dequantize(player.x), wire::dequantize(player.y)};
+  message.sequence = player.lastSequence;
+  sink.emit(message);
+}
+
+}  // namespace
+
+const std::vector<SnapshotHistory::Player>* SnapshotHistory::find(
+    std::uint32_t snapshotId) const {
+  const Snapshot& slot = ring_[snapshotId % kRingSize];
+  return snapshotId != 0 && slot.id == snapshotId ? &slot.players : nullptr;
+}
+
+void SnapshotHistory::reset() {
+  for (Snapshot& snapshot : ring_) {
+    snapshot.id = 0;
+    snapshot.players.clear();
+  }
+  latestId_ = 0;
+}
+
+bool SnapshotHistory::decode(std::string_view bytes, InboundMessage& scratch, MessageSink& sink,
+                             void* context) {
+  return static_cast<SnapshotHistory*>(context)->apply(bytes, scratch, sink);
+}
+
+bool SnapshotHistory::apply(std::string_view bytes, InboundMessage& message, MessageSink& sink) {
+  wire::SnapshotReader reader(bytes);
+  if (!reader.ok() || reader.snapshotId() == 0) {
+    ++stats_.malformed;
+    return false;
+  }
+  if (reader.snapshotId() <= latestId_) {
+    ++stats_.stale;  // reordered; a newer state was already delivered
+    return true;
+  }
+  std::span<const Player> baseline;
+  if (reader.baselineId() != 0) {
+    const std::vector<Player>* players = find(reader.baselineId());
+    if (!players) {
+      ++stats_.missingBaseline;
+      return true;
+    }
+    baseline = *players;
+  }
+
+  // Merge the baseline with the changes, both ascending by netId. Nothing
+  // is emitted until the whole message has been read: a rejected snapshot
+  // must not move anyone.
+  building_.clear();
+  userIds_.clear();
+  std::size_t next = 0;
+  auto copyBaselineBelow = [&](std::uint64_t netId) {
+    for (; next < baseline.size() && baseline[next].netId < netId; ++next) {
+      building_.push_back(baseline[next]);
+      userIds_.emplace_back();
+    }
+  };
+
+  wire::SnapshotEntry change;
+  std::int64_t previousNetId = -1;
+  bool valid = true;
+  while (reader.next(change)) {
+    if (change.netId <= previousNetId || change.netId > InboundMessage::kMaxNetId) {
+      valid = false;
+      break;
+    }
+    previousNetId = change.netId;
+
+    copyBaselineBelow(change.netId);
+    Player player;
+    player.netId = change.netId;
+    if (next < baseline.size() && baseline[next].netId == change.netId) {
+      player = baseline[next++];
+    }
+    if (change.fields & wire::SnapshotEntry::kRemoved) continue;
+    if (change.fields & wire::SnapshotEntry::kPosition) {
+      player.x += change.dx;
+      player.y += change.dy;
+    }
+    if (change.fields & wire::SnapshotEntry::kSequence) player.lastSequence = change.lastSequence;
+    building_.push_back(player);
+    userIds_.push_back(change.userId);
+  }
+  if (!valid || !reader.ok()) {
+    ++stats_.malformed;
+    return false;
+  }
+  copyBaselineBelow(std::uint64_t{1} << 32);  // the rest
+
+  message.kind = InboundMessage::Kind::PlayerState;
+  for (std::size_t i = 0; i < building_.size(); ++i) {
+    emitPlayer(building_[i], userIds_[i], message, sink);
+  }
+
+  Snapshot& slot = ring_[reader.snapshotId() % kRingSize];
+  slot.id = reader.snapshotId();
+  slot.players.swap(building_);
+  latestId_ = slot.id;
+  ++stats_.rebuilt;
+  return true;
+}
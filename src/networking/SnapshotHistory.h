@@ -0,0 +1,77 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef NETWORKING_SNAPSHOTHISTORY_H_
+#define NETWORKING_SNAPSHOTHISTORY_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "MessageRegistry.h"
+#include "NetMessages.h"
+
+// Client side of delta-compressed world snapshots (opcode 3, see
+// WireProtocol.h). The server sends each snapshot as the changes against a
+// baseline: the newest snapshot the client acknowledged (opcode 8), or
+// none. The client keeps its last kRingSize rebuilt snapshots so that any
+// baseline the server may still pick is at hand, rebuilds the full state
+// and delivers every player in it, as a world_update would.
+//
+// A snapshot whose baseline has left the ring, or that is older than the
+// newest one rebuilt, is dropped; the server falls back to an older
+// baseline or a full snapshot when acks stop arriving. A malformed one
+// is rejected whole, before any player is emitted. Steady-state decoding
+// does not allocate. Used from the receive thread only.
+class SnapshotHistory {
+ public:
+  static constexpr std::size_t kRingSize = 32;
+
+  struct Player {
+    std::uint32_t netId = 0;
+    std::int32_t x = 0;  // 1/wire::kPositionScale px
+    std::int32_t y = 0;
+    std::uint32_t lastSequence = 0;
+  };
+
+  struct Stats {
+    std::size_t rebuilt = 0;
+    std::size_t missingBaseline = 0;
+    std::size_t stale = 0;
+    std::size_t malformed = 0;
+  };
+
+  // Decodes one world_snapshot and emits a PlayerState per player of the
+  // rebuilt snapshot. Players introduced by this message carry their user
+  // id. False when the message is malformed.
+  bool apply(std::string_view bytes, InboundMessage& scratch, MessageSink& sink);
+
+  // MessageRegistry::Decoder adapter; `context` is the SnapshotHistory.
+  static bool decode(std::string_view bytes, InboundMessage& scratch, MessageSink& sink,
+                     void* context);
+
+  // Newest snapshot rebuilt, to acknowledge; 0 before the first.
+  std::uint32_t latestId() const { return latestId_; }
+  // Players of a snapshot still in the ring, ascending by netId; nullptr
+  // when it is not.
+  const std::vector<Player>* find(std::uint32_t snapshotId) const;
+  const Stats& stats() const { return stats_; }
+  // Forgets every snapshot, e.g. on joining another match.
+  void reset();
+
+ private:
+  struct Snapshot {
+    std::uint32_t id = 0;  // 0: slot unused
+    std::vector<Player> players;
+  };
+
+  std::array<Snapshot, kRingSize> ring_;
+  std::vector<Player> building_;  // swapped into the ring once complete
+  // User ids sent with building_'s players; views into the message.
+  std::vector<std::string_view> userIds_;
+  std::uint32_t latestId_ = 0;
+  Stats stats_;
+};
+
+#endif  // NETWORKING_SNAPSHOTHISTORY_H_
@@ -0,0 +1,68 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef NETWORKING_SPSCQUEUE_H_
+#define NETWORKING_SPSCQUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Slots are allocated once up front and reused; elements are moved
+// in and out, so types that keep their buffers (strings, json) stop
+// allocating once the slots have warmed up.
+//
+// Capacity must be a power of two. size() and highWater() may be read from
+// either thread and are exact for the calling side, approximate for the
+// other.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "SpscQueue capacity must be a power of two");
+
+ public:
+  SpscQueue() : slots_(std::make_unique<T[]>(Capacity)) {}
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  static constexpr std::size_t capacity() { return Capacity; }
+
+  // Producer side. False (and `value` untouched) when full.
+  bool tryPush(T&& value) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    const std::size_t depth = tail - head_.load(std::memory_order_acquire);
+    if (depth == Capacity) return false;
+    slots_[tail & (Capacity - 1)] = std::move(value);
+    tail_.store(tail + 1, std::memory_order_release);
+    if (depth + 1 > highWater_.load(std::memory_order_relaxed)) {
+      highWater_.store(depth + 1, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  // Consumer side. False when empty.
+  bool tryPop(T& out) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) return false;
+    out = std::move(slots_[head & (Capacity - 1)]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  std::size_t size() const {
+    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+  }
+  bool empty() const { return size() == 0; }
+  // Deepest the queue has been since construction.
+  std::size_t highWater() const { return highWater_.load(std::memory_order_relaxed); }
+
+ private:
+  std::unique_ptr<T[]> slots_;
+  // Producer and consumer indices on separate cache lines.
+  alignas(64) std::atomic<std::size_t> head_{0};
+  alignas(64) std::atomic<std::size_t> tail_{0};
+  std::atomic<std::size_t> highWater_{0};
+};
+
+#endif  // NETWORKING_SPSCQUEUE_H_
@@ -0,0 +1,327 @@
+// Copyright 2025 WildSpark Authors
+
+#include "WireProtocol.h"
+
+#include <cstring>
+
+namespace wire {
+
+// ---- Writer ----
+
+void Writer::header() {
+  u8(kMagic);
+  u8(kVersion);
+}
+
+void Writer::varint(std::uint64_t v) {
+  while (v >= 0x80) {
+    u8(static_cast<std::uint8_t>(v | 0x80));
+    v >>= 7;
+  }
+  u8(static_cast<std::uint8_t>(v));
+}
+
+void Writer::svarint(std::int64_t v) {
+  varint((static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63));
+}
+
+void Writer::i32(std::int32_t v) {
+  const auto u = static_cast<std::uint32_t>(v);
+  for (int shift = 0; shift < 32; shift += 8) u8(static_cast<std::uint8_t>(u >> shift));
+}
+
+void Writer::f32(float v) {
+  std::uint32_t u;
+  std::memcpy(&u, &v, sizeof(u));
+  i32(static_cast<std::int32_t>(u));
+}
+
+void Writer::str(std::string_view s) {
+  varint(s.size());
+  out_.append(s.data(), s.size());
+}
+
+void Writer::position(sf::Vector2f p) {
+  i32(quantize(p.x));
+  i32(quantize(p.y));
+}
+
+// ---- Reader ----
+
+bool Reader::need(std::size_t n) {
+  if (ok_ && static_cast<std::size_t>(end_ - p_) >= n) return true;
+  ok_ = false;
+  return false;
+}
+
+bool Reader::header() {
+  if (u8() != kMagic || u8() != kVersion) ok_ = false;
+  return ok_;
+}
+
+std::uint8_t Reader::u8() {
+  if (!need(1)) return 0;
+  return static_cast<std::uint8_t>(*p_++);
+}
+
+std::uint64_t Reader::varint() {
+  std::uint64_t v = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (!need(1)) return 0;
+    const auto byte = static_cast<std::uint8_t>(*p_++);
+    v |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) return v;
+  }
+  ok_ = false;  // more than 10 bytes
+  return 0;
+}
+
+std::int64_t Reader::svarint() {
+  const std::uint64_t u = varint();
+  return static_cast<std::int64_t>(u >> 1) ^ -static_cast<std::int64_t>(u & 1);
+}
+
+std::int32_t Reader::i32() {
+  if (!need(4)) return 0;
+  std::uint32_t u = 0;
+  for (int i = 0; i < 4; ++i) {
+    u |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(p_[i])) << (8 * i);
+  }
+  p_ += 4;
+  return static_cast<std::int32_t>(u);
+}
+
+float Reader::f32() {
+  const auto u = static_cast<std::uint32_t>(i32());
+  float v;
+  std::memcpy(&v, &u, sizeof(v));
+  return v;
+}
+
+std::string_view Reader::str() {
+  const std::uint64_t n = varint();
+  if (!need(n)) return {};
+  std::string_view s(p_, n);
+  p_ += n;
+  return s;
+}
+
+sf::Vector2f Reader::position() {
+  const float x = dequantize(i32());
+  const float y = dequantize(i32());
+  return {x, y};
+}
+
+// ---- Messages ----
+
+void encode(const PlayerInput& msg, std::string& out) {
+  out.clear();
+  Writer w(out);
+  w.header();
+  w.varint(msg.sequence);
+  w.f32(msg.velocity.x);
+  w.f32(msg.velocity.y);
+}
+
+void encode(std::span<const PlayerInput> inputs, std::string& out) {
+  out.clear();
+  if (inputs.empty()) return;
+  const PlayerInput& newest = inputs.back();
+  Writer w(out);
+  w.header();
+  w.varint(newest.sequence);
+  w.f32(newest.velocity.x);
+  w.f32(newest.velocity.y);
+  if (inputs.size() == 1) return;
+  w.varint(inputs.size() - 1);
+  for (std::size_t i = inputs.size() - 1; i-- > 0;) {
+    w.varint(newest.sequence - inputs[i].sequence);
+    w.f32(inputs[i].velocity.x);
+    w.f32(inputs[i].velocity.y);
+  }
+}
+
+void encode(const PlayerAction& msg, std::string& out) {
+  out.clear();
+  Writer w(out);
+  w.header();
+  w.varint(msg.sequence);
+  w.varint(msg.objectId);
+  w.str(msg.action);
+}
+
+void encode(const InputAck& msg, std::string& out) {
+  out.clear();
+  Writer w(out);
+  w.header();
+  w.varint(msg.sequence);
+  w.u8((msg.approved ? 1 : 0) | (msg.hasPosition ? 2 : 0));
+  w.str(msg.playerId);
+  if (msg.hasPosition) w.position(msg.position);
+}
+
+void encode(const ObjectUpdate& msg, std::string& out) {
+  out.clear();
+  Writer w(out);
+  w.header();
+  w.varint(msg.objectId);
+  w.u8(msg.fields);
+  if (msg.fields & ObjectUpdate::kGid) w.varint(msg.gid);
+  if (msg.fields & ObjectUpdate::kVisible) w.u8(msg.visible ? 1 : 0);
+  if (msg.fields & ObjectUpdate::kOpacity) w.f32(msg.opacity);
+  if (msg.fields & ObjectUpdate::kPos) w.position(msg.pos);
+}
+
+void encode(const SnapshotAck& msg, std::string& out) {
+  out.clear();
+  Writer w(out);
+  w.header();
+  w.varint(msg.snapshotId);
+}
+
+bool decode(std::string_view bytes, PlayerInput& out) {
+  Reader r(bytes);
+  if (!r.header()) return false;
+  out.sequence = static_cast<std::uint32_t>(r.varint());
+  out.velocity.x = r.f32();
+  out.velocity.y = r.f32();
+  return r.ok();
+}
+
+std::size_t decode(std::string_view bytes, std::span<PlayerInput> out) {
+  if (out.empty()) return 0;
+  Reader r(bytes);
+  if (!r.header()) return 0;
+  PlayerInput& newest = out[0];
+  newest.sequence = static_cast<std::uint32_t>(r.varint());
+  newest.velocity.x = r.f32();
+  newest.velocity.y = r.f32();
+  if (!r.ok()) return 0;
+  if (r.atEnd()) return 1;
+
+  const std::uint64_t earlier = r.varint();
+  std::size_t count = 1;
+  for (std::uint64_t i = 0; i < earlier && count < out.size(); ++i, ++count) {
+    out[count].sequence = newest.sequence - static_cast<std::uint32_t>(r.varint());
+    out[count].velocity.x = r.f32();
+    out[count].velocity.y = r.f32();
+  }
+  return r.ok() ? count : 0;
+}
+
+bool decode(std::string_view bytes, PlayerAction& out) {
+  Reader r(bytes);
+  if (!r.header()) return false;
+  out.sequence = static_cast<std::uint32_t>(r.varint());
+  out.objectId = static_cast<std::uint32_t>(r.varint());
+  out.action = r.str();
+  return r.ok();
+}
+
+bool decode(std::string_view bytes, InputAck& out) {
+  Reader r(bytes);
+  if (!r.header()) return false;
+  out.sequence = static_cast<std::uint32_t>(r.varint());
+  const std::uint8_t flags = r.u8();
+  out.approved = flags & 1;
+  out.hasPosition = flags & 2;
+  out.playerId = r.str();
+  if (out.hasPosition) out.position = r.position();
+  return r.ok();
+}
+
+bool decode(std::string_view bytes, ObjectUpdate& out) {
+  Reader r(bytes);
+  if (!r.header()) return false;
+  out.objectId = static_cast<std::uint32_t>(r.varint());
+  out.fields = r.u8();
+  if (out.fields & ObjectUpdate::kGid) out.gid = static_cast<std::uint32_t>(r.varint());
+  if (out.fields & ObjectUpdate::kVisible) out.visible = r.u8() != 0;
+  if (out.fields & ObjectUpdate::kOpacity) out.opacity = r.f32();
+  if (out.fields & ObjectUpdate::kPos) out.pos = r.position();
+  return r.ok();
+}
+
+bool decode(std::string_view bytes, SnapshotAck& out) {
+  Reader r(bytes);
+  if (!r.header()) return false;
+  out.snapshotId = static_cast<std::uint32_t>(r.varint());
+  return r.ok();
+}
+
+WorldUpdateWriter::WorldUpdateWriter(std::string& out, std::uint32_t count) : w_(out) {
+  out.clear();
+  w_.header();
+  w_.varint(count);
+}
+
+void WorldUpdateWriter::add(const PlayerState& state) {
+  w_.varint(state.netId);
+  w_.u8(state.userId.empty() ? 0 : 1);
+  if (!state.userId.empty()) w_.str(state.userId);
+  w_.position(state.position);
+  w_.varint(state.lastSequence);
+}
+
+WorldUpdateReader::WorldUpdateReader(std::string_view bytes) : r_(bytes) {
+  if (r_.header()) count_ = static_cast<std::uint32_t>(r_.varint());
+}
+
+bool WorldUpdateReader::next(PlayerState& out) {
+  if (read_ >= count_ || !r_.ok()) return false;
+  out.netId = static_cast<std::uint32_t>(r_.varint());
+  const std::uint8_t flags = r_.u8();
+  out.userId = (flags & 1) ? r_.str() : std::string_view();
+  out.position = r_.position();
+  out.lastSequence = static_cast<std::uint32_t>(r_.varint());
+  if (!r_.ok()) return false;
+  ++read_;
+  return true;
+}
+
+SnapshotWriter::SnapshotWriter(std::string& out, std::uint32_t snapshotId,
+                               std::uint32_t baselineId, std::uint32_t count)
+    : w_(out) {
+  out.clear();
+  w_.header();
+  w_.varint(snapshotId);
+  w_.varint(baselineId);
+  w_.varint(count);
+}
+
+void SnapshotWriter::add(const SnapshotEntry& entry) {
+  w_.varint(entry.netId);
+  w_.u8(entry.fields);
+  if (entry.fields & SnapshotEntry::kUserId) w_.str(entry.userId);
+  if (entry.fields & SnapshotEntry::kPosition) {
+    w_.svarint(entry.dx);
+    w_.svarint(entry.dy);
+  }
+  if (entry.fields & SnapshotEntry::kSequence) w_.varint(entry.lastSequence);
+}
+
+SnapshotReader::SnapshotReader(std::string_view bytes) : r_(bytes) {
+  if (!r_.header()) return;
+  snapshotId_ = static_cast<std::uint32_t>(r_.varint());
+  baselineId_ = static_cast<std::uint32_t>(r_.varint());
+  count_ = static_cast<std::uint32_t>(r_.varint());
+}
+
+bool SnapshotReader::next(SnapshotEntry& out) {
+  if (read_ >= count_ || !r_.ok()) return false;
+  out.netId = static_cast<std::uint32_t>(r_.varint());
+  out.fields = r_.u8();
+  out.userId = (out.fields & SnapshotEntry::kUserId) ? r_.str() : std::string_view();
+  out.dx = out.dy = 0;
+  if (out.fields & SnapshotEntry::kPosition) {
+    out.dx = static_cast<std::int32_t>(r_.svarint());
+    out.dy = static_cast<std::int32_t>(r_.svarint());
+  }
+  out.lastSequence =
+      (out.fields & SnapshotEntry::kSequence) ? static_cast<std::uint32_t>(r_.varint()) : 0;
+  if (!r_.ok()) return false;
+  ++read_;
+  return true;
+}
+
+}  // namespace wire
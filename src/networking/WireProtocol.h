@@ -0,0 +1,249 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef NETWORKING_WIREPROTOCOL_H_
+#define NETWORKING_WIREPROTOCOL_H_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <span>
+#include <string_view>
+
+#include <SFML/System/Vector2.hpp>
+
+// Binary encoding of the match opcodes, used instead of JSON once the server
+// has shown it speaks it (see Networking).
+//
+// Every message starts with a two-byte header: kMagic, then kVersion. The
+// magic byte can never start a JSON document, so both encodings can share
+// an opcode and the receiver tells them apart per message. After the
+// header, fields are:
+//   varint  unsigned LEB128
+//   str     varint length + bytes
+//   i32     little-endian int32, positions in 1/kPositionScale px
+//   f32     little-endian IEEE float
+//   u8      one byte
+//
+//   1 player input  (c->s)  varint seq, f32 vx, f32 vy, then optionally
+//                           varint n and n earlier inputs, newest first:
+//                           varint (seq - earlier seq), f32 vx, f32 vy
+//                           Repeating recent inputs lets the server recover
+//                           a lost packet from the next one; readers that
+//                           only know the first input ignore the rest.
+//   2 world_update  (s->c)  varint count, then per player:
+//                           varint netId, u8 flags, [str userId], i32 x,
+//                           i32 y, varint lastSeq
+//                           The userId is sent (flags & 1) when a netId is
+//                           first used; later updates carry the netId only.
+//   3 world_snapshot (s->c) varint snapshotId, varint baselineId (0: none),
+//                           varint count, then per changed player, in
+//                           ascending netId order:
+//                           varint netId, u8 mask (1 userId, 2 position,
+//                           4 lastSeq, 8 removed), [str userId],
+//                           [svarint dx, svarint dy], [varint lastSeq]
+//                           Players not listed are as in the baseline; dx/dy
+//                           are in 1/kPositionScale px against the baseline
+//                           position (against 0 for a player new to it).
+//                           svarint is a zigzag-encoded varint.
+//   4 input_ack     (s->c)  varint seq, u8 flags (1 approved, 2 position),
+//                           str playerId, [i32 x, i32 y]
+//   5 action        (c->s)  varint seq, varint objectId, str action
+//   5 object_update (s->c)  varint objectId, u8 mask (1 gid, 2 visible,
+//                           4 opacity, 8 pos), [varint gid], [u8 visible],
+//                           [f32 opacity], [i32 x, i32 y]
+//   8 snapshot_ack  (c->s)  varint snapshotId, the newest world_snapshot
+//                           rebuilt; the server may use it as a baseline
+namespace wire {
+
+constexpr std::uint8_t kMagic = 0xB7;
+constexpr std::uint8_t kVersion = 1;
+constexpr float kPositionScale = 16.f;
+
+inline std::int32_t quantize(float v) { return static_cast<std::int32_t>(std::lround(v * kPositionScale)); }
+inline float dequantize(std::int32_t v) { return static_cast<float>(v) / kPositionScale; }
+
+inline bool isBinary(std::string_view bytes) {
+  return bytes.size() >= 2 && static_cast<std::uint8_t>(bytes[0]) == kMagic;
+}
+
+// Appends fields to a byte string. Reuse the string between messages to
+// keep its capacity.
+class Writer {
+ public:
+  explicit Writer(std::string& out) : out_(out) {}
+
+  void header();
+  void u8(std::uint8_t v) { out_.push_back(static_cast<char>(v)); }
+  void varint(std::uint64_t v);
+  void svarint(std::int64_t v);
+  void i32(std::int32_t v);
+  void f32(float v);
+  void str(std::string_view s);
+  void position(sf::Vector2f p);
+
+ private:
+  std::string& out_;
+};
+
+// Reads fields from a byte string. Any read past the end, or a malformed
+// varint, clears ok() and returns zero values from then on.
+class Reader {
+ public:
+  explicit Reader(std::string_view bytes) : p_(bytes.data()), end_(p_ + bytes.size()) {}
+
+  bool header();  // false for wrong magic or unsupported version
+  std::uint8_t u8();
+  std::uint64_t varint();
+  std::int64_t svarint();
+  std::int32_t i32();
+  float f32();
+  std::string_view str();
+  sf::Vector2f position();
+
+  bool ok() const { return ok_; }
+  bool atEnd() const { return p_ == end_; }
+
+ private:
+  bool need(std::size_t n);
+
+  const char* p_;
+  const char* end_;
+  bool ok_ = true;
+};
+
+// ---- Messages ----
+
+struct PlayerInput {
+  std::uint32_t sequence = 0;
+  sf::Vector2f velocity;
+};
+
+struct PlayerAction {
+  std::uint32_t sequence = 0;
+  std::uint32_t objectId = 0;
+  std::string_view action;
+};
+
+struct PlayerState {
+  std::uint32_t netId = 0;
+  std::string_view userId;  // empty unless the server sent it
+  sf::Vector2f position;
+  std::uint32_t lastSequence = 0;
+};
+
+struct InputAck {
+  std::uint32_t sequence = 0;
+  bool approved = false;
+  bool hasPosition = false;
+  std::string_view playerId;
+  sf::Vector2f position;
+};
+
+struct ObjectUpdate {
+  enum Field : std::uint8_t { kGid = 1, kVisible = 2, kOpacity = 4, kPos = 8 };
+  std::uint32_t objectId = 0;
+  std::uint8_t fields = 0;
+  std::uint32_t gid = 0;
+  bool visible = true;
+  float opacity = 1.f;
+  sf::Vector2f pos;
+};
+
+struct SnapshotEntry {
+  enum Field : std::uint8_t { kUserId = 1, kPosition = 2, kSequence = 4, kRemoved = 8 };
+  std::uint32_t netId = 0;
+  std::uint8_t fields = 0;
+  std::string_view userId;
+  std::int32_t dx = 0;  // 1/kPositionScale px, against the baseline
+  std::int32_t dy = 0;
+  std::uint32_t lastSequence = 0;
+};
+
+struct SnapshotAck {
+  std::uint32_t snapshotId = 0;
+};
+
+// Encoders replace the contents of `out`.
+void encode(const PlayerInput& msg, std::string& out);
+// Several inputs in one packet, oldest first; the last one is current.
+void encode(std::span<const PlayerInput> inputs, std::string& out);
+void encode(const PlayerAction& msg, std::string& out);
+void encode(const InputAck& msg, std::string& out);
+void encode(const ObjectUpdate& msg, std::string& out);
+void encode(const SnapshotAck& msg, std::string& out);
+
+// Decoders take the whole message (header included). Views in the result
+// point into `bytes`.
+bool decode(std::string_view bytes, PlayerInput& out);
+// All inputs of a packet, newest first, up to out.size(). Returns how many
+// were read; 0 for a malformed message.
+std::size_t decode(std::string_view bytes, std::span<PlayerInput> out);
+bool decode(std::string_view bytes, PlayerAction& out);
+bool decode(std::string_view bytes, InputAck& out);
+bool decode(std::string_view bytes, ObjectUpdate& out);
+bool decode(std::string_view bytes, SnapshotAck& out);
+
+// world_update is streamed: entries are read one at a time with no
+// intermediate container.
+class WorldUpdateWriter {
+ public:
+  // `count` must match the number of add() calls that follow.
+  WorldUpdateWriter(std::string& out, std::uint32_t count);
+  void add(const PlayerState& state);
+
+ private:
+  Writer w_;
+};
+
+class WorldUpdateReader {
+ public:
+  explicit WorldUpdateReader(std::string_view bytes);
+
+  bool ok() const { return r_.ok(); }
+  std::uint32_t count() const { return count_; }
+  // False once all entries are read or the message is malformed.
+  bool next(PlayerState& out);
+
+ private:
+  Reader r_;
+  std::uint32_t count_ = 0;
+  std::uint32_t read_ = 0;
+};
+
+// world_snapshot is streamed the same way. See SnapshotHistory for the
+// client side.
+class SnapshotWriter {
+ public:
+  // `count` must match the number of add() calls that follow, which must
+  // come in ascending netId order.
+  SnapshotWriter(std::string& out, std::uint32_t snapshotId, std::uint32_t baselineId,
+                 std::uint32_t count);
+  void add(const SnapshotEntry& entry);
+
+ private:
+  Writer w_;
+};
+
+class SnapshotReader {
+ public:
+  explicit SnapshotReader(std::string_view bytes);
+
+  bool ok() const { return r_.ok(); }
+  std::uint32_t snapshotId() const { return snapshotId_; }
+  std::uint32_t baselineId() const { return baselineId_; }
+  std::uint32_t count() const { return count_; }
+  // False once all entries are read or the message is malformed.
+  bool next(SnapshotEntry& out);
+
+ private:
+  Reader r_;
+  std::uint32_t snapshotId_ = 0;
+  std::uint32_t baselineId_ = 0;
+  std::uint32_t count_ = 0;
+  std::uint32_t read_ = 0;
+};
+
+}  // namespace wire
+
+#endif  // NETWORKING_WIREPROTOCOL_H_
@@ -3,13 +3,16 @@
 #include "GameScene.h"
 
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "../../graphics/FontCache.h"
 #include "../../input/InputManager.h"
+#include "../../vendor/dotenv-cpp/dotenv.h"
 #include "../SceneManager.h"
 
 GameScene::GameScene(sf::RenderWindow& window, AuthManager& authManager,
@@ -23,7 +26,8 @@ GameScene::GameScene(sf::RenderWindow& window, AuthManager& authManager,
       m_worldMap("/elderford/world.json"),
       m_worldRenderer(std::make_unique<WorldRenderer>(m_worldMap)),
       m_camera(windowRef, 300.0f),
-      m_networking(std::make_unique<Networking>(nakamaClient)) {
+      m_networking(std::make_unique<Networking>(nakamaClient)),
+      m_labelBatch(FontCache::instance().defaultFont()) {
   std::cout << "GameScene created." << std::endl;
   m_inputManager.mapActionToKey("camera_move_up", sf::Keyboard::Key::W);
   m_inputManager.mapActionToKey("camera_move_down", sf::Keyboard::Key::S);
@@ -33,9 +37,37 @@ GameScene::GameScene(sf::RenderWindow& window, AuthManager& authManager,
                                         sf::Mouse::Button::Right);
   m_inputManager.mapActionToMouseButton("player_interact",
                                         sf::Mouse::Button::Left);
+  m_inputManager.mapActionToKey("toggle_render_stats", sf::Keyboard::Key::F3);
+  m_inputManager.mapActionToKey("toggle_debug_text_remote", sf::Keyboard::Key::F4);
+  m_inputManager.mapActionToKey("toggle_debug_text_local", sf::Keyboard::Key::F5);
+  m_inputManager.mapActionToKey("toggle_network_stats", sf::Keyboard::Key::F6);
+
+  // NET_SIM_* in .env puts a simulated bad network under match traffic.
+  const NetworkConditions conditions = NetworkConditions::fromEnvironment();
+  if (conditions.active() && nakamaClient) {
+    std::cout << "GameScene: Simulating network conditions (" << conditions.send.latencyMs
+              << " ms latency, " << conditions.send.jitterMs << " ms jitter, "
+              << conditions.send.lossPercent << "% loss, seed " << conditions.seed << ")"
+              << std::endl;
+    m_networking->setRtClientFactory([nakamaClient, conditions] {
+      return std::make_shared<ConditionedRtClient>(nakamaClient->createRtClient(), conditions);
+    });
+  }
 }
 
-GameScene::~GameScene() { std::cout << "GameScene destroyed." << std::endl; }
+GameScene::~GameScene() {
+  // The callbacks capture this scene. m_networking is destroyed after
+  // m_players and m_labelBatch, so drop them and the worker here, while
+  // everything the callbacks touch is still alive.
+  detachNetworking();
+  std::cout << "GameScene destroyed." << std::endl;
+}
+
+void GameScene::detachNetworking() {
+  if (!m_networking) return;
+  m_networking->clearCallbacks();
+  m_networking->stopNetworkThread(false);
+}
 
 void GameScene::onEnter(SceneManager& sceneManager) {
   std::cout << "Entering GameScene." << std::endl;
@@ -59,15 +91,25 @@ void GameScene::onEnter(SceneManager& sceneManager) {
     }
 
     m_networking->setPlayerStateUpdateCallback(
-        [this](const std::string& playerId, const sf::Vector2f& position,
+        [this](PlayerHandle player, const sf::Vector2f& position,
                unsigned int lastProcessedSequence) {
-          this->handlePlayerStateUpdate(playerId, position,
+          this->handlePlayerStateUpdate(player, position,
                                         lastProcessedSequence);
         });
 
     m_networking->setInputAckCallback(
-        [this](const nlohmann::json& ack) {
-          this->handleInputAck(ack);
+        [this](PlayerHandle player, const wire::InputAck& ack) {
+          this->handleInputAck(player, ack);
+        });
+
+    m_networking->setObjectUpdateCallback(
+        [this](const wire::ObjectUpdate& update) {
+          this->handleObjectUpdate(update);
+        });
+
+    m_networking->setPresenceCallback(
+        [this](PlayerHandle player, bool joined) {
+          this->handlePresence(player, joined);
         });
 
   } else {
@@ -77,13 +119,27 @@ void GameScene::onEnter(SceneManager& sceneManager) {
     return;
   }
 
-  m_localPlayer = std::make_unique<Player>("local_player_id", sf::Color::Black);
+  const std::string statsFile = dotenv::getenv("NET_STATS_FILE", "");
+  if (!statsFile.empty() && !m_networkStatsLog.isOpen()) {
+    if (m_networkStatsLog.open(statsFile)) {
+      std::cout << "GameScene: Writing network stats to " << statsFile << std::endl;
+    } else {
+      std::cerr << "GameScene: Cannot open NET_STATS_FILE " << statsFile << std::endl;
+    }
+  }
+
+  m_localPlayer = std::make_unique<Player>("local_player_id", sf::Color::Black, true);
+  m_players.setLocalPlayer(m_localPlayer.get());
   if (session) {
     m_localPlayer->setId(session->getUserId());
+    m_localPlayerHandle = m_networking->playerIds().intern(session->getUserId());
     std::cout << "GameScene: Local player ID set to: " << session->getUserId()
               << std::endl;
   }
   m_localPlayer->setPosition(sf::Vector2f(100.f, 100.f));
+  PredictionSettings prediction;
+  prediction.smoothing = 10.f;
+  m_localPlayer->setPredictionSettings(prediction);
 
   if (m_networking) {
     m_networking->listMatches(
@@ -119,6 +175,7 @@ void GameScene::onEnter(SceneManager& sceneManager) {
 
 void GameScene::onExit(SceneManager& sceneManager) {
   std::cout << "Exiting GameScene." << std::endl;
+  detachNetworking();
   if (m_networking && !m_networking->getCurrentMatchId().empty()) {
     // TODO(miszczu): Implement
     // m_networking->leaveMatch(m_networking->getCurrentMatchId());
@@ -135,8 +192,28 @@ void GameScene::handleEvent(const sf::Event& event, SceneManager& manager) {
 }
 
 void GameScene::update(sf::Time deltaTime, SceneManager& manager) {
+  if (m_inputManager.isActionPressed("toggle_render_stats")) {
+    m_renderStatsPanel.toggle();
+  }
+  if (m_inputManager.isActionPressed("toggle_debug_text_remote")) {
+    Player::setDebugTextEnabled(false, !Player::isDebugTextEnabled(false));
+  }
+  if (m_inputManager.isActionPressed("toggle_debug_text_local")) {
+    Player::setDebugTextEnabled(true, !Player::isDebugTextEnabled(true));
+  }
+  if (m_inputManager.isActionPressed("toggle_network_stats")) {
+    m_networkStatsPanel.toggle();
+  }
+
   if (m_networking) {
     m_networking->tick();
+    // Join callbacks run inside tick(); once in a match, socket polling and
+    // message decoding move to the network thread.
+    if (!m_networking->networkThreadRunning() &&
+        !m_networking->getCurrentMatchId().empty()) {
+      m_networking->startNetworkThread();
+    }
+    sampleNetworkStats();
   }
 
   m_camera.setMovingUp(m_inputManager.isActionActive("camera_move_up"));
@@ -144,6 +221,7 @@ void GameScene::update(sf::Time deltaTime, SceneManager& manager) {
   m_camera.setMovingLeft(m_inputManager.isActionActive("camera_move_left"));
   m_camera.setMovingRight(m_inputManager.isActionActive("camera_move_right"));
   m_camera.update(deltaTime);
+  m_worldMap.advanceAnimations(deltaTime);
 
   if (m_localPlayer && m_networking) {
     if (m_inputManager.isActionActive("player_move")) {
@@ -157,14 +235,6 @@ void GameScene::update(sf::Time deltaTime, SceneManager& manager) {
         newDirection /= length;
       }
       m_localPlayer->setTargetDirection(newDirection);
-      if (newDirection.x != 0.f || newDirection.y != 0.f) {
-        m_networking->sendPlayerUpdate(m_localPlayer->getDirection(),
-                                       m_localPlayer->getSpeed(),
-                                       m_localPlayer->getNextSequenceNumber());
-        std::cout << "GameScene: Player movement command sent. Direction: ("
-                  << m_localPlayer->getDirection().x << ", "
-                  << m_localPlayer->getDirection().y << ")" << std::endl;
-      }
     } else if (m_inputManager.isActionReleased("player_interact")) {
       sf::Vector2i mousePos = sf::Mouse::getPosition(windowRef);
       sf::Vector2f worldPos =
@@ -175,146 +245,197 @@ void GameScene::update(sf::Time deltaTime, SceneManager& manager) {
       if (objectId == -1) {
         std::cout << "GameScene: No interactable object at position ("
                   << worldPos.x << ", " << worldPos.y << ")" << std::endl;
-        return;
-      }
-
-      std::string action = "interact";
-      m_networking->sendPlayerAction(objectId, action,
-                                     m_localPlayer->getNextSequenceNumber());
-      std::cout << "GameScene: Player interaction command sent. ObjectID: "
-                << objectId << ", Action: " << action << std::endl;
-    } else {
-      if (m_localPlayer->getDirection().x != 0.f ||
-          m_localPlayer->getDirection().y != 0.f) {
-        m_localPlayer->setTargetDirection({0.f, 0.f});
-        m_networking->sendPlayerUpdate(m_localPlayer->getDirection(),
-                                       m_localPlayer->getSpeed(),
+      } else {
+        std::string action = "interact";
+        m_networking->sendPlayerAction(objectId, action,
                                        m_localPlayer->getNextSequenceNumber());
-        std::cout << "GameScene: Player stopped. Sending zero direction. Seq: "
-                  << m_localPlayer->getNextSequenceNumber() - 1 << std::endl;
+        std::cout << "GameScene: Player interaction command sent. ObjectID: "
+                  << objectId << ", Action: " << action << std::endl;
       }
+    } else {
+      m_localPlayer->setTargetDirection({0.f, 0.f});
     }
+
+    // Intent is sampled every frame but only sent on network ticks.
+    m_inputScheduler.sample(m_localPlayer->getDirection() *
+                            m_localPlayer->getSpeed());
+    if (m_inputScheduler.update(deltaTime, [this] {
+          return m_localPlayer->getNextSequenceNumber();
+        })) {
+      m_networking->sendPlayerInputs(m_inputScheduler.packet());
+    }
+    // Predict with what the server will apply, not the unsent intent.
+    const wire::PlayerInput committed = m_inputScheduler.latest();
+    m_localPlayer->setPredictionInput(committed.sequence, committed.velocity);
   }
 
   if (m_localPlayer) {
     m_localPlayer->update(deltaTime);
   }
 
-  for (auto& pair : m_otherPlayers) {
-    pair.second->update(deltaTime);
-  }
+  reportInterest(m_players.update(deltaTime, m_camera.getView()));
 
   m_inputManager.update();
 }
 
-void GameScene::render(sf::RenderTarget& target) {
-  // Apply camera to world
-  m_camera.applyTo(target);
+float GameScene::beginFrameTiming() {
+  // Frame time is measured render-to-render so it covers update, networking
+  // and the previous present as well as drawing.
+  const float frameMs = m_frameClock.restart().asMicroseconds() / 1000.f;
+  m_frameTimes.push(frameMs);
+  m_worldRenderer->resetStats();
+  return frameMs;
+}
 
-  // Configure renderer as you already did
+void GameScene::configureRenderer() {
   m_worldRenderer->setCulling(true);
+  m_worldRenderer->setDepthSorting(true);
   m_worldRenderer->setDebugGrid(true);
 
   // Enable debug for clickable object areas based on toggle state
   m_worldRenderer->setDebugObjectAreas(true);
   m_worldRenderer->setDebugObjectAreasColor(
       sf::Color(0, 255, 255, 128));  // Cyan with transparency
+}
+
+void GameScene::render(sf::RenderTarget& target) {
+  const float frameMs = beginFrameTiming();
+
+  // Apply camera to world
+  m_camera.applyTo(target);
+
+  configureRenderer();
 
   // 1) Ground & floor layers first
   m_worldRenderer->renderGround(target);
 
-  // 2) Actors (local player, then others)
-  if (m_localPlayer) {
-    m_localPlayer->render(target);
-    m_camera.setCenter(m_localPlayer->getPosition());
-  }
-
-  for (const auto& pair : m_otherPlayers) {
-    pair.second->render(target);
-  }
+  // 2) Actor-level objects and actors, interleaved by foot Y
+  m_labelBatch.clear();
+  TargetRenderSink sink(target);
+  m_players.render(*m_worldRenderer, sink, m_labelBatch);
+  if (m_localPlayer) m_camera.setCenter(m_localPlayer->getPosition());
 
   // 3) Occluders/overlays (walls, roofs, etc.) after players
   m_worldRenderer->renderOverlays(target);
 
+  // 4) Name plates and debug labels on top, in a single draw call
+  m_labelBatch.draw(target);
+
+  m_renderStats = m_worldRenderer->stats();
+  m_renderStats.frameMs = frameMs;
+
   // Restore default view for UI
   target.setView(target.getDefaultView());
+
+  renderUi();
+}
+
+void GameScene::captureSnapshot(RenderSnapshot& snapshot) {
+  const float frameMs = beginFrameTiming();
+
+  // Same pass order as render(), but recorded for the render thread. The
+  // recorded lists are culled against the camera view.
+  snapshot.worldView = m_camera.getView();
+  snapshot.ground.setView(snapshot.worldView);
+  snapshot.depth.setView(snapshot.worldView);
+  snapshot.overlays.setView(snapshot.worldView);
+
+  configureRenderer();
+  m_worldRenderer->renderGround(snapshot.ground);
+
+  // Actors become markers in the depth list, indexing snapshot.actors.
+  m_players.captureSnapshot(*m_worldRenderer, snapshot);
+  if (m_localPlayer) m_camera.setCenter(m_localPlayer->getPosition());
+
+  m_worldRenderer->renderOverlays(snapshot.overlays);
+
+  m_renderStats = m_worldRenderer->stats();
+  m_renderStats.frameMs = frameMs;
+}
+
+void GameScene::reportInterest(const sf::FloatRect& interest) {
+  // The server only needs to hear about it once the view has moved a fair
+  // part of the margin.
+  constexpr float kThreshold = PlayerLayer::kInterestMargin / 2.f;
+  const sf::Vector2f moved = interest.position - m_sentInterest.position;
+  if (m_networking && (std::abs(moved.x) > kThreshold || std::abs(moved.y) > kThreshold ||
+                       interest.size != m_sentInterest.size)) {
+    if (m_networking->sendInterestRect(interest)) m_sentInterest = interest;
+  }
 }
 
-void GameScene::handlePlayerStateUpdate(const std::string& playerId,
+void GameScene::sampleNetworkStats() {
+  const float now = m_networkStatsClock.getElapsedTime().asSeconds();
+  if (now < m_nextNetworkSample) return;
+  m_nextNetworkSample = now + kNetworkStatsInterval;
+  if (!m_networkStatsPanel.isVisible() && !m_networkStatsLog.isOpen()) return;
+
+  const NetworkStats stats = m_networking->networkStats();
+  m_networkStatsPanel.sample(now, stats);
+  m_networkStatsLog.write(now, stats);
+}
+
+void GameScene::renderUi() {
+  m_renderStatsPanel.draw(m_renderStats, m_frameTimes);
+  m_networkStatsPanel.draw();
+}
+
+void GameScene::handlePlayerStateUpdate(PlayerHandle player,
                                         const sf::Vector2f& position,
                                         unsigned int lastProcessedSequence) {
-  if (m_localPlayer && playerId == m_localPlayer->getId()) {
+  if (m_localPlayer && player == m_localPlayerHandle) {
     m_localPlayer->handleServerUpdate(position, lastProcessedSequence);
   } else {
-    auto it = m_otherPlayers.find(playerId);
-    if (it == m_otherPlayers.end()) {
+    const std::string& playerId = m_networking->playerIds().name(player);
+    if (m_players.applyServerState(player, playerId, position, lastProcessedSequence)) {
       std::cout << "GameScene: New player detected with ID: " << playerId
                 << std::endl;
-      auto newPlayer = std::make_unique<Player>(playerId, sf::Color::Red);
-      newPlayer->setPosition(position);
-      newPlayer->handleServerUpdate(position, lastProcessedSequence);
-      m_otherPlayers[playerId] = std::move(newPlayer);
-    } else {
-      it->second->handleServerUpdate(position, lastProcessedSequence);
     }
   }
 }
 
-void GameScene::handleInputAck(const nlohmann::json& ack) {
-  try {
-    if (!ack.is_object()) return;
-    std::string type = ack.value("type", "");
-    nlohmann::json data = ack.value("data", nlohmann::json::object());
+void GameScene::handlePresence(PlayerHandle player, bool joined) {
+  // Joining players are spawned by their first state update, once their
+  // position is known.
+  if (joined || player == m_localPlayerHandle) return;
 
-    // debug log for data
-    for (auto& [key, value] : data.items()) {
-      std::cout << "ACK Data - " << key << ": " << value << std::endl;
-    }
+  if (!m_players.despawn(player)) return;
+  std::cout << "GameScene: Player left: " << m_networking->playerIds().name(player)
+            << std::endl;
+}
 
-    // Common fields
-    std::string playerId = data.value("playerId", "");
-    unsigned int inputSequence = data.value("inputSequence", 0u);
-    bool approved = data.value("approved", false);
-
-    if (type == "input_ack" && data.contains("x") && data.contains("y")) {
-      float x = data.value("x", 0.0f);
-      float y = data.value("y", 0.0f);
-      sf::Vector2f serverPos(x, y);
-
-      if (m_localPlayer && playerId == m_localPlayer->getId()) {
-        std::cout << "GameScene: Input ACK (pos) for local player. ID: " << playerId
-                  << ", Seq: " << inputSequence << ", Approved: " << (approved ? "Yes" : "No")
-                  << ", ServerPos: (" << x << ", " << y << ")" << std::endl;
-        m_localPlayer->handleServerAck(inputSequence, approved, serverPos);
-      } else if (playerId.empty()) {
-        std::cerr << "GameScene: Received position ACK with empty playerId" << std::endl;
-      } else {
-        // ACK for another player: update other player's position or create them
-        handlePlayerStateUpdate(playerId, serverPos, inputSequence);
-      }
-    }
+void GameScene::handleInputAck(PlayerHandle player, const wire::InputAck& ack) {
+  if (!ack.hasPosition) return;
 
-    if (type == "object_update" && data.contains("objectId")) {
-      int objectId = data.value("objectId", -1);
+  if (m_localPlayer && player == m_localPlayerHandle) {
+    m_localPlayer->handleServerAck(ack.sequence, ack.approved, ack.position);
+  } else if (player == kInvalidPlayerHandle) {
+    std::cerr << "GameScene: Received position ACK with empty playerId" << std::endl;
+  } else {
+    // ACK for another player: update other player's position or create them
+    handlePlayerStateUpdate(player, ack.position, ack.sequence);
+  }
+}
 
-      std::cout << "GameScene: Received object update ACK. ObjectID: " << objectId << std::endl;
+void GameScene::handleObjectUpdate(const wire::ObjectUpdate& update) {
+  using Field = wire::ObjectUpdate::Field;
+  const int objectId = static_cast<int>(update.objectId);
 
-      nlohmann::json objProps = nlohmann::json::object();
-      // Copy supported fields
-      if (data.contains("gid")) objProps["gid"] = data["gid"];
-      if (data.contains("visible")) objProps["visible"] = data["visible"];
-      if (data.contains("opacity")) objProps["opacity"] = data["opacity"];
-      if (data.contains("pos")) objProps["pos"] = data["pos"];
+  WorldMap::ObjectChanges changes;
+  if (update.fields & Field::kGid) changes.gid = update.gid;
+  if (update.fields & Field::kVisible) changes.visible = update.visible;
+  if (update.fields & Field::kOpacity) changes.opacity = update.opacity;
+  if (update.fields & Field::kPos) changes.pos = update.pos;
 
-      bool updated = m_worldMap.updateObject(objectId, objProps);
-      if (updated) {
-        // If the world changed, clear renderer caches and rebuild draw order
-        // for object layers so changes are visible immediately.
-        m_worldRenderer->invalidateCache(true);
-        std::cout << "GameScene: World updated for object " << objectId << ", renderer invalidated." << std::endl;
-      }
+  try {
+    if (m_worldMap.updateObject(objectId, changes)) {
+      // If the world changed, clear renderer caches and rebuild draw order
+      // for object layers so changes are visible immediately.
+      m_worldRenderer->invalidateCache(true);
     }
   } catch (const std::exception& e) {
-    std::cerr << "GameScene::handleInputAck: Failed to process ACK JSON: " << e.what() << std::endl;
+    // Unknown object id: the server and the loaded map disagree.
+    std::cerr << "GameScene::handleObjectUpdate: Object " << objectId << ": " << e.what()
+              << std::endl;
   }
 }
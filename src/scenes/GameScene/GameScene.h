@@ -3,9 +3,10 @@
 #pragma once
 
 #include <nakama-cpp/Nakama.h>
-#include <map>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 #include <nlohmann/json.hpp>
 
 #include <SFML/Graphics.hpp>
@@ -13,11 +14,19 @@
 #include "../Scene.h"
 #include "../../auth/AuthManager.h"
 #include "../../graphics/Camera.h"
+#include "../../graphics/NetworkStatsPanel.h"
+#include "../../graphics/RenderSnapshot.h"
+#include "../../graphics/RenderStats.h"
+#include "../../graphics/RenderStatsPanel.h"
+#include "../../graphics/TextBatch.h"
 #include "../../input/InputManager.h"
+#include "../../networking/ConditionedRtClient.h"
+#include "../../networking/InputScheduler.h"
 #include "../../networking/Networking.h"
 #include "../../world/WorldMap.h"
 #include "../../world/WorldRenderer.h"
 #include "../../world/entities/Player.h"
+#include "../../world/entities/PlayerLayer.h"
 
 class SceneManager;
 
@@ -32,10 +41,15 @@ class GameScene : public Scene {
   void handleEvent(const sf::Event& event, SceneManager& manager) override;
   void update(sf::Time deltaTime, SceneManager& manager) override;
   void render(sf::RenderTarget& target) override;  // Corrected signature
+  bool supportsSnapshots() const override { return true; }
+  void captureSnapshot(RenderSnapshot& snapshot) override;
+  void renderUi() override;
 
-  void handlePlayerStateUpdate(const std::string& playerId, const sf::Vector2f& position,
+  void handlePlayerStateUpdate(PlayerHandle player, const sf::Vector2f& position,
                                unsigned int lastProcessedSequence);
-  void handleInputAck(const nlohmann::json& ack);
+  void handleInputAck(PlayerHandle player, const wire::InputAck& ack);
+  void handleObjectUpdate(const wire::ObjectUpdate& update);
+  void handlePresence(PlayerHandle player, bool joined);
 
  private:
   sf::RenderWindow& windowRef;
@@ -45,7 +59,36 @@ class GameScene : public Scene {
   std::unique_ptr<WorldRenderer> m_worldRenderer;
   Camera m_camera;
   std::unique_ptr<Player> m_localPlayer;
+  PlayerHandle m_localPlayerHandle = kInvalidPlayerHandle;
   std::unique_ptr<Networking> m_networking;
+  InputScheduler m_inputScheduler;  // local movement, sent at the network tick
   SceneManager* sceneManager = nullptr;
-  std::map<std::string, std::unique_ptr<Player>> m_otherPlayers;
+  // Remote and local players, updated and drawn in the depth-sorted pass.
+  PlayerLayer m_players;
+  // Interest rect last reported to the server.
+  sf::FloatRect m_sentInterest;
+
+  // All player labels, drawn with one call after the world.
+  TextBatch m_labelBatch;
+
+  // Frame profiling (toggled with F3)
+  RenderStats m_renderStats;
+  FrameTimeHistory m_frameTimes;
+  RenderStatsPanel m_renderStatsPanel;
+  sf::Clock m_frameClock;
+
+  // Network telemetry (toggled with F6), sampled once a second and appended
+  // to NET_STATS_FILE when set.
+  static constexpr float kNetworkStatsInterval = 1.f;
+  NetworkStatsPanel m_networkStatsPanel;
+  NetworkStatsLog m_networkStatsLog;
+  sf::Clock m_networkStatsClock;
+  float m_nextNetworkSample = 0.f;
+
+  float beginFrameTiming();
+  // Stops the network thread and clears the callbacks into this scene.
+  void detachNetworking();
+  void configureRenderer();
+  void reportInterest(const sf::FloatRect& interest);
+  void sampleNetworkStats();
 };
@@ -5,6 +5,7 @@
 #include <SFML/Graphics.hpp>
 
 class SceneManager;
+struct RenderSnapshot;
 
 enum class SceneType {
   None,
@@ -25,5 +26,14 @@ class Scene {
   virtual void handleEvent(const sf::Event& event, SceneManager& manager) = 0;
   virtual void update(sf::Time deltaTime, SceneManager& manager) = 0;
   virtual void render(sf::RenderTarget& target) = 0;
+
+  // Render-thread support. Scenes that can describe their world as a
+  // RenderSnapshot return true here; in render-thread mode they get
+  // captureSnapshot() (no ImGui calls allowed) followed by renderUi() (ImGui
+  // widgets only) instead of render(). Other scenes keep drawing through
+  // render(), executed synchronously on the render thread.
+  virtual bool supportsSnapshots() const { return false; }
+  virtual void captureSnapshot(RenderSnapshot& /*snapshot*/) {}
+  virtual void renderUi() {}
   SceneManager* sceneManager = nullptr;
 };
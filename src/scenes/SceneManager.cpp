@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "imgui-SFML.h"
+#include "../graphics/RenderThread.h"
 
 SceneManager::SceneManager(sf::RenderWindow& window)
     : currentScene(nullptr),
@@ -109,7 +110,13 @@ void SceneManager::processSceneSwitch() {
 }
 
 void SceneManager::handleEvent(sf::RenderWindow& window, const sf::Event& event) {
-  ImGui::SFML::ProcessEvent(window, event);
+  if (renderThread) {
+    // The render thread may still be inside ImGui::SFML::Render for the
+    // previous frame; replay the event once it is done.
+    pendingImGuiEvents.push_back(event);
+  } else {
+    ImGui::SFML::ProcessEvent(window, event);
+  }
 
   if (currentScene) {
     currentScene->handleEvent(event, *this);
@@ -121,16 +128,56 @@ void SceneManager::update(sf::RenderWindow& window, sf::Time deltaTime) {
   if (currentScene) {
     currentScene->update(deltaTime, *this);
   }
+  if (renderThread) {
+    lastDeltaTime = deltaTime;  // ImGui is updated from render()
+    return;
+  }
   ImGui::SFML::Update(window, deltaTime);
 }
 
+void SceneManager::beginImGuiFrame(sf::RenderWindow& window) {
+  renderThread->waitForUi();
+  for (const auto& event : pendingImGuiEvents) {
+    ImGui::SFML::ProcessEvent(window, event);
+  }
+  pendingImGuiEvents.clear();
+  ImGui::SFML::Update(window, lastDeltaTime);
+}
+
 void SceneManager::render(sf::RenderWindow& target) {
+  if (renderThread) {
+    if (currentScene && currentScene->supportsSnapshots()) {
+      // World capture overlaps with the render thread drawing the previous
+      // frame; only the ImGui part has to wait for it.
+      RenderSnapshot& snapshot = renderThread->beginFrame();
+      currentScene->captureSnapshot(snapshot);
+      beginImGuiFrame(target);
+      currentScene->renderUi();
+      renderThread->publish();
+    } else {
+      beginImGuiFrame(target);
+      renderThread->runSync([this](sf::RenderWindow& window) {
+        window.clear(sf::Color(30, 30, 30));
+        if (currentScene) {
+          currentScene->render(window);
+        }
+        ImGui::SFML::Render(window);
+      });
+    }
+    return;
+  }
+
   if (currentScene) {
     currentScene->render(target);
   }
   ImGui::SFML::Render(target);
 }
 
+void SceneManager::attachRenderThread(RenderThread* renderThread) {
+  this->renderThread = renderThread;
+  pendingImGuiEvents.clear();
+}
+
 void SceneManager::shutdown() {
   ImGui::SFML::Shutdown();
   std::cout << "SceneManager ImGui::SFML::Shutdown() called" << std::endl;
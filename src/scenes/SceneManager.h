@@ -4,11 +4,14 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include <SFML/Graphics.hpp>
 
 #include "Scene.h"
 
+class RenderThread;
+
 class SceneManager {
  public:
   explicit SceneManager(sf::RenderWindow& window);
@@ -26,6 +29,11 @@ class SceneManager {
   void render(sf::RenderWindow& window);
   void shutdown();
 
+  // Route rendering through a render thread (nullptr to draw inline). While
+  // attached, render() also presents the frame and ImGui input/update is
+  // deferred until the render thread has finished with the previous UI.
+  void attachRenderThread(RenderThread* renderThread);
+
   sf::RenderWindow* window = nullptr;
 
  private:
@@ -34,5 +42,10 @@ class SceneManager {
   SceneType currentSceneType = SceneType::None;
   SceneType requestedSceneType = SceneType::None;
 
+  RenderThread* renderThread = nullptr;
+  std::vector<sf::Event> pendingImGuiEvents;
+  sf::Time lastDeltaTime;
+
   void processSceneSwitch();
+  void beginImGuiFrame(sf::RenderWindow& window);
 };
@@ -7,6 +7,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -165,6 +166,10 @@ void WorldMap::loadTilesetInline(const fs::path& mapDir, const json& tsj) {
         "Unsupported embedded tileset format (need 'image' or 'tiles[]').");
   }
 
+  if (tsj.contains("tiles") && tsj.at("tiles").is_array()) {
+    for (const auto& tile : tsj.at("tiles")) parseTileAnimation(tile, ts);
+  }
+
   tilesets_.push_back(std::move(ts));
 }
 
@@ -276,6 +281,10 @@ void WorldMap::loadTilesetExternal(const fs::path& mapDir,
                              src.string());
   }
 
+  if (tj.contains("tiles") && tj.at("tiles").is_array()) {
+    for (const auto& tile : tj.at("tiles")) parseTileAnimation(tile, ts);
+  }
+
   tilesets_.push_back(std::move(ts));
 }
 
@@ -306,6 +315,131 @@ void WorldMap::applyFlipTexcoords(bool h, bool v, bool d, sf::Vector2f tc[4]) {
   }
 }
 
+void WorldMap::parseTileAnimation(const json& tile, Tileset& ts) {
+  if (!tile.contains("id") || !tile.contains("animation") ||
+      !tile.at("animation").is_array()) {
+    return;
+  }
+  std::vector<Tileset::AnimationFrame> frames;
+  frames.reserve(tile.at("animation").size());
+  for (const auto& f : tile.at("animation")) {
+    Tileset::AnimationFrame frame;
+    frame.tileId = f.value("tileid", 0);
+    frame.durationMs = f.value("duration", 100);
+    frames.push_back(frame);
+  }
+  if (!frames.empty()) {
+    ts.animations[tile.at("id").get<int>()] = std::move(frames);
+  }
+}
+
+void WorldMap::registerAnimatedTile(LayerMesh::Chunk& chunk,
+                                    const Tileset& ts, uint32_t localId,
+                                    uint32_t firstVertex, bool h, bool v,
+                                    bool d) {
+  // Image-collection frames live in different textures, which a single
+  // chunk cannot switch between, so only spritesheet animations are used.
+  if (ts.animations.empty() || ts.imageCollection || ts.columns <= 0) return;
+  auto it = ts.animations.find(static_cast<int>(localId));
+  if (it == ts.animations.end()) return;
+
+  const uint64_t key =
+      (static_cast<uint64_t>(static_cast<uint32_t>(ts.firstGid)) << 32) |
+      localId;
+  auto [lookup, inserted] = animationLookup_.try_emplace(
+      key, static_cast<uint32_t>(animations_.size()));
+  if (inserted) {
+    TileAnimation anim;
+    anim.tileSize = {static_cast<float>(ts.tileWidth),
+                     static_cast<float>(ts.tileHeight)};
+    for (const auto& frame : it->second) {
+      const int tu = frame.tileId % ts.columns;
+      const int tv = frame.tileId / ts.columns;
+      anim.frameOrigins.push_back(
+          {static_cast<float>(ts.margin + tu * (ts.tileWidth + ts.spacing)),
+           static_cast<float>(ts.margin + tv * (ts.tileHeight + ts.spacing))});
+      anim.totalMs += std::max(1, frame.durationMs);
+      anim.frameEndMs.push_back(anim.totalMs);
+    }
+    animations_.push_back(std::move(anim));
+  }
+
+  LayerMesh::Chunk::AnimatedTile tile;
+  tile.firstVertex = firstVertex;
+  tile.animation = lookup->second;
+  tile.flips = static_cast<uint8_t>((h ? 1 : 0) | (v ? 2 : 0) | (d ? 4 : 0));
+  chunk.animatedTiles.push_back(tile);
+  // Tile objects can be drawn larger than their tileset tile, so the view
+  // cutoff in applyAnimationFrames goes by the quad as placed.
+  const sf::Vertex* quad = &chunk.vertices[firstVertex];
+  maxAnimatedQuadHeight_ =
+      std::max(maxAnimatedQuadHeight_, quad[2].position.y - quad[0].position.y);
+}
+
+void WorldMap::advanceAnimations(sf::Time deltaTime) {
+  if (animations_.empty()) return;
+  animationClockUs_ += deltaTime.asMicroseconds();
+  const int64_t nowMs = animationClockUs_ / 1000;
+  for (auto& anim : animations_) {
+    const int t = static_cast<int>(nowMs % anim.totalMs);
+    // Frame lists are a handful of entries; a linear scan is cheapest.
+    int frame = 0;
+    while (anim.frameEndMs[frame] <= t) ++frame;
+    anim.currentFrame = frame;
+  }
+}
+
+std::size_t WorldMap::applyAnimationFrames(LayerMesh::Chunk& chunk,
+                                           const sf::FloatRect* visible) const {
+  auto& tiles = chunk.animatedTiles;
+  if (tiles.empty()) return 0;
+
+  auto first = tiles.begin();
+  float maxTop = std::numeric_limits<float>::max();
+  if (visible) {
+    // Tiles are stored in row-major order, so rows above the view are
+    // skipped with a binary search on the tiles' top edge.
+    const float minTop = visible->position.y - maxAnimatedQuadHeight_;
+    first = std::partition_point(
+        tiles.begin(), tiles.end(),
+        [&](const LayerMesh::Chunk::AnimatedTile& t) {
+          return chunk.vertices[t.firstVertex].position.y < minTop;
+        });
+    maxTop = visible->position.y + visible->size.y;
+  }
+
+  std::size_t rewritten = 0;
+  for (auto it = first; it != tiles.end(); ++it) {
+    auto& tile = *it;
+    sf::Vertex* t = &chunk.vertices[tile.firstVertex];
+    if (visible) {
+      if (t[0].position.y > maxTop) break;  // every later row is lower
+      if (t[2].position.y < visible->position.y ||
+          t[2].position.x < visible->position.x ||
+          t[0].position.x > visible->position.x + visible->size.x) {
+        continue;
+      }
+    }
+
+    const TileAnimation& anim = animations_[tile.animation];
+    if (tile.shownFrame == anim.currentFrame) continue;
+
+    const sf::Vector2f o = anim.frameOrigins[anim.currentFrame];
+    const sf::Vector2f sz = anim.tileSize;
+    sf::Vector2f uv[4] = {o, {o.x + sz.x, o.y}, o + sz, {o.x, o.y + sz.y}};
+    applyFlipTexcoords(tile.flips & 1, tile.flips & 2, tile.flips & 4, uv);
+    t[0].texCoords = uv[0];
+    t[1].texCoords = uv[1];
+    t[2].texCoords = uv[2];
+    t[3].texCoords = uv[0];
+    t[4].texCoords = uv[2];
+    t[5].texCoords = uv[3];
+    tile.shownFrame = anim.currentFrame;
+    ++rewritten;
+  }
+  return rewritten;
+}
+
 void WorldMap::buildLayers(const json& j) {
   layers_.clear();
   for (const auto& lj : j.at("layers")) {
@@ -412,6 +546,9 @@ void WorldMap::buildLayers(const json& j) {
       for (int i = 0; i < 6; ++i) {
         t[i].color.a = a;
       }
+
+      registerAnimatedTile(*chunk, *ts, localId, static_cast<uint32_t>(base),
+                           h, v, d);
     };
 
     // tile layers (grid-aligned)
@@ -483,6 +620,9 @@ void WorldMap::buildLayers(const json& j) {
         const sf::Texture* tex{};
         std::array<sf::Vertex, 6> tri{};
         float sortY = 0.f;
+        const Tileset* ts = nullptr;
+        uint32_t localId = 0;
+        bool h = false, v = false, d = false;
       };
 
       std::vector<ObjDraw> drawables;
@@ -547,6 +687,11 @@ void WorldMap::buildLayers(const json& j) {
           od.pos = pos;
           od.tex = tex;
           od.sortY = footY;
+          od.ts = ts;
+          od.localId = localId;
+          od.h = h;
+          od.v = v;
+          od.d = d;
 
           auto& t = od.tri;
           t[0].position = pos;
@@ -600,6 +745,7 @@ void WorldMap::buildLayers(const json& j) {
             for (int i = 0; i < 6; ++i) {
               ch.vertices[i] = od.tri[i];
             }
+            registerAnimatedTile(ch, *od.ts, od.localId, 0, od.h, od.v, od.d);
 
             mesh.chunk_buckets[key].chunks.push_back(std::move(ch));
 
@@ -836,29 +982,42 @@ int WorldMap::getObjectIdAtPosition(const sf::Vector2f& worldPos) const {
 
 bool WorldMap::updateObject(int objectId, const nlohmann::json& props,
                             std::vector<int>* outAffectedLayers) {
+  // Supported props: gid (number), visible (bool), opacity (number)
+  ObjectChanges changes;
+  if (props.contains("gid") && props["gid"].is_number()) {
+    changes.gid = props.value("gid", 0u);
+  }
+  if (props.contains("visible") && props["visible"].is_boolean()) {
+    changes.visible = props.value("visible", true);
+  }
+  if (props.contains("opacity") &&
+      (props["opacity"].is_number() || props["opacity"].is_number_float())) {
+    changes.opacity = props.value("opacity", 1.0f);
+  }
+  if (props.contains("pos") && props["pos"].is_object() &&
+      props["pos"].contains("x") && props["pos"].contains("y") &&
+      (props["pos"]["x"].is_number() || props["pos"]["x"].is_number_float()) &&
+      (props["pos"]["y"].is_number() || props["pos"]["y"].is_number_float())) {
+    changes.pos = sf::Vector2f(props["pos"].value("x", 0.f),
+                               props["pos"].value("y", 0.f));
+  }
+  return updateObject(objectId, changes, outAffectedLayers);
+}
+
+bool WorldMap::updateObject(int objectId, const ObjectChanges& changes,
+                            std::vector<int>* outAffectedLayers) {
   bool changed = false;
 
   if (outAffectedLayers) outAffectedLayers->clear();
 
-  // Supported props: gid (number), visible (bool), opacity (number)
-  const bool hasGid = props.contains("gid") && props["gid"].is_number();
-  const bool hasVisible =
-      props.contains("visible") && props["visible"].is_boolean();
-  const bool hasOpacity =
-      props.contains("opacity") &&
-      (props["opacity"].is_number() || props["opacity"].is_number_float());
-  const bool hasPos =
-      props.contains("pos") && props["pos"].is_object() &&
-      props["pos"].contains("x") && props["pos"].contains("y") &&
-      (props["pos"]["x"].is_number() || props["pos"]["x"].is_number_float()) &&
-      (props["pos"]["y"].is_number() || props["pos"]["y"].is_number_float());
+  const bool hasGid = changes.gid.has_value();
+  const bool hasVisible = changes.visible.has_value();
+  const bool hasOpacity = changes.opacity.has_value();
+  const bool hasPos = changes.pos.has_value();
 
-  uint32_t newGid = 0;
-  if (hasGid) newGid = props.value("gid", 0u);
-  bool newVisible = false;
-  float newOpacity = 1.0f;
-  if (hasVisible) newVisible = props.value("visible", true);
-  if (hasOpacity) newOpacity = props.value("opacity", 1.0f);
+  const uint32_t newGid = changes.gid.value_or(0);
+  const bool newVisible = changes.visible.value_or(false);
+  const float newOpacity = changes.opacity.value_or(1.0f);
 
   // Helper to mark affected layer index
   auto markLayer = [&](int li) {
@@ -981,6 +1140,10 @@ bool WorldMap::updateObject(int objectId, const nlohmann::json& props,
                   chunk.vertices[4].texCoords = uv[2];
                   chunk.vertices[5].texCoords = uv[3];
 
+                  // The new gid may start, stop or change an animation
+                  chunk.animatedTiles.clear();
+                  registerAnimatedTile(chunk, *ts, localId, 0, h, v, d);
+
                   thisChanged = true;
                 }
               }
@@ -1007,8 +1170,8 @@ bool WorldMap::updateObject(int objectId, const nlohmann::json& props,
                                std::to_string(objectId));
     }
 
-    const float newX = props["pos"].value("x", 0.f);
-    const float newY = props["pos"].value("y", 0.f);
+    const float newX = changes.pos->x;
+    const float newY = changes.pos->y;
 
     // Gather distinct layers from index
     std::vector<int> layersToProcess;
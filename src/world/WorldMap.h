@@ -3,7 +3,9 @@
 #ifndef WORLD_WORLDMAP_H_
 #define WORLD_WORLDMAP_H_
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -51,6 +53,11 @@ class WorldMap {
       std::vector<Object> objects;
     };
 
+    struct AnimationFrame {  // Tiled per-tile "animation" entry
+      int tileId = 0;
+      int durationMs = 0;
+    };
+
     int firstGid = 0;
     std::string name;
 
@@ -71,6 +78,10 @@ class WorldMap {
     // object groups (collision, action areas, etc)
     std::unordered_map<int, ObjectGroup>
         objectGroups;  // tile localId -> ObjectGroup
+
+    // tile animations
+    std::unordered_map<int, std::vector<AnimationFrame>>
+        animations;  // tile localId -> frames
   };
 
   struct LayerMesh {
@@ -100,6 +111,16 @@ class WorldMap {
       // (in world units). This is set at load time so runtime object
       // movements can preserve per-chunk layout.
       sf::Vector2f offset{0.f, 0.f};
+      // Animated tiles inside this chunk, in vertex order (row-major for
+      // tile layers). Their UVs are patched in place by
+      // WorldMap::applyAnimationFrames when the chunk is drawn.
+      struct AnimatedTile {
+        uint32_t firstVertex = 0;  // first of the tile's 6 vertices
+        uint32_t animation = 0;    // index into WorldMap's animation table
+        uint8_t flips = 0;         // bit 0: h, bit 1: v, bit 2: d
+        int32_t shownFrame = -1;   // frame currently written to the UVs
+      };
+      std::vector<AnimatedTile> animatedTiles;
       Chunk() : vertices(sf::PrimitiveType::Triangles) {}
     };
     struct ChunkBucket {
@@ -171,15 +192,47 @@ class WorldMap {
   bool updateObject(int objectId, const nlohmann::json& props,
                     std::vector<int>* outAffectedLayers = nullptr);
 
+  // Typed form of the same update, for callers that already decoded the
+  // message. Unset fields are left unchanged.
+  struct ObjectChanges {
+    std::optional<uint32_t> gid;
+    std::optional<bool> visible;
+    std::optional<float> opacity;
+    std::optional<sf::Vector2f> pos;
+  };
+  bool updateObject(int objectId, const ObjectChanges& changes,
+                    std::vector<int>* outAffectedLayers = nullptr);
+
   // Rebuild the object_draw_order for a single object layer. This updates
   // the internal draw order pointers and is used by the renderer to only
   // refresh affected layers after runtime mutations.
   void rebuildObjectDrawOrderForLayer(int layerIndex);
 
+  // Tile animations. advanceAnimations() moves the shared animation clock
+  // (once per frame); applyAnimationFrames() rewrites the UVs of animated
+  // tiles whose frame changed since they were last drawn. Only tiles that
+  // intersect `visible` (chunk-local coordinates) are touched, so off-screen
+  // animations cost nothing. Returns the number of tiles rewritten.
+  void advanceAnimations(sf::Time deltaTime);
+  bool hasAnimations() const { return !animations_.empty(); }
+  // Parse a Tiled tile entry's "animation" array into ts.animations.
+  static void parseTileAnimation(const nlohmann::json& tile, Tileset& ts);
+  std::size_t applyAnimationFrames(LayerMesh::Chunk& chunk,
+                                   const sf::FloatRect* visible) const;
+
   // Test helper: give tests mutable access to layers to populate small maps
   // without having to load JSON files from disk.
   std::vector<LayerMesh>& layersMutable() { return layers_; }
 
+  // Test helper: mutable tilesets for synthetic maps, plus access to the
+  // loader's animated tile registration.
+  std::vector<Tileset>& tilesetsMutable() { return tilesets_; }
+  void registerAnimatedTileForTests(LayerMesh::Chunk& chunk, const Tileset& ts,
+                                    uint32_t localId, uint32_t firstVertex,
+                                    bool h, bool v, bool d) {
+    registerAnimatedTile(chunk, ts, localId, firstVertex, h, v, d);
+  }
+
   // Test helper: allow tests to set tile size (used when constructing
   // synthetic maps via layersMutable()).
   void setTileSize(int w, int h) { tileWidth_ = w; tileHeight_ = h; }
@@ -206,12 +259,31 @@ class WorldMap {
   void buildLayers(const nlohmann::json& map);
   static uint32_t clearFlipFlags(uint32_t gid) { return gid & 0x1FFFFFFFu; }
   static void applyFlipTexcoords(bool h, bool v, bool d, sf::Vector2f tc[4]);
+  void registerAnimatedTile(LayerMesh::Chunk& chunk, const Tileset& ts,
+                            uint32_t localId, uint32_t firstVertex, bool h,
+                            bool v, bool d);
 
  private:
+  // Compiled animation: frame UV origins in texture pixels and cumulative
+  // frame end times, shared by every tile that uses it.
+  struct TileAnimation {
+    std::vector<sf::Vector2f> frameOrigins;
+    std::vector<int> frameEndMs;
+    sf::Vector2f tileSize;
+    int totalMs = 0;
+    int currentFrame = 0;
+  };
+
   int mapWidth_ = 0, mapHeight_ = 0;
   int tileWidth_ = 0, tileHeight_ = 0;
   std::vector<Tileset> tilesets_;  // sorted by firstGid
   std::vector<LayerMesh> layers_;  // draw order
+
+  std::vector<TileAnimation> animations_;
+  // (firstGid << 32 | localId) -> index into animations_
+  std::unordered_map<uint64_t, uint32_t> animationLookup_;
+  int64_t animationClockUs_ = 0;
+  float maxAnimatedQuadHeight_ = 0.f;  // tallest animated quad as drawn
 };
 
 #endif  // WORLD_WORLDMAP_H_
@@ -3,14 +3,14 @@
 #include "WorldRenderer.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <limits>
 #include <string>
 #include <unordered_set>
 #include <vector>
 #include <optional>
 
-#include <SFML/Graphics/ConvexShape.hpp>
-#include <SFML/Graphics/RectangleShape.hpp>
 
 using LM = WorldMap::LayerMesh;
 
@@ -36,6 +36,17 @@ bool WorldRenderer::isOverlayName(std::string_view name) {
          n.find("level_1_1") != std::string::npos;
 }
 
+bool WorldRenderer::isActorLevelName(std::string_view name) {
+  std::string n(name);
+  n = toLower(n);
+  return n.find("level_0_") != std::string::npos;
+}
+
+bool WorldRenderer::isDepthSortedLayer(const LM& layer) const {
+  return depthSorting_ && isObjectLayerName(layer.name) &&
+         isActorLevelName(layer.name) && !layer.object_draw_order.empty();
+}
+
 bool WorldRenderer::isObjectLayerName(std::string_view name) {
   std::string n(name);
   n = toLower(n);
@@ -66,11 +77,86 @@ sf::FloatRect WorldRenderer::boundsFor(const sf::VertexArray& va) const {
   return r;
 }
 
-void WorldRenderer::drawLayerMesh(sf::RenderTarget& target,
+void WorldRenderer::resetStats() {
+  stats_.reset();
+  lastTexture_ = nullptr;
+}
+
+void WorldRenderer::submit(RenderSink& sink, const sf::VertexArray& va,
+                           const sf::RenderStates& states) const {
+  if (states.texture != lastTexture_) {
+    ++stats_.textureSwitches;
+    lastTexture_ = states.texture;
+  }
+  ++stats_.drawCalls;
+  stats_.vertices += static_cast<std::uint32_t>(va.getVertexCount());
+  sink.draw(va, states);
+}
+
+void WorldRenderer::submit(RenderSink& sink, const sf::Vertex* vertices,
+                           std::size_t count, sf::PrimitiveType type,
+                           const sf::RenderStates& states) const {
+  if (states.texture != lastTexture_) {
+    ++stats_.textureSwitches;
+    lastTexture_ = states.texture;
+  }
+  ++stats_.drawCalls;
+  stats_.vertices += static_cast<std::uint32_t>(count);
+  sink.draw(vertices, count, type, states);
+}
+
+sf::FloatRect WorldRenderer::localVisibleRect(
+    const RenderSink& sink, const sf::RenderStates& states) const {
+  const auto& v = sink.getView();
+  const sf::Vector2f c = v.getCenter();
+  const sf::Vector2f sz = v.getSize();
+  const sf::FloatRect worldView({c.x - sz.x * 0.5f, c.y - sz.y * 0.5f}, {sz.x, sz.y});
+  const sf::Transform inv = states.transform.getInverse();
+  const sf::Vector2f tl = inv.transformPoint(worldView.position);
+  const sf::Vector2f tr = inv.transformPoint({worldView.position.x + worldView.size.x, worldView.position.y});
+  const sf::Vector2f br = inv.transformPoint({
+      worldView.position.x + worldView.size.x,
+      worldView.position.y + worldView.size.y
+  });
+  const sf::Vector2f bl = inv.transformPoint({worldView.position.x, worldView.position.y + worldView.size.y});
+  const float minX = std::min(std::min(tl.x, tr.x), std::min(br.x, bl.x));
+  const float minY = std::min(std::min(tl.y, tr.y), std::min(br.y, bl.y));
+  const float maxX = std::max(std::max(tl.x, tr.x), std::max(br.x, bl.x));
+  const float maxY = std::max(std::max(tl.y, tr.y), std::max(br.y, bl.y));
+  return sf::FloatRect({minX, minY}, {maxX - minX, maxY - minY});
+}
+
+bool WorldRenderer::prepareChunk(const LM::Chunk& ch,
+                                 const sf::FloatRect& localVisible) const {
+  if (!ch.visible || ch.opacity <= 0.f || ch.vertices.getVertexCount() == 0) return false;
+
+  if (cull_) {
+    const sf::FloatRect b = boundsFor(ch.vertices);
+    if (!b.findIntersection(localVisible)) {
+      ++stats_.chunksCulled;
+      return false;
+    }
+  }
+
+  if (!ch.animatedTiles.empty()) {
+    // Patch UVs of on-screen animated tiles in place (the map is only
+    // logically const here, as in invalidateCache).
+    stats_.animatedTiles += static_cast<std::uint32_t>(
+        map_.applyAnimationFrames(const_cast<LM::Chunk&>(ch),
+                                  cull_ ? &localVisible : nullptr));
+  }
+  return true;
+}
+
+void WorldRenderer::drawLayerMesh(RenderSink& sink,
                                   sf::RenderStates states,
                                   const LM& layer) const {
   if (!layer.visible || layer.opacity <= 0.f) return;
 
+  sf::Clock layerClock;
+  const std::uint32_t drawCallsBefore = stats_.drawCalls;
+  const std::uint32_t verticesBefore = stats_.vertices;
+
   sf::RenderStates s = states;
   s.transform *= getTransform();
 
@@ -90,44 +176,35 @@ void WorldRenderer::drawLayerMesh(sf::RenderTarget& target,
 
   // If culling is enabled compute the local-visible rect once
   sf::FloatRect localVisible;
-  if (cull_) {
-    const auto& v = target.getView();
-    const sf::Vector2f c = v.getCenter();
-    const sf::Vector2f sz = v.getSize();
-    const sf::FloatRect worldView({c.x - sz.x * 0.5f, c.y - sz.y * 0.5f}, {sz.x, sz.y});
-    const sf::Transform inv = s.transform.getInverse();
-    const sf::Vector2f tl = inv.transformPoint(worldView.position);
-    const sf::Vector2f tr = inv.transformPoint({worldView.position.x + worldView.size.x, worldView.position.y});
-    const sf::Vector2f br = inv.transformPoint({
-        worldView.position.x + worldView.size.x,
-        worldView.position.y + worldView.size.y
-    });
-    const sf::Vector2f bl = inv.transformPoint({worldView.position.x, worldView.position.y + worldView.size.y});
-    const float minX = std::min(std::min(tl.x, tr.x), std::min(br.x, bl.x));
-    const float minY = std::min(std::min(tl.y, tr.y), std::min(br.y, bl.y));
-    const float maxX = std::max(std::max(tl.x, tr.x), std::max(br.x, bl.x));
-    const float maxY = std::max(std::max(tl.y, tr.y), std::max(br.y, bl.y));
-    localVisible = sf::FloatRect({minX, minY}, {maxX - minX, maxY - minY});
-  }
+  if (cull_) localVisible = localVisibleRect(sink, s);
 
   // Draw all chunks from the draw list, applying culling when active
   for (const auto* chptr : drawList) {
-    if (!chptr) continue;
+    if (!chptr || !prepareChunk(*chptr, localVisible)) continue;
     const auto& ch = *chptr;
-    if (!ch.visible || ch.opacity <= 0.f || ch.vertices.getVertexCount() == 0) continue;
-
-    if (cull_) {
-      const sf::FloatRect b = boundsFor(ch.vertices);
-      if (!b.findIntersection(localVisible)) continue;
-    }
 
     sf::RenderStates cs = s;
     cs.texture = ch.texture;
-    target.draw(ch.vertices, cs);
+    ++stats_.chunksDrawn;
+    submit(sink, ch.vertices, cs);
   }
 
   if (debugObjectAreas_ && isObjectLayerName(layer.name)) {
-    drawDebugObjectAreas(target, states, layer);
+    drawDebugObjectAreas(sink, states, layer);
+  }
+
+  RenderStats::LayerTiming timing;
+  timing.name = layer.name;
+  timing.ms = layerClock.getElapsedTime().asMicroseconds() / 1000.f;
+  timing.drawCalls = stats_.drawCalls - drawCallsBefore;
+  timing.vertices = stats_.vertices - verticesBefore;
+  stats_.layers.push_back(timing);
+}
+
+void WorldRenderer::render(RenderSink& sink, sf::RenderStates states) const {
+  // Legacy: draw all layers in map order (useful for quick debugging)
+  for (const auto& l : map_.layers()) {
+    drawLayerMesh(sink, states, l);
   }
 }
 
@@ -137,9 +214,16 @@ void WorldRenderer::renderGround(sf::RenderTarget& target) const {
 
 void WorldRenderer::renderGround(sf::RenderTarget& target,
                                  sf::RenderStates states) const {
+  TargetRenderSink sink(target);
+  renderGround(sink, states);
+}
+
+void WorldRenderer::renderGround(RenderSink& sink,
+                                 sf::RenderStates states) const {
+  sf::Clock clock;
   for (const auto& l : map_.layers()) {
     if (isGroundName(l.name)) {
-      drawLayerMesh(target, states, l);
+      drawLayerMesh(sink, states, l);
     }
   }
 
@@ -147,14 +231,16 @@ void WorldRenderer::renderGround(sf::RenderTarget& target,
     sf::RenderStates s = states;
     s.transform *= getTransform();
 
-    const auto& v = target.getView();
+    const auto& v = sink.getView();
     const sf::Vector2f c = v.getCenter();
     const sf::Vector2f sz = v.getSize();
     const sf::FloatRect worldView({c.x - sz.x * 0.5f, c.y - sz.y * 0.5f},
                                   {sz.x, sz.y});
 
-    drawDebugGrid(target, s, worldView);
+    drawDebugGrid(sink, s, worldView);
   }
+
+  stats_.groundMs += clock.getElapsedTime().asMicroseconds() / 1000.f;
 }
 
 void WorldRenderer::renderOverlays(sf::RenderTarget& target) const {
@@ -163,22 +249,131 @@ void WorldRenderer::renderOverlays(sf::RenderTarget& target) const {
 
 void WorldRenderer::renderOverlays(sf::RenderTarget& target,
                                    sf::RenderStates states) const {
+  TargetRenderSink sink(target);
+  renderOverlays(sink, states);
+}
+
+void WorldRenderer::renderOverlays(RenderSink& sink,
+                                   sf::RenderStates states) const {
+  sf::Clock clock;
   for (const auto& l : map_.layers()) {
-    if (isOverlayName(l.name)) {
-      drawLayerMesh(target, states, l);
+    if (isOverlayName(l.name) && !isDepthSortedLayer(l)) {
+      drawLayerMesh(sink, states, l);
     }
   }
+  stats_.overlaysMs += clock.getElapsedTime().asMicroseconds() / 1000.f;
 }
 
-void WorldRenderer::draw(sf::RenderTarget& target,
-                         sf::RenderStates states) const {
-  // Legacy: draw all layers in map order (useful for quick debugging)
+void WorldRenderer::renderDepthSorted(sf::RenderTarget& target,
+                                      const std::vector<DepthActor>& actors,
+                                      const ActorDrawFn& drawActor,
+                                      sf::RenderStates states) const {
+  TargetRenderSink sink(target);
+  renderDepthSorted(sink, actors, drawActor, states);
+}
+
+void WorldRenderer::renderDepthSorted(RenderSink& sink,
+                                      const std::vector<DepthActor>& actors,
+                                      const ActorDrawFn& drawActor,
+                                      sf::RenderStates states) const {
+  sf::Clock clock;
+  const std::uint32_t drawCallsBefore = stats_.drawCalls;
+  const std::uint32_t verticesBefore = stats_.vertices;
+
+  sf::RenderStates s = states;
+  s.transform *= getTransform();
+  sf::FloatRect localVisible;
+  if (cull_) localVisible = localVisibleRect(sink, s);
+
+  // One cursor per depth-sorted layer; each object_draw_order is already
+  // sorted by sortY, so the pass is a k-way merge with the actor list.
+  depthCursors_.clear();
   for (const auto& l : map_.layers()) {
-    drawLayerMesh(target, states, l);
+    if (!isDepthSortedLayer(l) || !l.visible || l.opacity <= 0.f) continue;
+    const auto* first = l.object_draw_order.data();
+    depthCursors_.emplace_back(first, first + l.object_draw_order.size());
+  }
+
+  batch_.clear();
+  batchTexture_ = nullptr;
+  std::size_t nextActor = 0;
+  for (;;) {
+    // Layers are few (usually one), so a linear pick beats a heap.
+    ChunkCursor* best = nullptr;
+    for (auto& cursor : depthCursors_) {
+      while (cursor.first != cursor.second && !*cursor.first) ++cursor.first;
+      if (cursor.first == cursor.second) continue;
+      if (!best || (*cursor.first)->sortY < (*best->first)->sortY) best = &cursor;
+    }
+
+    // On equal foot Y the object is drawn first, so the actor ends up on top.
+    if (nextActor < actors.size() &&
+        (!best || actors[nextActor].sortY < (*best->first)->sortY)) {
+      flushBatch(sink, s);
+      drawActor(actors[nextActor].id, sink);
+      ++stats_.actorsDrawn;
+      ++nextActor;
+      continue;
+    }
+    if (!best) break;
+
+    const LM::Chunk& ch = **best->first;
+    ++best->first;
+    if (!prepareChunk(ch, localVisible)) continue;
+
+    ++stats_.chunksDrawn;
+    if (ch.texture != batchTexture_) {
+      flushBatch(sink, s);
+      batchTexture_ = ch.texture;
+    }
+    const std::size_t n = ch.vertices.getVertexCount();
+    for (std::size_t i = 0; i < n; ++i) batch_.push_back(ch.vertices[i]);
+  }
+  flushBatch(sink, s);
+
+  if (debugObjectAreas_) {
+    for (const auto& l : map_.layers()) {
+      if (isDepthSortedLayer(l) && l.visible) drawDebugObjectAreas(sink, states, l);
+    }
   }
+
+  RenderStats::LayerTiming timing;
+  timing.name = "depth pass";
+  timing.ms = clock.getElapsedTime().asMicroseconds() / 1000.f;
+  timing.drawCalls = stats_.drawCalls - drawCallsBefore;
+  timing.vertices = stats_.vertices - verticesBefore;
+  stats_.layers.push_back(timing);
+  stats_.depthMs += timing.ms;
+}
+
+void WorldRenderer::flushBatch(RenderSink& sink,
+                               const sf::RenderStates& states) const {
+  if (batch_.empty()) return;
+  sf::RenderStates bs = states;
+  bs.texture = batchTexture_;
+  submit(sink, batch_.data(), batch_.size(), sf::PrimitiveType::Triangles, bs);
+  batch_.clear();
+}
+
+void WorldRenderer::sortDepthActors(std::vector<DepthActor>& actors) {
+  for (std::size_t i = 1; i < actors.size(); ++i) {
+    const DepthActor a = actors[i];
+    std::size_t j = i;
+    while (j > 0 && actors[j - 1].sortY > a.sortY) {
+      actors[j] = actors[j - 1];
+      --j;
+    }
+    actors[j] = a;
+  }
+}
+
+void WorldRenderer::draw(sf::RenderTarget& target,
+                         sf::RenderStates states) const {
+  TargetRenderSink sink(target);
+  render(sink, states);
 }
 
-void WorldRenderer::drawDebugGrid(sf::RenderTarget& target,
+void WorldRenderer::drawDebugGrid(RenderSink& sink,
                                   sf::RenderStates states,
                                   const sf::FloatRect& visibleWorld) const {
   const int tw = map_.tileWidth();
@@ -216,11 +411,11 @@ void WorldRenderer::drawDebugGrid(sf::RenderTarget& target,
       push({x, y2}, {x, y});
     }
   }
-  target.draw(lines, states);
+  submit(sink, lines, states);
 }
 
 void WorldRenderer::drawDebugObjectAreas(
-    sf::RenderTarget& target, sf::RenderStates states,
+    RenderSink& sink, sf::RenderStates states,
     const WorldMap::LayerMesh& layer) const {
   if (!layer.visible || layer.opacity <= 0.f || !debugObjectAreas_) {
     return;
@@ -229,6 +424,11 @@ void WorldRenderer::drawDebugObjectAreas(
   sf::RenderStates s = states;
   s.transform *= getTransform();
 
+  // All outlines and fills for the layer are accumulated into one triangle
+  // list so they can be recorded by command-list sinks and go out in a single
+  // draw call instead of two shapes per object.
+  sf::VertexArray geometry(sf::PrimitiveType::Triangles);
+
   // For each chunk in the layer, draw both chunk bounds and their associated
   // object groups
   for (const auto& [_, bucket] : layer.chunk_buckets) {
@@ -297,80 +497,88 @@ void WorldRenderer::drawDebugObjectAreas(
               continue;
             }
 
-            // Adjust alpha for better visibility
-            objColor.a = 128;
-
-            // Draw polygon objects
+            std::vector<sf::Vector2f> points;
             if (!obj.polygon.empty()) {
-              sf::ConvexShape polygon;
-              polygon.setPointCount(obj.polygon.size());
-
-              // Set the position of each point
-              for (size_t i = 0; i < obj.polygon.size(); ++i) {
-                // Map object local coordinates to world coordinates
-                sf::Vector2f worldPos = map_.objectToWorld(
-                    gid, pos.x, pos.y, obj.x + obj.polygon[i].x,
-                    obj.y + obj.polygon[i].y);
-
-                polygon.setPoint(i, worldPos);
+              // Map object local coordinates to world coordinates
+              points.reserve(obj.polygon.size());
+              for (const auto& p : obj.polygon) {
+                points.push_back(map_.objectToWorld(gid, pos.x, pos.y,
+                                                    obj.x + p.x, obj.y + p.y));
               }
-
-              // Draw outline
-              polygon.setFillColor(sf::Color::Transparent);
-              polygon.setOutlineColor(objColor);
-              polygon.setOutlineThickness(2.0f);
-              target.draw(polygon, s);
-
-              // Draw semi-transparent fill
-              sf::ConvexShape fillPolygon = polygon;
-              objColor.a = 64;
-              fillPolygon.setFillColor(objColor);
-              fillPolygon.setOutlineThickness(0);
-              target.draw(fillPolygon, s);
             } else if (obj.width > 0 &&
-                      obj.height > 0) {  // Draw rectangle objects
-              // Map object's rectangle to world coordinates
-              sf::Vector2f worldPos =
+                       obj.height > 0) {  // Rectangle objects
+              // Map object's rectangle to world coordinates, rotating around
+              // its top-left corner like sf::RectangleShape does.
+              const sf::Vector2f worldPos =
                   map_.objectToWorld(gid, pos.x, pos.y, obj.x, obj.y);
-
-              sf::RectangleShape rect;
-              rect.setPosition(worldPos);
-              rect.setSize(sf::Vector2f(obj.width, obj.height));
-              rect.setFillColor(sf::Color::Transparent);
-              rect.setOutlineColor(objColor);
-              rect.setOutlineThickness(2.0f);
-
-              // Apply rotation if needed
-              if (obj.rotation != 0) {
-                rect.setRotation(sf::degrees(obj.rotation));
-              }
-
-              target.draw(rect, s);
-
-              // Draw filled rectangle with transparency
-              sf::RectangleShape fillRect = rect;
-              objColor.a = 64;
-              fillRect.setFillColor(objColor);
-              fillRect.setOutlineThickness(0);
-              target.draw(fillRect, s);
+              sf::Transform t;
+              t.translate(worldPos);
+              if (obj.rotation != 0) t.rotate(sf::degrees(obj.rotation));
+              points = {t.transformPoint({0.f, 0.f}),
+                        t.transformPoint({obj.width, 0.f}),
+                        t.transformPoint({obj.width, obj.height}),
+                        t.transformPoint({0.f, obj.height})};
+            } else {
+              continue;
             }
+
+            // Outline first, then semi-transparent fill
+            objColor.a = 128;
+            appendOutline(geometry, points, 2.0f, objColor);
+            objColor.a = 64;
+            appendConvexFill(geometry, points, objColor);
           }
       }
 
       // Draw the chunk bounds for debugging
-      sf::FloatRect bounds = boundsFor(ch.vertices);
-      sf::RectangleShape rect;
-      rect.setPosition(sf::Vector2f(bounds.position.x, bounds.position.y));
-      rect.setSize(sf::Vector2f(bounds.size.x, bounds.size.y));
-      rect.setFillColor(sf::Color::Transparent);
-      rect.setOutlineColor(
-          sf::Color(128, 128, 128, 128));  // Gray with transparency
-      rect.setOutlineThickness(1.0f);
-      target.draw(rect, s);
+      const sf::FloatRect b = boundsFor(ch.vertices);
+      const std::vector<sf::Vector2f> corners = {
+          b.position,
+          {b.position.x + b.size.x, b.position.y},
+          b.position + b.size,
+          {b.position.x, b.position.y + b.size.y}};
+      appendOutline(geometry, corners, 1.0f,
+                    sf::Color(128, 128, 128, 128));  // Gray with transparency
+    }
+  }
+
+  submit(sink, geometry, s);
+}
+
+void WorldRenderer::appendOutline(sf::VertexArray& out,
+                                  const std::vector<sf::Vector2f>& points,
+                                  float thickness, const sf::Color& color) {
+  const size_t n = points.size();
+  if (n < 2) return;
+  const float half = thickness * 0.5f;
+  for (size_t i = 0; i < n; ++i) {
+    const sf::Vector2f a = points[i];
+    const sf::Vector2f b = points[(i + 1) % n];
+    const sf::Vector2f d = b - a;
+    const float len = std::sqrt(d.x * d.x + d.y * d.y);
+    if (len <= 0.f) continue;
+    // Extend along the edge so corners overlap instead of leaving notches.
+    const sf::Vector2f along = d / len * half;
+    const sf::Vector2f normal{-along.y, along.x};
+    const sf::Vector2f p0 = a - along + normal, p1 = b + along + normal;
+    const sf::Vector2f p2 = b + along - normal, p3 = a - along - normal;
+    for (const sf::Vector2f& p : {p0, p1, p2, p0, p2, p3}) {
+      out.append(sf::Vertex{p, color});
     }
   }
 }
 
+void WorldRenderer::appendConvexFill(sf::VertexArray& out,
+                                     const std::vector<sf::Vector2f>& points,
+                                     const sf::Color& color) {
+  // Fan triangulation; object areas are convex like sf::ConvexShape expects.
+  for (size_t i = 1; i + 1 < points.size(); ++i) {
+    out.append(sf::Vertex{points[0], color});
+    out.append(sf::Vertex{points[i], color});
+    out.append(sf::Vertex{points[i + 1], color});
+  }
+}
+
 void WorldRenderer::invalidateCache(bool rebuildObjectDrawOrder) {
   if (rebuildObjectDrawOrder) {
     // Rebuild all layers
@@ -2,12 +2,17 @@
 #ifndef WORLD_WORLDRENDERER_H_
 #define WORLD_WORLDRENDERER_H_
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "WorldMap.h"
+#include "../graphics/RenderCommandList.h"
+#include "../graphics/RenderStats.h"
 
 #include <SFML/Graphics.hpp>
 
@@ -15,6 +20,10 @@
 //  - ground layers
 //  - overlay/occluder layers
 // This allows a scene to render: ground -> actors (player, NPCs) -> overlays
+//
+// Every entry point exists in two flavours: one drawing straight into an
+// sf::RenderTarget and one emitting into a RenderSink (command list, null
+// backend for headless benchmarks). Culling uses the sink's view.
 class WorldRenderer : public sf::Drawable, public sf::Transformable {
  public:
   explicit WorldRenderer(const WorldMap& map) : map_(map) {}
@@ -31,17 +40,55 @@ class WorldRenderer : public sf::Drawable, public sf::Transformable {
     target.draw(*this, states);
   }
 
+  void render(RenderSink& sink, sf::RenderStates states = {}) const;
+
   // New split rendering for actor interleave.
   void renderGround(sf::RenderTarget& target) const;
   void renderGround(sf::RenderTarget& target, sf::RenderStates states) const;
+  void renderGround(RenderSink& sink, sf::RenderStates states = {}) const;
 
   void renderOverlays(sf::RenderTarget& target) const;
   void renderOverlays(sf::RenderTarget& target, sf::RenderStates states) const;
+  void renderOverlays(RenderSink& sink, sf::RenderStates states = {}) const;
+
+  // Depth pass: actor-level object layers (level_0_*) merged with actors by
+  // foot Y in one linear merge, so actors correctly go behind or in front of
+  // objects. Object layers keep their presorted object_draw_order and the
+  // caller keeps `actors` sorted by sortY (nearly sorted frame to frame, see
+  // sortDepthActors), so no per-frame global sort is needed. Consecutive
+  // object chunks sharing a texture are batched into one draw call.
+  //
+  // While depth sorting is enabled, renderOverlays() skips the layers drawn
+  // here.
+  struct DepthActor {
+    float sortY = 0.f;     // world Y of the actor's feet
+    std::uint32_t id = 0;  // caller-defined, passed back to drawActor
+  };
+  using ActorDrawFn = std::function<void(std::uint32_t id, RenderSink& sink)>;
+  void setDepthSorting(bool enabled) { depthSorting_ = enabled; }
+  bool depthSorting() const { return depthSorting_; }
+  void renderDepthSorted(sf::RenderTarget& target,
+                         const std::vector<DepthActor>& actors,
+                         const ActorDrawFn& drawActor,
+                         sf::RenderStates states = {}) const;
+  void renderDepthSorted(RenderSink& sink,
+                         const std::vector<DepthActor>& actors,
+                         const ActorDrawFn& drawActor,
+                         sf::RenderStates states = {}) const;
+
+  // Insertion sort by sortY: O(n) when the list is already nearly sorted,
+  // which is the common case as actors move a few pixels per frame.
+  static void sortDepthActors(std::vector<DepthActor>& actors);
 
   // Compute bounds for a vertex array (cached). Made public so callers
   // like WorldMap::getObjectIdAtPosition can reuse the same logic.
   sf::FloatRect boundsFor(const sf::VertexArray& va) const;
 
+  // Per-frame statistics. Counters accumulate across render* calls until
+  // resetStats() is called, typically once at the start of a frame.
+  void resetStats();
+  const RenderStats& stats() const { return stats_; }
+
   // Invalidate internal caches (bounds cache and optionally object draw orders).
   // If rebuildObjectDrawOrder is true, the renderer will rebuild object_draw_order
   // arrays for object layers by re-scanning map layers. This is useful after
@@ -60,16 +107,43 @@ class WorldRenderer : public sf::Drawable, public sf::Transformable {
   static bool isGroundName(std::string_view n);
   static bool isOverlayName(std::string_view n);
   static bool isObjectLayerName(std::string_view n);
+  static bool isActorLevelName(std::string_view n);
+  bool isDepthSortedLayer(const WorldMap::LayerMesh& layer) const;
 
   // Drawing helpers
-  void drawLayerMesh(sf::RenderTarget& target, sf::RenderStates states,
+  void drawLayerMesh(RenderSink& sink, sf::RenderStates states,
                      const WorldMap::LayerMesh& layer) const;
 
-  void drawDebugGrid(sf::RenderTarget& target, sf::RenderStates states,
+  // View rectangle in the local space of `states` (for culling).
+  sf::FloatRect localVisibleRect(const RenderSink& sink,
+                                 const sf::RenderStates& states) const;
+  // Cull + animate a chunk; returns false if it should not be drawn.
+  bool prepareChunk(const WorldMap::LayerMesh::Chunk& ch,
+                    const sf::FloatRect& localVisible) const;
+
+  // Depth pass batching
+  void flushBatch(RenderSink& sink, const sf::RenderStates& states) const;
+
+  // Submit a draw to the sink and account for it in stats_.
+  void submit(RenderSink& sink, const sf::VertexArray& va,
+              const sf::RenderStates& states) const;
+  void submit(RenderSink& sink, const sf::Vertex* vertices, std::size_t count,
+              sf::PrimitiveType type, const sf::RenderStates& states) const;
+
+  void drawDebugGrid(RenderSink& sink, sf::RenderStates states,
                      const sf::FloatRect& visibleWorld) const;
-  void drawDebugObjectAreas(sf::RenderTarget& target, sf::RenderStates states,
+  void drawDebugObjectAreas(RenderSink& sink, sf::RenderStates states,
                           const WorldMap::LayerMesh& layer) const;
 
+  // Debug geometry helpers: append a closed outline / convex fill as
+  // triangles so debug overlays stay plain vertex data.
+  static void appendOutline(sf::VertexArray& out,
+                            const std::vector<sf::Vector2f>& points,
+                            float thickness, const sf::Color& color);
+  static void appendConvexFill(sf::VertexArray& out,
+                               const std::vector<sf::Vector2f>& points,
+                               const sf::Color& color);
+
   // cached bounds for vertex arrays
   struct BoundsKey {
     const void* ptr;
@@ -92,6 +166,16 @@ class WorldRenderer : public sf::Drawable, public sf::Transformable {
   sf::Color debugGridColor_ = sf::Color::Red;
   sf::Color debugObjectAreasColor_ = sf::Color(0, 255, 255, 128);  // Cyan with transparency
   mutable std::unordered_map<BoundsKey, sf::FloatRect, BoundsKeyHash> cache_;
+  mutable RenderStats stats_;
+  mutable const sf::Texture* lastTexture_ = nullptr;
+
+  bool depthSorting_ = false;
+  // Scratch state for renderDepthSorted, kept to avoid per-frame allocation.
+  using ChunkCursor = std::pair<const WorldMap::LayerMesh::Chunk* const*,
+                                const WorldMap::LayerMesh::Chunk* const*>;
+  mutable std::vector<ChunkCursor> depthCursors_;
+  mutable std::vector<sf::Vertex> batch_;
+  mutable const sf::Texture* batchTexture_ = nullptr;
 };
 
 #endif  // WORLD_WORLDRENDERER_H_
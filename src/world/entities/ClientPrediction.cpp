@@ -0,0 +1,61 @@
+// Copyright 2025 WildSpark Authors
+
+#include "ClientPrediction.h"
+
+#include <cmath>
+
+void ClientPrediction::reset(sf::Vector2f position) {
+  predicted_ = position;
+  correction_ = {0.f, 0.f};
+  count_ = 0;
+  lastReplayCount_ = 0;
+}
+
+void ClientPrediction::step(const MoveInput& input) {
+  if (input.velocity.x == 0.f && input.velocity.y == 0.f) return;
+  predicted_ = simulateMove(predicted_, input);
+
+  // Consecutive frames under the same input are merged into one entry.
+  if (count_ > 0) {
+    MoveInput& last = at(count_ - 1);
+    if (last.sequence == input.sequence && last.velocity == input.velocity) {
+      last.dt += input.dt;
+      return;
+    }
+  }
+  ring_[head_] = input;
+  head_ = (head_ + 1) % kCapacity;
+  if (count_ < kCapacity) ++count_;
+}
+
+void ClientPrediction::reconcile(unsigned int sequence, bool approved,
+                                 sf::Vector2f serverPosition) {
+  if (sequence < lastAck_) return;  // reordered, already superseded
+  lastAck_ = sequence;
+
+  std::size_t acked = 0;
+  while (acked < count_ && (at(acked).sequence < sequence ||
+                            (!approved && at(acked).sequence == sequence))) {
+    ++acked;
+  }
+  dropOldest(acked);
+
+  sf::Vector2f position = serverPosition;
+  for (std::size_t i = 0; i < count_; ++i) position = simulateMove(position, at(i));
+  lastReplayCount_ = count_;
+
+  const sf::Vector2f error = displayed() - position;
+  predicted_ = position;
+  const float distance = std::sqrt(error.x * error.x + error.y * error.y);
+  correction_ = settings_.smoothing > 0.f && distance <= settings_.snapDistance
+                    ? error
+                    : sf::Vector2f(0.f, 0.f);
+}
+
+void ClientPrediction::update(float dt) {
+  if (correction_.x == 0.f && correction_.y == 0.f) return;
+  correction_ *= std::exp(-settings_.smoothing * dt);
+  if (correction_.x * correction_.x + correction_.y * correction_.y < 1e-4f) {
+    correction_ = {0.f, 0.f};
+  }
+}
@@ -0,0 +1,66 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef WORLD_ENTITIES_CLIENTPREDICTION_H_
+#define WORLD_ENTITIES_CLIENTPREDICTION_H_
+
+#include <array>
+#include <cstddef>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "MovementModel.h"
+
+struct PredictionSettings {
+  float smoothing = 0.f;       // correction decay rate (1/s); 0 = snap
+  float snapDistance = 64.f;   // larger corrections always snap
+};
+
+// Client-side prediction for the local player.
+//
+// Every frame of movement is applied immediately and recorded in a ring
+// buffer together with the sequence number of the input in effect. The
+// server holds the velocity of input N until N+1 arrives, so an ack for N
+// carries the position at the moment N was applied: frames recorded under
+// N and later are replayed on top of it, earlier ones are dropped.
+//
+// The difference between the old and the replayed prediction is kept as a
+// correction offset that decays over time when smoothing is enabled, so
+// small mispredictions don't pop.
+class ClientPrediction {
+ public:
+  static constexpr std::size_t kCapacity = 128;
+
+  void reset(sf::Vector2f position);
+  void setSettings(const PredictionSettings& settings) { settings_ = settings; }
+  const PredictionSettings& settings() const { return settings_; }
+
+  // Moves by one frame and records it for replay.
+  void step(const MoveInput& input);
+  // Rewinds to the authoritative position and replays unacknowledged input.
+  // A rejected input is not replayed; the ones after it still are.
+  void reconcile(unsigned int sequence, bool approved, sf::Vector2f serverPosition);
+  // Decays the correction offset.
+  void update(float dt);
+
+  sf::Vector2f predicted() const { return predicted_; }
+  sf::Vector2f correction() const { return correction_; }
+  sf::Vector2f displayed() const { return predicted_ + correction_; }
+  std::size_t pendingInputs() const { return count_; }
+  std::size_t lastReplayCount() const { return lastReplayCount_; }
+
+ private:
+  MoveInput& at(std::size_t i) { return ring_[(head_ + kCapacity - count_ + i) % kCapacity]; }
+  void dropOldest(std::size_t n) { count_ -= n; }
+
+  PredictionSettings settings_;
+  sf::Vector2f predicted_;
+  sf::Vector2f correction_;
+  unsigned int lastAck_ = 0;
+  std::size_t lastReplayCount_ = 0;
+
+  std::array<MoveInput, kCapacity> ring_{};
+  std::size_t head_ = 0;  // next write position
+  std::size_t count_ = 0;
+};
+
+#endif  // WORLD_ENTITIES_CLIENTPREDICTION_H_
@@ -0,0 +1,238 @@
+// Copyright 2025 WildSpark Authors
+
+#include "EntityStore.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+// Same tessellation as sf::CircleShape's default (30 points).
+constexpr std::size_t kCirclePoints = 30;
+
+const std::array<sf::Vector2f, kCirclePoints>& unitCircle() {
+  static const auto table = [] {
+    std::array<sf::Vector2f, kCirclePoints> t;
+    for (std::size_t i = 0; i < kCirclePoints; ++i) {
+      const float a = static_cast<float>(i) * 2.f * 3.14159265f / kCirclePoints - 3.14159265f / 2.f;
+      t[i] = {std::cos(a), std::sin(a)};
+    }
+    return t;
+  }();
+  return table;
+}
+
+template <typename T>
+void swapRemove(std::vector<T>& column, std::size_t index) {
+  if (index + 1 != column.size()) column[index] = std::move(column.back());
+  column.pop_back();
+}
+
+}  // namespace
+
+EntityStore::EntityId EntityStore::spawn(std::uint32_t handle,
+                                         const std::string& name,
+                                         sf::Vector2f position, sf::Color color,
+                                         float radius) {
+  EntityId id;
+  if (!freeIds_.empty()) {
+    id = freeIds_.back();
+    freeIds_.pop_back();
+  } else {
+    id = static_cast<EntityId>(sparse_.size());
+    sparse_.push_back(kFreeSlot);
+  }
+  sparse_[id] = static_cast<std::uint32_t>(ids_.size());
+  if (handle >= byHandle_.size()) byHandle_.resize(handle + 1, kInvalidEntity);
+  byHandle_[handle] = id;
+
+  ids_.push_back(id);
+  positions_.push_back(position);
+  velocities_.push_back({0.f, 0.f});
+  serverPositions_.push_back(position);
+  history_.emplace_back();
+  history_.back().push(clock_, position);
+  acks_.push_back(0);
+  inInterest_.push_back(!hasInterest_ || interest_.contains(position));
+  grid_.insert(id, position);
+
+  handles_.push_back(handle);
+  if (pool_.empty()) {
+    names_.push_back(name);
+    render_.emplace_back();
+    debug_.emplace_back();
+  } else {
+    // Reuse a despawned entity's buffers; only the contents are reset.
+    Pooled& p = pool_.back();
+    names_.push_back(std::move(p.name));
+    names_.back().assign(name);
+    render_.push_back(std::move(p.render));
+    debug_.push_back(std::move(p.debug));
+    pool_.pop_back();
+
+    RenderData& r = render_.back();
+    r.label.vertices.clear();
+    r.debug.vertices.clear();
+    r.layoutBatch = nullptr;
+    r.labelDirty = r.debugDirty = true;
+    DebugState& d = debug_.back();
+    d.text.clear();
+    d.shown = {};
+    d.valid = false;
+    d.cooldown = 0.f;
+  }
+  render_.back().color = color;
+  render_.back().radius = radius;
+  return id;
+}
+
+void EntityStore::despawn(EntityId id) {
+  const std::size_t index = indexOf(id);
+  if (index == kNoIndex) return;
+
+  byHandle_[handles_[index]] = kInvalidEntity;
+  grid_.remove(id);
+  const EntityId moved = ids_.back();
+
+  Pooled& pooled = pool_.emplace_back();
+  pooled.name = std::move(names_[index]);
+  pooled.render = std::move(render_[index]);
+  pooled.debug = std::move(debug_[index]);
+
+  swapRemove(ids_, index);
+  swapRemove(positions_, index);
+  swapRemove(velocities_, index);
+  swapRemove(serverPositions_, index);
+  swapRemove(history_, index);
+  swapRemove(acks_, index);
+  swapRemove(inInterest_, index);
+  swapRemove(handles_, index);
+  swapRemove(names_, index);
+  swapRemove(render_, index);
+  swapRemove(debug_, index);
+
+  if (moved != id) sparse_[moved] = static_cast<std::uint32_t>(index);
+  sparse_[id] = kFreeSlot;
+  freeIds_.push_back(id);
+}
+
+void EntityStore::clear() {
+  while (!ids_.empty()) despawn(ids_.back());
+}
+
+void EntityStore::applyServerState(EntityId id, sf::Vector2f position,
+                                   unsigned int lastProcessedSequence) {
+  const std::size_t i = indexOf(id);
+  if (i == kNoIndex) return;
+  serverPositions_[i] = position;
+  acks_[i] = lastProcessedSequence;
+  InterpolationBuffer& h = history_[i];
+  h.push(clock_, position);
+  velocities_[i] = h.newest().velocity;
+}
+
+void EntityStore::update(sf::Time deltaTime) {
+  const float dt = deltaTime.asSeconds();
+  clock_ += dt;
+  const double renderTime = clock_ - interpolation_.delay;
+  classifyInterest();
+
+  const std::size_t n = ids_.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    positions_[i] = inInterest_[i] ? history_[i].sample(renderTime, interpolation_)
+                                   : history_[i].newest().position;
+    grid_.update(ids_[i], positions_[i]);
+  }
+
+  if (Player::isDebugTextEnabled(false)) {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (inInterest_[i]) refreshDebugText(i, dt);
+    }
+  }
+}
+
+void EntityStore::classifyInterest() {
+  if (!hasInterest_) {
+    std::fill(inInterest_.begin(), inInterest_.end(), 1);
+    return;
+  }
+  std::fill(inInterest_.begin(), inInterest_.end(), 0);
+  interestScratch_.clear();
+  grid_.query(interest_, interestScratch_);
+  for (const EntityId id : interestScratch_) {
+    const std::size_t i = indexOf(id);
+    if (interest_.contains(positions_[i])) inInterest_[i] = 1;
+  }
+}
+
+void EntityStore::refreshDebugText(std::size_t i, float dt) {
+  DebugState& d = debug_[i];
+  if (d.cooldown > 0.f) d.cooldown -= dt;
+  if (d.cooldown > 0.f) return;
+
+  Player::DebugValues values;
+  values.serverX = static_cast<int>(serverPositions_[i].x);
+  values.serverY = static_cast<int>(serverPositions_[i].y);
+  values.clientX = static_cast<int>(positions_[i].x);
+  values.clientY = static_cast<int>(positions_[i].y);
+  values.ack = acks_[i];
+  if (d.valid && values == d.shown) return;
+
+  Player::formatDebugText(values, d.text);
+  d.shown = values;
+  d.valid = true;
+  render_[i].debugDirty = true;
+  const float rate = Player::debugTextRate();
+  d.cooldown = rate > 0.f ? 1.f / rate : 0.f;
+}
+
+void EntityStore::appendBody(std::size_t index, std::vector<sf::Vertex>& out) const {
+  const sf::Vector2f c = positions_[index];
+  const float r = render_[index].radius;
+  const sf::Color color = render_[index].color;
+  const auto& unit = unitCircle();
+  for (std::size_t k = 0; k < kCirclePoints; ++k) {
+    const sf::Vector2f a = unit[k];
+    const sf::Vector2f b = unit[(k + 1) % kCirclePoints];
+    out.push_back(sf::Vertex{c, color});
+    out.push_back(sf::Vertex{{c.x + a.x * r, c.y + a.y * r}, color});
+    out.push_back(sf::Vertex{{c.x + b.x * r, c.y + b.y * r}, color});
+  }
+}
+
+void EntityStore::appendLabels(std::size_t index, TextBatch& batch) {
+  if (!batch.font()) return;
+  RenderData& rd = render_[index];
+  if (rd.layoutBatch != &batch) {
+    rd.layoutBatch = &batch;
+    rd.labelDirty = rd.debugDirty = true;
+  }
+
+  const sf::Vector2f p = positions_[index];
+  if (rd.labelDirty) {
+    batch.layout(names_[index], 12, sf::Color::White, rd.label);
+    rd.labelDirty = false;
+  }
+  batch.add(rd.label, {p.x, p.y - rd.radius - 10.f}, TextBatch::Anchor::Center);
+
+  if (!Player::isDebugTextEnabled(false) || debug_[index].text.empty()) return;
+  if (rd.debugDirty) {
+    batch.layout(debug_[index].text, 10, sf::Color::White, rd.debug);
+    rd.debugDirty = false;
+  }
+  batch.add(rd.debug, {p.x - rd.radius, p.y + rd.radius + 5.f});
+}
+
+void EntityStore::captureSnapshot(std::size_t index, ActorSnapshot& out) const {
+  out.position = positions_[index];
+  out.radius = render_[index].radius;
+  out.color = render_[index].color;
+  out.label.assign(names_[index]);
+  if (Player::isDebugTextEnabled(false)) {
+    out.debugText.assign(debug_[index].text);
+  } else {
+    out.debugText.clear();
+  }
+}
@@ -0,0 +1,166 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef WORLD_ENTITIES_ENTITYSTORE_H_
+#define WORLD_ENTITIES_ENTITYSTORE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "InterpolationBuffer.h"
+#include "Player.h"
+#include "SpatialHash.h"
+#include "../../graphics/RenderSnapshot.h"
+#include "../../graphics/TextBatch.h"
+
+// Remote entities (other players) stored as structure-of-arrays.
+//
+// Every per-entity attribute lives in its own contiguous column and all
+// columns share one dense index [0, size()). Per-frame work is a linear sweep
+// over the hot columns (positions, velocities, server state); render data and
+// debug text sit in separate cold columns.
+//
+// Rendered positions are interpolated from each entity's snapshot history
+// at (store clock - delay), see InterpolationBuffer.
+//
+// Entities are also kept in a SpatialHash. With an interest rectangle set
+// (the view plus a margin), entities outside it drop to a cheap update tier:
+// they hold their newest server position, skip interpolation and debug text,
+// and callers skip drawing them (inInterest()).
+//
+// Despawned entities leave their heap-backed state (name, label layouts,
+// debug text) in a pool that the next spawn reuses, so join/leave churn
+// doesn't allocate once the pool is warm.
+//
+// Entities are named by compact EntityIds that stay valid until despawn.
+// Despawning swaps the last entity into the freed slot, so dense indices are
+// not stable; use indexOf(id) after any despawn. Entities are found by their
+// interned network handle (see IdInterner) through a flat lookup table.
+class EntityStore {
+ public:
+  using EntityId = std::uint32_t;
+  static constexpr EntityId kInvalidEntity = UINT32_MAX;
+
+  // `handle` is the interned network id, `name` the text shown on the label.
+  EntityId spawn(std::uint32_t handle, const std::string& name,
+                 sf::Vector2f position, sf::Color color = sf::Color::Red,
+                 float radius = 15.f);
+  void despawn(EntityId id);
+  void clear();
+
+  EntityId find(std::uint32_t handle) const {
+    return handle < byHandle_.size() ? byHandle_[handle] : kInvalidEntity;
+  }
+  bool alive(EntityId id) const { return indexOf(id) != kNoIndex; }
+  std::size_t size() const { return ids_.size(); }
+  std::size_t pooled() const { return pool_.size(); }
+  bool empty() const { return ids_.empty(); }
+
+  static constexpr std::size_t kNoIndex = SIZE_MAX;
+  std::size_t indexOf(EntityId id) const {
+    return id < sparse_.size() && sparse_[id] != kFreeSlot ? sparse_[id] : kNoIndex;
+  }
+
+  // Authoritative state from a world_update, stamped with the store clock.
+  void applyServerState(EntityId id, sf::Vector2f position,
+                        unsigned int lastProcessedSequence);
+
+  // Per-frame sweep over all entities: advances the clock and resamples
+  // every entity's interpolated position.
+  void update(sf::Time deltaTime);
+
+  void setInterestRect(const sf::FloatRect& rect) {
+    interest_ = rect;
+    hasInterest_ = true;
+  }
+  void clearInterestRect() { hasInterest_ = false; }
+  bool inInterest(std::size_t index) const { return inInterest_[index] != 0; }
+  const SpatialHash& grid() const { return grid_; }
+
+  void setInterpolation(const InterpolationSettings& settings) { interpolation_ = settings; }
+  const InterpolationSettings& interpolation() const { return interpolation_; }
+  double clock() const { return clock_; }
+  const InterpolationBuffer& history(std::size_t index) const { return history_[index]; }
+
+  // Dense columns (read-only).
+  const std::vector<EntityId>& ids() const { return ids_; }
+  const std::vector<std::uint32_t>& handles() const { return handles_; }
+  const std::vector<std::string>& names() const { return names_; }
+  const std::vector<sf::Vector2f>& positions() const { return positions_; }
+  const std::vector<sf::Vector2f>& velocities() const { return velocities_; }
+  float radius(std::size_t index) const { return render_[index].radius; }
+  float sortY(std::size_t index) const {
+    return positions_[index].y + render_[index].radius;
+  }
+  const std::string& debugText(std::size_t index) const {
+    return debug_[index].text;
+  }
+
+  // Rendering, by dense index. appendBody emits the body as triangles.
+  void appendBody(std::size_t index, std::vector<sf::Vertex>& out) const;
+  void appendLabels(std::size_t index, TextBatch& batch);
+  void captureSnapshot(std::size_t index, ActorSnapshot& out) const;
+
+ private:
+  static constexpr std::uint32_t kFreeSlot = UINT32_MAX;
+
+  struct RenderData {
+    sf::Color color;
+    float radius = 15.f;
+    TextLayout label;
+    TextLayout debug;
+    const TextBatch* layoutBatch = nullptr;  // batch the layouts were built for
+    bool labelDirty = true;
+    bool debugDirty = true;
+  };
+  struct DebugState {
+    std::string text;
+    Player::DebugValues shown;
+    bool valid = false;
+    float cooldown = 0.f;
+  };
+
+  struct Pooled {
+    std::string name;
+    RenderData render;
+    DebugState debug;
+  };
+
+  void refreshDebugText(std::size_t index, float dt);
+  void classifyInterest();
+
+  // Id <-> dense index
+  std::vector<std::uint32_t> sparse_;  // EntityId -> dense index
+  std::vector<EntityId> freeIds_;
+  std::vector<EntityId> byHandle_;  // network handle -> EntityId
+
+  SpatialHash grid_;
+  sf::FloatRect interest_;
+  bool hasInterest_ = false;
+  std::vector<std::uint32_t> interestScratch_;
+
+  InterpolationSettings interpolation_;
+  double clock_ = 0.0;  // seconds, advanced by update()
+
+  // Hot columns
+  std::vector<EntityId> ids_;
+  std::vector<sf::Vector2f> positions_;
+  std::vector<sf::Vector2f> velocities_;
+  std::vector<sf::Vector2f> serverPositions_;
+  std::vector<InterpolationBuffer> history_;
+  std::vector<unsigned int> acks_;
+  std::vector<std::uint8_t> inInterest_;
+
+  // Cold columns
+  std::vector<std::uint32_t> handles_;
+  std::vector<std::string> names_;
+  std::vector<RenderData> render_;
+  std::vector<DebugState> debug_;
+
+  std::vector<Pooled> pool_;
+};
+
+#endif  // WORLD_ENTITIES_ENTITYSTORE_H_
@@ -0,0 +1,63 @@
+// Copyright 2025 WildSpark Authors
+
+#include "InterpolationBuffer.h"
+
+#include <algorithm>
+
+bool InterpolationBuffer::push(double time, sf::Vector2f position) {
+  if (count_ > 0 && time <= newest().time) {
+    if (time < newest().time) return false;
+    // Same timestamp (several packets in one frame): the latest one wins.
+    head_ = (head_ + kCapacity - 1) % kCapacity;
+    --count_;
+  }
+
+  Snapshot s;
+  s.time = time;
+  s.position = position;
+  if (count_ > 0) {
+    const Snapshot& prev = newest();
+    s.velocity = (position - prev.position) / static_cast<float>(time - prev.time);
+  }
+
+  ring_[head_] = s;
+  head_ = (head_ + 1) % kCapacity;
+  if (count_ < kCapacity) ++count_;
+  return true;
+}
+
+sf::Vector2f InterpolationBuffer::sample(double time,
+                                         const InterpolationSettings& settings) const {
+  if (count_ == 0) return {0.f, 0.f};
+
+  const Snapshot& last = newest();
+  if (time >= last.time) {
+    const double ahead = std::min(time - last.time, settings.maxExtrapolation);
+    return last.position + last.velocity * static_cast<float>(ahead);
+  }
+  const Snapshot& first = at(0);
+  if (time <= first.time) return first.position;
+
+  // Newest-first scan: the render time is almost always near the end.
+  std::size_t i = count_ - 1;
+  while (i > 0 && at(i - 1).time > time) --i;
+  const Snapshot& a = at(i - 1);
+  const Snapshot& b = at(i);
+
+  const double span = b.time - a.time;
+  const float t = static_cast<float>((time - a.time) / span);
+  if (settings.mode == InterpolationSettings::Mode::Linear || i < 2) {
+    // The first retained snapshot has no meaningful tangent.
+    return a.position + (b.position - a.position) * t;
+  }
+
+  // Cubic Hermite with the estimated velocities as tangents.
+  const float dt = static_cast<float>(span);
+  const float t2 = t * t, t3 = t2 * t;
+  const float h00 = 2.f * t3 - 3.f * t2 + 1.f;
+  const float h10 = t3 - 2.f * t2 + t;
+  const float h01 = -2.f * t3 + 3.f * t2;
+  const float h11 = t3 - t2;
+  return a.position * h00 + a.velocity * (h10 * dt) + b.position * h01 +
+         b.velocity * (h11 * dt);
+}
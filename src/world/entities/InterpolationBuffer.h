@@ -0,0 +1,56 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef WORLD_ENTITIES_INTERPOLATIONBUFFER_H_
+#define WORLD_ENTITIES_INTERPOLATIONBUFFER_H_
+
+#include <array>
+#include <cstddef>
+
+#include <SFML/System/Vector2.hpp>
+
+struct InterpolationSettings {
+  enum class Mode { Linear, Hermite };
+
+  double delay = 0.1;             // seconds behind the newest data to render at
+  Mode mode = Mode::Hermite;
+  double maxExtrapolation = 0.25;  // seconds past the newest snapshot
+};
+
+// Fixed-size ring of time-stamped position snapshots for one entity. Sampling
+// at (now - delay) lands between two received snapshots, hiding network
+// jitter; when packets are late the newest velocity is extrapolated for at
+// most maxExtrapolation seconds and then held.
+//
+// Storage is inline, so pushing and sampling never allocate.
+class InterpolationBuffer {
+ public:
+  static constexpr std::size_t kCapacity = 32;
+
+  struct Snapshot {
+    double time = 0.0;
+    sf::Vector2f position;
+    sf::Vector2f velocity;  // estimated from the previous snapshot
+  };
+
+  // Snapshots must arrive in time order. A snapshot with the newest time
+  // replaces it; older ones are dropped (returns false).
+  bool push(double time, sf::Vector2f position);
+  void clear() { count_ = 0; }
+
+  sf::Vector2f sample(double time, const InterpolationSettings& settings) const;
+
+  std::size_t size() const { return count_; }
+  bool empty() const { return count_ == 0; }
+  // i = 0 is the oldest retained snapshot.
+  const Snapshot& at(std::size_t i) const {
+    return ring_[(head_ + kCapacity - count_ + i) % kCapacity];
+  }
+  const Snapshot& newest() const { return at(count_ - 1); }
+
+ private:
+  std::array<Snapshot, kCapacity> ring_{};
+  std::size_t head_ = 0;  // next write position
+  std::size_t count_ = 0;
+};
+
+#endif  // WORLD_ENTITIES_INTERPOLATIONBUFFER_H_
@@ -0,0 +1,24 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef WORLD_ENTITIES_MOVEMENTMODEL_H_
+#define WORLD_ENTITIES_MOVEMENTMODEL_H_
+
+#include <SFML/System/Vector2.hpp>
+
+// One frame of player movement under the input with the given sequence
+// number. `velocity` is direction * speed, exactly as sent to the server.
+struct MoveInput {
+  unsigned int sequence = 0;
+  sf::Vector2f velocity;
+  float dt = 0.f;
+};
+
+// Movement rule shared by client prediction and server stand-ins. Keep it a
+// pure function of its arguments with a fixed operation order so the same
+// inputs give bit-identical positions on every caller.
+inline sf::Vector2f simulateMove(sf::Vector2f position, const MoveInput& input) {
+  return {position.x + input.velocity.x * input.dt,
+          position.y + input.velocity.y * input.dt};
+}
+
+#endif  // WORLD_ENTITIES_MOVEMENTMODEL_H_
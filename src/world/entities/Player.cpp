@@ -3,44 +3,37 @@
 #include "Player.h"
 
 #include <cmath>
+#include <cstdio>
 #include <iostream>
-#include <sstream>
 #include <string>
+#include <vector>
+
+#include "../../graphics/FontCache.h"
 
 const float DEFAULT_PLAYER_SPEED = 100.0f;
 
+namespace {
+bool g_localDebugText = true;
+bool g_remoteDebugText = true;
+float g_debugTextRate = 5.f;  // rebuilds per second
+}  // namespace
+
 Player::Player(const std::string& id, sf::Color color, bool isLocalPlayer)
     : m_id(id),
       m_position(0.f, 0.f),
-      m_serverAcknowledgedPosition(0.f, 0.f),
       m_targetDirection(0.f, 0.f),
       m_speed(DEFAULT_PLAYER_SPEED),
-      m_fontLoaded(false),
       m_currentSequenceNumber(0),
-      m_label(m_font, "", 12),
-      m_debugText(m_font, "", 10),
       m_isLocalPlayer(isLocalPlayer) {
   initVisuals();
   m_shape.setFillColor(color);
-  m_shape.setFillColor(color);
   m_shape.setPosition(m_position);
 
-  if (m_font.openFromFile("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf")) {
-    m_fontLoaded = true;
-  } else if (m_font.openFromFile("arial.ttf")) {
-    m_fontLoaded = true;
-  } else {
-    std::cerr << "Player [" << m_id
-              << "]: Failed to load font. Text will not be displayed."
-              << std::endl;
-  }
-
-  if (m_fontLoaded) {
-    m_label.setString(m_id);
-    m_debugText.setString("Debug Info");
+  // Loaded from disk once per process, not once per player.
+  m_font = FontCache::instance().defaultFont();
+  if (m_font) {
+    m_debugString = "Debug Info";
   }
-
-  updateTextVisuals();
 }
 
 void Player::initVisuals() {
@@ -48,35 +41,33 @@ void Player::initVisuals() {
   m_shape.setOrigin({m_shape.getRadius(), m_shape.getRadius()});
 }
 
-void Player::updateTextVisuals() {
-  if (m_fontLoaded) {
-    sf::FloatRect labelBounds = m_label.getLocalBounds();
-    m_label.setOrigin({labelBounds.position.x + labelBounds.size.x / 2.0f,
-                       labelBounds.position.y + labelBounds.size.y / 2.0f});
-    m_label.setPosition(
-        {m_position.x, m_position.y - m_shape.getRadius() - 10.f});
+void Player::setId(const std::string& id) {
+  m_id = id;
+  m_labelLayoutDirty = true;
+}
 
-    sf::FloatRect debugBounds = m_debugText.getLocalBounds();
-    m_debugText.setOrigin({debugBounds.position.x, debugBounds.position.y});
-    m_debugText.setPosition({m_position.x - m_shape.getRadius(),
-                             m_position.y + m_shape.getRadius() + 5.f});
-  }
+void Player::setDebugTextEnabled(bool localPlayers, bool enabled) {
+  (localPlayers ? g_localDebugText : g_remoteDebugText) = enabled;
 }
 
-void Player::setId(const std::string& id) {
-  m_id = id;
-  m_label.setString(m_id);
-  updateTextVisuals();
+bool Player::isDebugTextEnabled(bool localPlayers) {
+  return localPlayers ? g_localDebugText : g_remoteDebugText;
+}
+
+void Player::setDebugTextRate(float updatesPerSecond) {
+  g_debugTextRate = updatesPerSecond;
 }
 
-std::string Player::getId() const { return m_id; }
+float Player::debugTextRate() { return g_debugTextRate; }
+
+const std::string& Player::getId() const { return m_id; }
 
 sf::Vector2f Player::getDirection() const { return m_targetDirection; }
 
 void Player::setPosition(const sf::Vector2f& position) {
   m_position = position;
   m_shape.setPosition(m_position);
-  updateTextVisuals();
+  m_prediction.reset(position);
 }
 
 void Player::handleServerUpdate(const sf::Vector2f& serverPosition,
@@ -88,18 +79,6 @@ void Player::handleServerUpdate(const sf::Vector2f& serverPosition,
   if (!Player::m_isLocalPlayer) {
     setPosition(serverPosition);
   }
-
-  std::stringstream ss;
-  ss << "SrvPos: (" << static_cast<int>(serverPosition.x) << ","
-     << static_cast<int>(serverPosition.y) << ")\n"
-     << "CliPos: (" << static_cast<int>(m_position.x) << ","
-     << static_cast<int>(m_position.y) << ")\n"
-     << "Seq: " << m_currentSequenceNumber
-     << " Ack: " << m_lastProcessedSequenceNumber;
-
-  if (m_fontLoaded) {
-    m_debugText.setString(ss.str());
-  }
 }
 
 void Player::handleServerAck(unsigned int inputSequence, bool approved,
@@ -108,44 +87,120 @@ void Player::handleServerAck(unsigned int inputSequence, bool approved,
   m_serverVerifiedPosition = serverPosition;
   m_hasServerVerifiedPosition = true;
 
-  if (approved) {
+  if (!m_isLocalPlayer) {
     setPosition(serverPosition);
-    m_pendingMoves.clear();
-  } else {
-    setPosition(serverPosition);
-    m_pendingMoves.clear();
+    return;
   }
+  m_prediction.reconcile(inputSequence, approved, serverPosition);
+  m_position = m_prediction.displayed();
+  m_shape.setPosition(m_position);
+}
 
-  std::stringstream ss;
-  ss << "SrvPos: (" << static_cast<int>(m_serverVerifiedPosition.x) << ","
-     << static_cast<int>(m_serverVerifiedPosition.y) << ")\n"
-     << "CliPos: (" << static_cast<int>(m_position.x) << ","
-     << static_cast<int>(m_position.y) << ")\n"
-     << "Seq: " << m_currentSequenceNumber
-     << " Ack: " << m_lastProcessedSequenceNumber;
-
-  if (m_fontLoaded) {
-    m_debugText.setString(ss.str());
-  }
+void Player::setPredictionInput(unsigned int sequence, const sf::Vector2f& velocity) {
+  m_hasPredictionInput = true;
+  m_predictionSequence = sequence;
+  m_predictionVelocity = velocity;
 }
 
 void Player::update(sf::Time deltaTime) {
   if (Player::m_isLocalPlayer) {
-    if (m_targetDirection.x != 0.f || m_targetDirection.y != 0.f) {
-      sf::Vector2f moveDelta =
-          m_targetDirection * m_speed * deltaTime.asSeconds();
-      m_position += moveDelta;
+    MoveInput input;
+    if (m_hasPredictionInput) {
+      input.sequence = m_predictionSequence;
+      input.velocity = m_predictionVelocity;
+    } else {
+      input.sequence = m_currentSequenceNumber;  // last input sent
+      input.velocity = m_targetDirection * m_speed;
     }
+    input.dt = deltaTime.asSeconds();
+    m_prediction.step(input);
+    m_prediction.update(input.dt);
+    m_position = m_prediction.displayed();
   }
   m_shape.setPosition(m_position);
-  updateTextVisuals();
+  refreshDebugText(deltaTime);
 }
 
-void Player::render(sf::RenderTarget& target) {
-  target.draw(m_shape);
-  if (m_fontLoaded) {
-    target.draw(m_label);
-    target.draw(m_debugText);
+void Player::refreshDebugText(sf::Time deltaTime) {
+  if (m_debugCooldown > 0.f) m_debugCooldown -= deltaTime.asSeconds();
+  if (!m_hasServerVerifiedPosition || !isDebugTextEnabled(m_isLocalPlayer) ||
+      m_debugCooldown > 0.f) {
+    return;
+  }
+
+  DebugValues values;
+  values.serverX = static_cast<int>(m_serverVerifiedPosition.x);
+  values.serverY = static_cast<int>(m_serverVerifiedPosition.y);
+  values.clientX = static_cast<int>(m_position.x);
+  values.clientY = static_cast<int>(m_position.y);
+  values.sequence = m_currentSequenceNumber;
+  values.ack = m_lastProcessedSequenceNumber;
+  if (m_debugShownValid && values == m_debugShown) return;
+
+  formatDebugText(values, m_debugString);
+  m_debugShown = values;
+  m_debugShownValid = true;
+  m_debugLayoutDirty = true;
+  ++m_debugRebuilds;
+  m_debugCooldown = g_debugTextRate > 0.f ? 1.f / g_debugTextRate : 0.f;
+}
+
+void Player::formatDebugText(const DebugValues& values, std::string& out) {
+  char buffer[96];
+  std::snprintf(buffer, sizeof(buffer), "SrvPos: (%d,%d)\nCliPos: (%d,%d)\nSeq: %u Ack: %u",
+                values.serverX, values.serverY, values.clientX, values.clientY,
+                values.sequence, values.ack);
+  out.assign(buffer);
+}
+
+void Player::appendBody(std::vector<sf::Vertex>& out) const {
+  const sf::Transform& transform = m_shape.getTransform();
+  const sf::Color color = m_shape.getFillColor();
+  const std::size_t points = m_shape.getPointCount();
+  for (std::size_t k = 0; k < points; ++k) {
+    out.push_back(sf::Vertex{m_position, color});
+    out.push_back(sf::Vertex{transform.transformPoint(m_shape.getPoint(k)), color});
+    out.push_back(
+        sf::Vertex{transform.transformPoint(m_shape.getPoint((k + 1) % points)), color});
+  }
+}
+
+void Player::appendLabels(TextBatch& batch) const {
+  if (!m_font) return;
+  if (m_layoutBatch != &batch) {
+    m_layoutBatch = &batch;
+    m_labelLayoutDirty = m_debugLayoutDirty = true;
+  }
+
+  const float r = m_shape.getRadius();
+  if (m_labelLayoutDirty) {
+    batch.layout(m_id, 12, sf::Color::White, m_labelLayout);
+    m_labelLayoutDirty = false;
+  }
+  batch.add(m_labelLayout, {m_position.x, m_position.y - r - 10.f}, TextBatch::Anchor::Center);
+
+  if (!isDebugTextEnabled(m_isLocalPlayer)) return;
+  if (m_debugLayoutDirty) {
+    batch.layout(m_debugString, 10, sf::Color::White, m_debugLayout);
+    m_debugLayoutDirty = false;
+  }
+  batch.add(m_debugLayout, {m_position.x - r, m_position.y + r + 5.f});
+}
+
+void Player::captureSnapshot(ActorSnapshot& out) const {
+  out.position = m_position;
+  out.radius = m_shape.getRadius();
+  out.color = m_shape.getFillColor();
+  if (m_font) {
+    out.label.assign(m_id);
+    if (isDebugTextEnabled(m_isLocalPlayer)) {
+      out.debugText.assign(m_debugString);
+    } else {
+      out.debugText.clear();
+    }
+  } else {
+    out.label.clear();
+    out.debugText.clear();
   }
 }
 
@@ -3,12 +3,15 @@
 #ifndef WORLD_ENTITIES_PLAYER_H_
 #define WORLD_ENTITIES_PLAYER_H_
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 #include <SFML/Graphics.hpp>
-#include <SFML/Graphics/Font.hpp>
-#include <SFML/Graphics/Text.hpp>
+
+#include "ClientPrediction.h"
+#include "../../graphics/RenderSnapshot.h"
+#include "../../graphics/TextBatch.h"
 
 class Player {
  public:
@@ -16,7 +19,7 @@ class Player {
                   sf::Color color = sf::Color::Green,
                   bool isLocalPlayer = false);
   void setId(const std::string& id);
-  std::string getId() const;
+  const std::string& getId() const;
   void setDirection(const sf::Vector2f& direction);
   sf::Vector2f getDirection() const;
   float getSpeed() const { return m_speed; }
@@ -25,37 +28,88 @@ class Player {
                    const sf::View& view);
   void handleServerUpdate(const sf::Vector2f& serverPosition,
                           unsigned int lastProcessedSequenceNumber);
+  // Local players reconcile their prediction against the acked position;
+  // see ClientPrediction.
   void handleServerAck(unsigned int inputSequence, bool approved,
                        const sf::Vector2f& serverPosition);
+  void setPredictionSettings(const PredictionSettings& settings) {
+    m_prediction.setSettings(settings);
+  }
+  const ClientPrediction& prediction() const { return m_prediction; }
+  // By default the prediction runs on the live direction under the last
+  // sequence handed out. Scenes that batch input (see InputScheduler) pass
+  // the input they actually committed instead, since the server only sees
+  // a direction change on the next network tick.
+  void setPredictionInput(unsigned int sequence, const sf::Vector2f& velocity);
   void update(sf::Time deltaTime);
-  void render(sf::RenderTarget& target);
+  // Appends the body as triangles, so it can go through any RenderSink; name
+  // and debug labels go through appendLabels so all labels on screen share
+  // one draw call.
+  void appendBody(std::vector<sf::Vertex>& out) const;
+  void appendLabels(TextBatch& batch) const;
+  // Fill a render-thread snapshot with what appendBody() would draw.
+  void captureSnapshot(ActorSnapshot& out) const;
   void setPosition(const sf::Vector2f& position);
   sf::Vector2f getPosition() const { return m_position; }
+  // World Y of the feet (bottom of the circle), used for depth sorting.
+  float getSortY() const { return m_position.y + m_shape.getRadius(); }
   unsigned int getNextSequenceNumber();
+  bool isLocalPlayer() const { return m_isLocalPlayer; }
+
+  // Debug overlay (server/client position, sequence numbers). Switchable per
+  // player class (local vs remote) at runtime. The text is rebuilt in
+  // update() only when one of the shown integers changes, and at most
+  // debugTextRate() times per second.
+  static void setDebugTextEnabled(bool localPlayers, bool enabled);
+  static bool isDebugTextEnabled(bool localPlayers);
+  static void setDebugTextRate(float updatesPerSecond);
+  static float debugTextRate();
+  const std::string& getDebugText() const { return m_debugString; }
+  std::uint32_t debugTextRebuilds() const { return m_debugRebuilds; }
+
+  // Integers shown by the debug overlay; text is only rebuilt when they change.
+  struct DebugValues {
+    int serverX = 0, serverY = 0, clientX = 0, clientY = 0;
+    unsigned int sequence = 0, ack = 0;
+    bool operator==(const DebugValues&) const = default;
+  };
+  static void formatDebugText(const DebugValues& values, std::string& out);
 
  private:
   std::string m_id;
-  sf::Vector2f m_position;
-  sf::Vector2f m_serverAcknowledgedPosition;
+  sf::Vector2f m_position;  // displayed position
   sf::Vector2f m_targetDirection;  // Intended direction from input
   float m_speed;
 
   sf::CircleShape m_shape;
-  sf::Font m_font;  // Font for label and debug text
-  sf::Text m_label;
-  sf::Text m_debugText;       // For displaying debug info
-  bool m_fontLoaded = false;  // Re-added to track if m_font loaded successfully
+  const sf::Font* m_font = nullptr;  // Shared via FontCache; null = no text
+  std::string m_debugString;         // Debug info shown below the player
+
+  DebugValues m_debugShown;  // integers currently shown in m_debugString
+  bool m_debugShownValid = false;
+  float m_debugCooldown = 0.f;  // seconds until the next rebuild is allowed
+  std::uint32_t m_debugRebuilds = 0;
+
+  // Label geometry laid out once per string change and then only translated.
+  mutable TextLayout m_labelLayout;
+  mutable TextLayout m_debugLayout;
+  mutable const TextBatch* m_layoutBatch = nullptr;  // batch the layouts are for
+  mutable bool m_labelLayoutDirty = true;
+  mutable bool m_debugLayoutDirty = true;
 
   unsigned int m_currentSequenceNumber = 0;        // Added
   unsigned int m_lastProcessedSequenceNumber = 0;  // Added for server ACK
-  std::vector<sf::Vector2f> m_pendingMoves;        // For client-side prediction
+  ClientPrediction m_prediction;                   // local player only
+  bool m_hasPredictionInput = false;  // set by setPredictionInput
+  unsigned int m_predictionSequence = 0;
+  sf::Vector2f m_predictionVelocity;
   sf::Vector2f m_serverVerifiedPosition;  // Position confirmed by the server
   bool m_hasServerVerifiedPosition = false;
   bool m_isLocalPlayer;
 
   // Debugging text
   void initVisuals();
-  void updateTextVisuals();  // Added private helper declaration
+  void refreshDebugText(sf::Time deltaTime);
 };
 
 #endif  // WORLD_ENTITIES_PLAYER_H_
@@ -0,0 +1,91 @@
+// Copyright 2025 WildSpark Authors
+
+#include "PlayerLayer.h"
+
+#include <string>
+#include <vector>
+
+void PlayerLayer::setLocalPlayer(const Player* player) {
+  std::erase_if(depthActors_,
+                [](const WorldRenderer::DepthActor& a) { return a.id == kLocalActor; });
+  localPlayer_ = player;
+  if (player) depthActors_.push_back({0.f, kLocalActor});
+}
+
+bool PlayerLayer::applyServerState(std::uint32_t handle, const std::string& name,
+                                   sf::Vector2f position,
+                                   unsigned int lastProcessedSequence) {
+  EntityStore::EntityId entity = remotePlayers_.find(handle);
+  const bool spawned = entity == EntityStore::kInvalidEntity;
+  if (spawned) {
+    entity = remotePlayers_.spawn(handle, name, position, sf::Color::Red);
+    // Appended unsorted; the next insertion sort moves it into place.
+    depthActors_.push_back({0.f, entity});
+  }
+  remotePlayers_.applyServerState(entity, position, lastProcessedSequence);
+  return spawned;
+}
+
+bool PlayerLayer::despawn(std::uint32_t handle) {
+  const EntityStore::EntityId entity = remotePlayers_.find(handle);
+  if (entity == EntityStore::kInvalidEntity) return false;
+  std::erase_if(depthActors_,
+                [entity](const WorldRenderer::DepthActor& a) { return a.id == entity; });
+  remotePlayers_.despawn(entity);
+  return true;
+}
+
+sf::FloatRect PlayerLayer::update(sf::Time dt, const sf::View& view) {
+  const sf::Vector2f margin(kInterestMargin, kInterestMargin);
+  const sf::FloatRect interest(view.getCenter() - view.getSize() / 2.f - margin,
+                               view.getSize() + margin * 2.f);
+  remotePlayers_.setInterestRect(interest);
+  remotePlayers_.update(dt);
+  return interest;
+}
+
+void PlayerLayer::sortActors() {
+  for (auto& actor : depthActors_) {
+    actor.sortY = actor.id == kLocalActor
+                      ? localPlayer_->getSortY()
+                      : remotePlayers_.sortY(remotePlayers_.indexOf(actor.id));
+  }
+  WorldRenderer::sortDepthActors(depthActors_);
+}
+
+void PlayerLayer::render(const WorldRenderer& renderer, RenderSink& sink,
+                         TextBatch& labels) {
+  sortActors();
+  drawn_ = 0;
+  renderer.renderDepthSorted(sink, depthActors_, [&](std::uint32_t id, RenderSink& s) {
+    bodyVertices_.clear();
+    if (id == kLocalActor) {
+      localPlayer_->appendBody(bodyVertices_);
+      localPlayer_->appendLabels(labels);
+    } else {
+      const std::size_t index = remotePlayers_.indexOf(id);
+      if (!remotePlayers_.inInterest(index)) return;
+      remotePlayers_.appendBody(index, bodyVertices_);
+      remotePlayers_.appendLabels(index, labels);
+    }
+    s.draw(bodyVertices_.data(), bodyVertices_.size(), sf::PrimitiveType::Triangles,
+           sf::RenderStates::Default);
+    ++drawn_;
+  });
+}
+
+void PlayerLayer::captureSnapshot(const WorldRenderer& renderer, RenderSnapshot& snapshot) {
+  sortActors();
+  drawn_ = 0;
+  renderer.renderDepthSorted(snapshot.depth, depthActors_, [&](std::uint32_t id, RenderSink&) {
+    const std::size_t index = id == kLocalActor ? 0 : remotePlayers_.indexOf(id);
+    if (id != kLocalActor && !remotePlayers_.inInterest(index)) return;
+    snapshot.depth.addActorMarker(static_cast<std::uint32_t>(snapshot.actorCount));
+    if (id == kLocalActor) {
+      localPlayer_->captureSnapshot(snapshot.addActor());
+    } else {
+      remotePlayers_.captureSnapshot(index, snapshot.addActor());
+    }
+    ++drawn_;
+  });
+}
@@ -0,0 +1,69 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef WORLD_ENTITIES_PLAYERLAYER_H_
+#define WORLD_ENTITIES_PLAYERLAYER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "EntityStore.h"
+#include "Player.h"
+#include "../WorldRenderer.h"
+#include "../../graphics/RenderCommandList.h"
+#include "../../graphics/RenderSnapshot.h"
+#include "../../graphics/TextBatch.h"
+
+// The players of the depth-sorted pass: remote players kept from server
+// state in an EntityStore, plus the optional local Player.
+//
+// This is GameScene's per-frame player update and draw; bench_crowd runs
+// the same code, so what it measures is what the game does.
+class PlayerLayer {
+ public:
+  // Remote players outside the view plus this margin are neither drawn nor
+  // interpolated.
+  static constexpr float kInterestMargin = 128.f;
+
+  // Adds the local player to the depth pass, or removes it with nullptr.
+  void setLocalPlayer(const Player* player);
+
+  // Server state for a remote player; the first one spawns it. True when
+  // this call spawned the player.
+  bool applyServerState(std::uint32_t handle, const std::string& name,
+                        sf::Vector2f position, unsigned int lastProcessedSequence);
+  // False when the player was not spawned.
+  bool despawn(std::uint32_t handle);
+
+  // Per-frame update: moves the interest rect to the view and interpolates
+  // remote players. Returns the interest rect.
+  sf::FloatRect update(sf::Time dt, const sf::View& view);
+
+  // Draws bodies through the depth-sorted pass and adds name plates and
+  // debug labels to `labels`.
+  void render(const WorldRenderer& renderer, RenderSink& sink, TextBatch& labels);
+  // Same pass, recorded for the render thread as actor markers.
+  void captureSnapshot(const WorldRenderer& renderer, RenderSnapshot& snapshot);
+
+  const EntityStore& remotePlayers() const { return remotePlayers_; }
+  // Players drawn by the last render(), local player included.
+  std::size_t drawn() const { return drawn_; }
+
+ private:
+  static constexpr std::uint32_t kLocalActor = EntityStore::kInvalidEntity;
+
+  void sortActors();
+
+  const Player* localPlayer_ = nullptr;
+  EntityStore remotePlayers_;
+  // Remote EntityIds plus kLocalActor. The list stays sorted between frames
+  // so re-sorting is nearly free.
+  std::vector<WorldRenderer::DepthActor> depthActors_;
+  std::vector<sf::Vertex> bodyVertices_;  // scratch for one body
+  std::size_t drawn_ = 0;
+};
+
+#endif  // WORLD_ENTITIES_PLAYERLAYER_H_
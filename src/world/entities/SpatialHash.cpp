@@ -0,0 +1,65 @@
+// Copyright 2025 WildSpark Authors
+
+#include "SpatialHash.h"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialHash::CellKey SpatialHash::keyFor(sf::Vector2f position) const {
+  return key(static_cast<std::int32_t>(std::floor(position.x / cellSize_)),
+             static_cast<std::int32_t>(std::floor(position.y / cellSize_)));
+}
+
+void SpatialHash::insert(std::uint32_t id, sf::Vector2f position) {
+  if (id >= cellOf_.size()) cellOf_.resize(id + 1, kNoCell);
+  if (cellOf_[id] != kNoCell) {
+    update(id, position);
+    return;
+  }
+  const CellKey k = keyFor(position);
+  cells_[k].push_back(id);
+  cellOf_[id] = k;
+  ++count_;
+}
+
+void SpatialHash::update(std::uint32_t id, sf::Vector2f position) {
+  if (id >= cellOf_.size() || cellOf_[id] == kNoCell) return;
+  const CellKey k = keyFor(position);
+  if (k == cellOf_[id]) return;
+  remove(id);
+  insert(id, position);
+}
+
+void SpatialHash::remove(std::uint32_t id) {
+  if (id >= cellOf_.size() || cellOf_[id] == kNoCell) return;
+  auto it = cells_.find(cellOf_[id]);
+  auto& bucket = it->second;
+  auto pos = std::find(bucket.begin(), bucket.end(), id);
+  *pos = bucket.back();
+  bucket.pop_back();
+  // Empty buckets are kept; entities tend to come back to the same cells.
+  cellOf_[id] = kNoCell;
+  --count_;
+}
+
+void SpatialHash::clear() {
+  cells_.clear();
+  cellOf_.clear();
+  count_ = 0;
+}
+
+void SpatialHash::query(const sf::FloatRect& rect,
+                        std::vector<std::uint32_t>& out) const {
+  const auto x0 = static_cast<std::int32_t>(std::floor(rect.position.x / cellSize_));
+  const auto y0 = static_cast<std::int32_t>(std::floor(rect.position.y / cellSize_));
+  const auto x1 = static_cast<std::int32_t>(
+      std::floor((rect.position.x + rect.size.x) / cellSize_));
+  const auto y1 = static_cast<std::int32_t>(
+      std::floor((rect.position.y + rect.size.y) / cellSize_));
+  for (std::int32_t cy = y0; cy <= y1; ++cy) {
+    for (std::int32_t cx = x0; cx <= x1; ++cx) {
+      auto it = cells_.find(key(cx, cy));
+      if (it != cells_.end()) out.insert(out.end(), it->second.begin(), it->second.end());
+    }
+  }
+}
@@ -0,0 +1,50 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef WORLD_ENTITIES_SPATIALHASH_H_
+#define WORLD_ENTITIES_SPATIALHASH_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+// Uniform grid of entity ids keyed by cell, for "who is near this
+// rectangle" queries. Ids are small dense integers (EntityStore ids);
+// each id remembers its cell so a move only touches buckets when it
+// actually crosses a cell border.
+class SpatialHash {
+ public:
+  explicit SpatialHash(float cellSize = 256.f) : cellSize_(cellSize) {}
+
+  void insert(std::uint32_t id, sf::Vector2f position);
+  // Re-files an inserted id under its new position; unknown ids are ignored.
+  void update(std::uint32_t id, sf::Vector2f position);
+  void remove(std::uint32_t id);
+  void clear();
+
+  // Appends every id in a cell overlapping `rect`. Candidates only: ids
+  // near the rect border may lie just outside it.
+  void query(const sf::FloatRect& rect, std::vector<std::uint32_t>& out) const;
+
+  float cellSize() const { return cellSize_; }
+  std::size_t size() const { return count_; }
+
+ private:
+  using CellKey = std::uint64_t;
+  static constexpr CellKey kNoCell = UINT64_MAX;
+
+  CellKey keyFor(sf::Vector2f position) const;
+  static CellKey key(std::int32_t cx, std::int32_t cy) {
+    return (static_cast<CellKey>(static_cast<std::uint32_t>(cx)) << 32) |
+           static_cast<std::uint32_t>(cy);
+  }
+
+  float cellSize_;
+  std::unordered_map<CellKey, std::vector<std::uint32_t>> cells_;
+  std::vector<CellKey> cellOf_;  // id -> cell, kNoCell if absent
+  std::size_t count_ = 0;
+};
+
+#endif  // WORLD_ENTITIES_SPATIALHASH_H_
@@ -0,0 +1,65 @@
+// Copyright 2025 WildSpark Authors
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::size_t> g_allocations{0};
+std::atomic<std::size_t> g_liveBytes{0};
+
+// Each block is prefixed with its size, padded to keep the default
+// new alignment.
+constexpr std::size_t kHeader = alignof(std::max_align_t);
+
+void* allocate(std::size_t size) noexcept {
+  auto* block = static_cast<unsigned char*>(std::malloc(size + kHeader));
+  if (!block) return nullptr;
+  *reinterpret_cast<std::size_t*>(block) = size;
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_liveBytes.fetch_add(size, std::memory_order_relaxed);
+  return block + kHeader;
+}
+
+void release(void* ptr) noexcept {
+  if (!ptr) return;
+  auto* block = static_cast<unsigned char*>(ptr) - kHeader;
+  g_liveBytes.fetch_sub(*reinterpret_cast<std::size_t*>(block),
+                        std::memory_order_relaxed);
+  std::free(block);
+}
+
+void* allocateOrThrow(std::size_t size) {
+  void* p = allocate(size);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+}  // namespace
+
+namespace AllocationCounter {
+
+Snapshot snapshot() {
+  return {g_allocations.load(std::memory_order_relaxed),
+          g_liveBytes.load(std::memory_order_relaxed)};
+}
+
+}  // namespace AllocationCounter
+
+void* operator new(std::size_t size) { return allocateOrThrow(size); }
+void* operator new[](std::size_t size) { return allocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+void operator delete(void* ptr) noexcept { release(ptr); }
+void operator delete[](void* ptr) noexcept { release(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { release(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { release(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { release(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { release(ptr); }
@@ -0,0 +1,26 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef TESTS_SUPPORT_ALLOCATIONCOUNTER_H_
+#define TESTS_SUPPORT_ALLOCATIONCOUNTER_H_
+
+#include <cstddef>
+
+// Counts heap traffic through the global operator new/delete, which
+// AllocationCounter.cpp replaces for the whole test binary. Use deltas
+// around the code under test:
+//
+//   const auto before = AllocationCounter::snapshot();
+//   ...
+//   EXPECT_EQ(AllocationCounter::snapshot().allocations - before.allocations, 0u);
+namespace AllocationCounter {
+
+struct Snapshot {
+  std::size_t allocations = 0;  // operator new calls so far
+  std::size_t liveBytes = 0;    // bytes currently allocated
+};
+
+Snapshot snapshot();
+
+}  // namespace AllocationCounter
+
+#endif  // TESTS_SUPPORT_ALLOCATIONCOUNTER_H_
@@ -0,0 +1,475 @@
+// Copyright 2025 WildSpark Authors
+
+#include "support/LocalMatchServer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+#include "networking/MessageRegistry.h"
+#include "world/entities/MovementModel.h"
+
+namespace {
+
+// Parses a JSON message, or returns a discarded value.
+nlohmann::json parseJson(std::string_view bytes) {
+  return nlohmann::json::parse(bytes.begin(), bytes.end(), nullptr, false);
+}
+
+float number(const nlohmann::json& object, const char* key) {
+  const auto it = object.find(key);
+  return it != object.end() && it->is_number() ? it->get<float>() : 0.f;
+}
+
+std::uint32_t sequence(const nlohmann::json& object, const char* key) {
+  const auto it = object.find(key);
+  return it != object.end() && it->is_number_unsigned() ? it->get<std::uint32_t>() : 0;
+}
+
+Nakama::NRtError matchError(const std::string& message) {
+  Nakama::NRtError error;
+  error.code = Nakama::RtErrorCode::MATCH_NOT_FOUND;
+  error.message = message;
+  return error;
+}
+
+}  // namespace
+
+// ---- LocalRtClient ----
+
+LocalRtClient::~LocalRtClient() { server_.leave(this); }
+
+void LocalRtClient::tick() {
+  {
+    std::lock_guard<std::mutex> lock(inboxMutex_);
+    running_.swap(inbox_);
+  }
+  // Outside the lock: listeners send, and sends may post back to us.
+  while (!running_.empty()) {
+    const std::function<void()> event = std::move(running_.front());
+    running_.pop_front();
+    event();
+  }
+}
+
+void LocalRtClient::connect(Nakama::NSessionPtr session, bool /*createStatus*/,
+                            Nakama::NRtClientProtocol /*protocol*/) {
+  if (connected_ || connecting_) return;
+  userId_ = session ? session->getUserId() : std::string();
+  connecting_ = true;
+  post([this] {
+    connecting_ = false;
+    connected_ = true;
+    if (listener_) listener_->onConnect();
+  });
+}
+
+bool LocalRtClient::isConnecting() const { return connecting_; }
+
+bool LocalRtClient::isConnected() const { return connected_; }
+
+void LocalRtClient::disconnect() {
+  server_.leave(this);
+  const bool wasConnected = connected_.exchange(false);
+  connecting_ = false;
+  if (!wasConnected) return;
+  post([this] {
+    if (listener_) listener_->onDisconnect(Nakama::NRtClientDisconnectInfo{});
+  });
+}
+
+void LocalRtClient::joinMatch(const std::string& matchId, const Nakama::NStringMap& metadata,
+                              std::function<void(const Nakama::NMatch&)> successCallback,
+                              Nakama::RtErrorCallback errorCallback) {
+  if (!connected_ || matchId != server_.matchId()) {
+    const std::string reason = connected_ ? "No match " + matchId : "Not connected";
+    post([errorCallback, reason] {
+      if (errorCallback) errorCallback(matchError(reason));
+    });
+    return;
+  }
+  server_.join(this, metadata, std::move(successCallback));
+}
+
+void LocalRtClient::leaveMatch(const std::string& /*matchId*/,
+                               std::function<void()> successCallback,
+                               Nakama::RtErrorCallback /*errorCallback*/) {
+  server_.leave(this);
+  post([successCallback] {
+    if (successCallback) successCallback();
+  });
+}
+
+void LocalRtClient::sendMatchData(const std::string& matchId, int64_t opCode,
+                                  const Nakama::NBytes& data,
+                                  const std::vector<Nakama::NUserPresence>& /*presences*/) {
+  if (connected_ && matchId == server_.matchId()) server_.receive(this, opCode, data);
+}
+
+void LocalRtClient::post(std::function<void()> event) {
+  std::lock_guard<std::mutex> lock(inboxMutex_);
+  inbox_.push_back(std::move(event));
+}
+
+void LocalRtClient::deliver(std::int64_t opCode, const std::string& bytes) {
+  Nakama::NMatchData data;
+  data.matchId = server_.matchId();
+  data.opCode = opCode;
+  data.data = bytes;
+  data.reliable = true;
+  post([this, data = std::move(data)] {
+    if (listener_) listener_->onMatchData(data);
+  });
+}
+
+void LocalRtClient::deliverPresence(Nakama::NMatchPresenceEvent event) {
+  post([this, event = std::move(event)] {
+    if (listener_) listener_->onMatchPresence(event);
+  });
+}
+
+// ---- LocalMatchServer ----
+
+LocalMatchServer::LocalMatchServer() : LocalMatchServer(Settings{}) {}
+
+LocalMatchServer::LocalMatchServer(const Settings& settings) : settings_(settings) {
+  settings_.tickRate = std::max(settings_.tickRate, 1);
+}
+
+std::shared_ptr<LocalRtClient> LocalMatchServer::createClient() {
+  return std::make_shared<LocalRtClient>(*this);
+}
+
+void LocalMatchServer::advance(double seconds) {
+  const double tick = 1.0 / settings_.tickRate;
+  std::uint64_t ticks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const double pending = carry_ + std::max(seconds, 0.0);
+    ticks = static_cast<std::uint64_t>(std::floor(pending / tick + 1e-9));
+    carry_ = std::max(0.0, pending - static_cast<double>(ticks) * tick);
+  }
+  for (std::uint64_t i = 0; i < ticks; ++i) step();
+}
+
+void LocalMatchServer::step() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Acks first: inputs received since the last tick were applied at the
+  // position the player has now, before this tick's movement.
+  for (auto& member : members_) {
+    if (member->player.ackPending) sendAck(*member);
+  }
+
+  const float dt = 1.f / static_cast<float>(settings_.tickRate);
+  worldState_.clear();
+  for (auto& member : members_) {
+    Player& player = member->player;
+    player.position = simulateMove(player.position, {player.lastSequence, player.velocity, dt});
+    worldState_.push_back({player.netId, player.userId, player.position, player.lastSequence});
+  }
+  for (auto& member : members_) sendWorld(*member);
+
+  ++ticks_;
+  ++stats_.ticks;
+}
+
+double LocalMatchServer::time() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<double>(ticks_) / settings_.tickRate;
+}
+
+std::size_t LocalMatchServer::playerCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return members_.size();
+}
+
+bool LocalMatchServer::findPlayer(std::string_view userId, Player& out) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& member : members_) {
+    if (member->player.userId == userId) {
+      out = member->player;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LocalMatchServer::objectVisible(std::uint32_t objectId) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = objects_.find(objectId);
+  return it == objects_.end() || it->second;
+}
+
+LocalMatchServer::Stats LocalMatchServer::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void LocalMatchServer::join(LocalRtClient* client, const Nakama::NStringMap& metadata,
+                            std::function<void(const Nakama::NMatch&)> onJoined) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Member* member = findMember(client);
+  const bool rejoin = member != nullptr;
+  if (!rejoin) {
+    auto added = std::make_unique<Member>();
+    added->client = client;
+    added->player.userId = client->userId();
+    added->player.netId = nextNetId_++;
+    added->player.position = settings_.spawn;
+    const auto offered = metadata.find("wire_protocol");
+    added->binary = settings_.binary && offered != metadata.end() &&
+                    offered->second == std::to_string(wire::kVersion);
+    const auto snapshots = metadata.find("world_snapshot");
+    added->snapshots = added->binary && settings_.snapshots && snapshots != metadata.end() &&
+                       snapshots->second == "1";
+    member = added.get();
+    members_.push_back(std::move(added));
+  }
+
+  Nakama::NMatch match;
+  match.matchId = matchId_;
+  match.authoritative = true;
+  match.size = static_cast<int32_t>(members_.size());
+  match.self = presenceOf(*member);
+  Nakama::NMatchPresenceEvent others;
+  others.matchId = matchId_;
+  for (const auto& m : members_) {
+    if (m.get() == member) continue;
+    match.presences.push_back(presenceOf(*m));
+    others.joins.push_back(presenceOf(*m));
+  }
+  client->post([onJoined = std::move(onJoined), match] {
+    if (onJoined) onJoined(match);
+  });
+  if (rejoin) return;
+
+  // As Nakama does: the joiner hears of everyone present, everyone else of
+  // the joiner.
+  if (!others.joins.empty()) client->deliverPresence(std::move(others));
+  Nakama::NMatchPresenceEvent joined;
+  joined.matchId = matchId_;
+  joined.joins.push_back(presenceOf(*member));
+  for (const auto& m : members_) {
+    if (m.get() != member) m->client->deliverPresence(joined);
+  }
+}
+
+void LocalMatchServer::leave(LocalRtClient* client) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = std::find_if(members_.begin(), members_.end(),
+                               [client](const auto& m) { return m->client == client; });
+  if (it == members_.end()) return;
+  Nakama::NMatchPresenceEvent left;
+  left.matchId = matchId_;
+  left.leaves.push_back(presenceOf(**it));
+  members_.erase(it);
+  for (const auto& m : members_) m->client->deliverPresence(left);
+}
+
+void LocalMatchServer::receive(LocalRtClient* client, std::int64_t opCode,
+                               const std::string& bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Member* member = findMember(client);
+  if (!member) return;  // not in the match
+  ++stats_.messagesIn;
+  stats_.bytesIn += bytes.size();
+
+  switch (opCode) {
+    case opcode::kPlayerInput:
+      applyInputs(*member, bytes);
+      break;
+    case opcode::kObjectUpdate:
+      applyAction(bytes);
+      break;
+    case opcode::kPing:
+      answerPing(*member, bytes);
+      break;
+    case opcode::kInterest:
+      applyInterest(*member, bytes);
+      break;
+    case opcode::kSnapshotAck: {
+      wire::SnapshotAck ack;
+      if (wire::decode(bytes, ack)) {
+        member->snapshotServer.acknowledge(ack.snapshotId);
+      } else {
+        ++stats_.malformed;
+      }
+      break;
+    }
+    default:
+      ++stats_.malformed;
+      break;
+  }
+}
+
+LocalMatchServer::Member* LocalMatchServer::findMember(const LocalRtClient* client) {
+  for (auto& member : members_) {
+    if (member->client == client) return member.get();
+  }
+  return nullptr;
+}
+
+void LocalMatchServer::applyInputs(Member& member, std::string_view bytes) {
+  std::array<wire::PlayerInput, 16> inputs;
+  std::size_t count = 0;
+  if (wire::isBinary(bytes)) {
+    count = wire::decode(bytes, inputs);
+  } else {
+    const nlohmann::json json = parseJson(bytes);
+    if (json.is_object() && json.contains("inputSequence")) {
+      inputs[count++] = {sequence(json, "inputSequence"),
+                         {number(json, "velocityX"), number(json, "velocityY")}};
+      const auto earlier = json.find("inputs");
+      if (earlier != json.end() && earlier->is_array()) {
+        for (const auto& input : *earlier) {
+          if (count == inputs.size() || !input.is_object()) break;
+          inputs[count++] = {sequence(input, "inputSequence"),
+                             {number(input, "velocityX"), number(input, "velocityY")}};
+        }
+      }
+    }
+  }
+  if (count == 0) {
+    ++stats_.malformed;
+    return;
+  }
+
+  // Newest first either way; apply the new ones oldest first. Inputs that
+  // arrive together take effect at the same instant, so the newest one's
+  // velocity is what moves the player.
+  Player& player = member.player;
+  for (std::size_t i = count; i-- > 0;) {
+    const wire::PlayerInput& input = inputs[i];
+    if (input.sequence <= player.lastSequence) continue;  // a redundant copy
+    sf::Vector2f velocity = input.velocity;
+    const float speed = std::hypot(velocity.x, velocity.y);
+    player.approved = speed <= settings_.maxSpeed * 1.001f;
+    if (!player.approved) velocity *= settings_.maxSpeed / speed;
+    player.velocity = velocity;
+    player.lastSequence = input.sequence;
+    player.ackPending = true;
+    ++stats_.inputsApplied;
+  }
+}
+
+void LocalMatchServer::applyAction(std::string_view bytes) {
+  std::uint32_t objectId = 0;
+  if (wire::isBinary(bytes)) {
+    wire::PlayerAction action;
+    if (!wire::decode(bytes, action)) {
+      ++stats_.malformed;
+      return;
+    }
+    objectId = action.objectId;
+  } else {
+    const nlohmann::json json = parseJson(bytes);
+    if (!json.is_object() || !json.contains("objectId")) {
+      ++stats_.malformed;
+      return;
+    }
+    objectId = sequence(json, "objectId");
+  }
+  ++stats_.actions;
+
+  const auto it = objects_.find(objectId);
+  const bool visible = !(it == objects_.end() || it->second);
+  objects_[objectId] = visible;
+
+  const nlohmann::json update = {
+      {"type", "object_update"}, {"data", {{"objectId", objectId}, {"visible", visible}}}};
+  const std::string json = update.dump();
+  std::string binary;
+  wire::encode(wire::ObjectUpdate{objectId, wire::ObjectUpdate::kVisible, 0, visible}, binary);
+  for (auto& m : members_) send(*m, opcode::kObjectUpdate, m->binary ? binary : json);
+}
+
+void LocalMatchServer::answerPing(Member& member, std::string_view bytes) {
+  const nlohmann::json ping = parseJson(bytes);
+  if (!ping.is_object() || ping.value("type", "") != "ping" || !ping.contains("data")) {
+    ++stats_.malformed;
+    return;
+  }
+  const nlohmann::json& data = ping["data"];
+  const nlohmann::json pong = {
+      {"type", "pong"},
+      {"data",
+       {{"id", sequence(data, "id")},
+        {"clientTime", number(data, "clientTime")},
+        {"serverTime", static_cast<double>(ticks_) * 1000.0 / settings_.tickRate}}}};
+  send(member, opcode::kPing, pong.dump());
+}
+
+void LocalMatchServer::applyInterest(Member& member, std::string_view bytes) {
+  const nlohmann::json interest = parseJson(bytes);
+  if (!interest.is_object() || !interest.contains("data")) {
+    ++stats_.malformed;
+    return;
+  }
+  const nlohmann::json& data = interest["data"];
+  member.player.interest = {{number(data, "x"), number(data, "y")},
+                            {number(data, "width"), number(data, "height")}};
+}
+
+void LocalMatchServer::sendAck(Member& member) {
+  Player& player = member.player;
+  player.ackPending = false;
+  if (member.binary) {
+    wire::encode(wire::InputAck{player.lastSequence, player.approved, true, player.userId,
+                                player.position},
+                 buffer_);
+  } else {
+    const nlohmann::json ack = {{"type", "input_ack"},
+                                {"data",
+                                 {{"playerId", player.userId},
+                                  {"inputSequence", player.lastSequence},
+                                  {"approved", player.approved},
+                                  {"x", player.position.x},
+                                  {"y", player.position.y}}}};
+    buffer_ = ack.dump();
+  }
+  send(member, opcode::kInputAck, buffer_);
+}
+
+void LocalMatchServer::sendWorld(Member& member) {
+  if (member.snapshots) {
+    member.snapshotServer.encode(worldState_, buffer_);
+    send(member, opcode::kWorldSnapshot, buffer_);
+    return;
+  }
+  if (member.binary) {
+    wire::WorldUpdateWriter writer(buffer_, static_cast<std::uint32_t>(worldState_.size()));
+    for (const SnapshotServer::Player& p : worldState_) {
+      if (member.introduced.size() <= p.netId) member.introduced.resize(p.netId + 1, false);
+      // The user id goes with a player's first entry only.
+      const bool introduced = member.introduced[p.netId];
+      member.introduced[p.netId] = true;
+      writer.add({p.netId, introduced ? std::string_view() : std::string_view(p.userId),
+                  p.position, p.lastSequence});
+    }
+    send(member, opcode::kWorldUpdate, buffer_);
+    return;
+  }
+  nlohmann::json players = nlohmann::json::object();
+  for (const SnapshotServer::Player& p : worldState_) {
+    players[p.userId] = {{"position", {{"x", p.position.x}, {"y", p.position.y}}}};
+  }
+  const nlohmann::json update = {{"type", "world_update"}, {"data", {{"players", players}}}};
+  send(member, opcode::kWorldUpdate, update.dump());
+}
+
+void LocalMatchServer::send(Member& member, std::int64_t opCode, const std::string& bytes) {
+  ++stats_.messagesOut;
+  stats_.bytesOut += bytes.size();
+  member.client->deliver(opCode, bytes);
+}
+
+Nakama::NUserPresence LocalMatchServer::presenceOf(const Member& member) {
+  Nakama::NUserPresence presence;
+  presence.userId = member.player.userId;
+  presence.sessionId = member.player.userId;
+  presence.username = member.player.userId;
+  return presence;
+}
@@ -0,0 +1,207 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef TESTS_SUPPORT_LOCALMATCHSERVER_H_
+#define TESTS_SUPPORT_LOCALMATCHSERVER_H_
+
+#include <nakama-cpp/Nakama.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "networking/WireProtocol.h"
+#include "support/SnapshotServer.h"
+#include "support/UnsupportedRtClient.h"
+
+class LocalMatchServer;
+
+// Session with a fixed user id, for clients of a LocalMatchServer.
+class LocalSession : public Nakama::NSessionInterface {
+ public:
+  explicit LocalSession(std::string userId) : userId_(std::move(userId)), username_(userId_) {}
+
+  const std::string& getAuthToken() const override { return token_; }
+  const std::string& getRefreshToken() const override { return token_; }
+  const std::string& getUserId() const override { return userId_; }
+  const std::string& getUsername() const override { return username_; }
+  bool isExpired() const override { return false; }
+  bool isExpired(Nakama::NTimestamp /*now*/) const override { return false; }
+  bool isRefreshExpired() const override { return false; }
+  bool isRefreshExpired(Nakama::NTimestamp /*now*/) const override { return false; }
+  const Nakama::NStringMap& getVariables() const override { return variables_; }
+  std::string getVariable(const std::string& /*name*/) const override { return {}; }
+  Nakama::NTimestamp getCreateTime() const override { return 0; }
+  Nakama::NTimestamp getExpireTime() const override { return 0; }
+  bool isCreated() const override { return true; }
+
+ private:
+  std::string userId_;
+  std::string username_;
+  std::string token_;
+  Nakama::NStringMap variables_;
+};
+
+// Realtime client connected to a LocalMatchServer in the same process.
+// It serves connect, the server's one match and match data; everything
+// else fails as in UnsupportedRtClient. As with the real client, events
+// and callbacks run from tick(). Create it with
+// LocalMatchServer::createClient(); the server must outlive it.
+class LocalRtClient : public UnsupportedRtClient {
+ public:
+  explicit LocalRtClient(LocalMatchServer& server) : server_(server) {}
+  ~LocalRtClient() override;
+
+  void tick() override;
+  void connect(Nakama::NSessionPtr session, bool createStatus,
+               Nakama::NRtClientProtocol protocol) override;
+  bool isConnecting() const override;
+  bool isConnected() const override;
+  void disconnect() override;
+  void joinMatch(const std::string& matchId, const Nakama::NStringMap& metadata,
+                 std::function<void(const Nakama::NMatch&)> successCallback,
+                 Nakama::RtErrorCallback errorCallback) override;
+  void leaveMatch(const std::string& matchId, std::function<void()> successCallback,
+                  Nakama::RtErrorCallback errorCallback) override;
+  void sendMatchData(const std::string& matchId, int64_t opCode, const Nakama::NBytes& data,
+                     const std::vector<Nakama::NUserPresence>& presences) override;
+
+  const std::string& userId() const { return userId_; }
+
+ private:
+  friend class LocalMatchServer;
+
+  // Called by the server, from any thread; delivered at the next tick().
+  void post(std::function<void()> event);
+  void deliver(std::int64_t opCode, const std::string& bytes);
+  void deliverPresence(Nakama::NMatchPresenceEvent event);
+
+  LocalMatchServer& server_;
+  std::string userId_;
+  std::atomic<bool> connecting_{false};
+  std::atomic<bool> connected_{false};
+  std::mutex inboxMutex_;
+  std::deque<std::function<void()>> inbox_;
+  std::deque<std::function<void()>> running_;  // drained outside the lock
+};
+
+// In-process stand-in for the authoritative match handler, speaking the
+// opcode protocol of Networking:
+// - movement inputs (1), applied once each in sequence order, with
+//   redundant copies ignored; speeds are clamped to maxSpeed and an
+//   input over it is acked as not approved;
+// - input acks (4) for each player that sent inputs, every tick;
+// - world state every tick: world_update (2), or delta world_snapshot (3)
+//   against the client's acked baseline (8) for clients that offer it;
+// - object interactions (5), which toggle the object's visibility and are
+//   broadcast as object_update;
+// - pings (6), answered with pongs carrying the match time;
+// - interest rects (7), recorded only.
+// Clients that offer the binary protocol at join get binary replies.
+//
+// The match loop runs only when the test calls advance() or step(), so a
+// run is deterministic. Clients may be ticked from other threads.
+class LocalMatchServer {
+ public:
+  struct Settings {
+    int tickRate = 20;
+    float maxSpeed = 200.f;  // px/s
+    sf::Vector2f spawn{100.f, 100.f};
+    bool binary = true;     // answer clients that offer wire::kVersion in binary
+    bool snapshots = true;  // world_snapshot to binary clients that offer it
+  };
+
+  struct Player {
+    std::string userId;
+    std::uint32_t netId = 0;
+    sf::Vector2f position;
+    sf::Vector2f velocity;
+    std::uint32_t lastSequence = 0;
+    bool approved = true;  // verdict on the newest input
+    bool ackPending = false;
+    sf::FloatRect interest;
+  };
+
+  struct Stats {
+    std::uint64_t ticks = 0;
+    std::uint64_t messagesIn = 0;
+    std::uint64_t bytesIn = 0;
+    std::uint64_t messagesOut = 0;
+    std::uint64_t bytesOut = 0;
+    std::uint64_t inputsApplied = 0;
+    std::uint64_t actions = 0;
+    std::uint64_t malformed = 0;
+  };
+
+  LocalMatchServer();
+  explicit LocalMatchServer(const Settings& settings);
+
+  const std::string& matchId() const { return matchId_; }
+  const Settings& settings() const { return settings_; }
+
+  // A new client of this server, e.g. for Networking::setRtClientFactory.
+  std::shared_ptr<LocalRtClient> createClient();
+
+  // Runs as many whole ticks as fit in `seconds` plus the carried-over rest.
+  void advance(double seconds);
+  void step();
+  double time() const;  // match time, seconds
+
+  std::size_t playerCount() const;
+  // A copy of the player's state; false when not in the match.
+  bool findPlayer(std::string_view userId, Player& out) const;
+  bool objectVisible(std::uint32_t objectId) const;
+  Stats stats() const;
+
+ private:
+  friend class LocalRtClient;
+
+  struct Member {
+    LocalRtClient* client = nullptr;
+    Player player;
+    bool binary = false;
+    bool snapshots = false;
+    SnapshotServer snapshotServer;
+    std::vector<bool> introduced;  // netIds whose userId this client has seen
+  };
+
+  // From LocalRtClient.
+  void join(LocalRtClient* client, const Nakama::NStringMap& metadata,
+            std::function<void(const Nakama::NMatch&)> onJoined);
+  void leave(LocalRtClient* client);
+  void receive(LocalRtClient* client, std::int64_t opCode, const std::string& bytes);
+
+  Member* findMember(const LocalRtClient* client);
+  void applyInputs(Member& member, std::string_view bytes);
+  void applyAction(std::string_view bytes);
+  void answerPing(Member& member, std::string_view bytes);
+  void applyInterest(Member& member, std::string_view bytes);
+  void sendAck(Member& member);
+  void sendWorld(Member& member);
+  void send(Member& member, std::int64_t opCode, const std::string& bytes);
+  static Nakama::NUserPresence presenceOf(const Member& member);
+
+  Settings settings_;
+  std::string matchId_ = "local.match";
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<Member>> members_;  // in join order
+  std::uint32_t nextNetId_ = 1;
+  std::uint64_t ticks_ = 0;
+  double carry_ = 0.0;
+  std::map<std::uint32_t, bool> objects_;  // visibility; absent means visible
+  Stats stats_;
+  std::string buffer_;  // reused for outgoing messages
+  std::vector<SnapshotServer::Player> worldState_;
+};
+
+#endif  // TESTS_SUPPORT_LOCALMATCHSERVER_H_
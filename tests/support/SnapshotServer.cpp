@@ -0,0 +1,65 @@
+// Copyright 2025 WildSpark Authors
+
+#include "support/SnapshotServer.h"
+
+#include <utility>
+
+const SnapshotServer::State* SnapshotServer::find(std::uint32_t snapshotId) const {
+  const State& state = history_[snapshotId % kHistory];
+  return snapshotId != 0 && state.id == snapshotId ? &state : nullptr;
+}
+
+void SnapshotServer::acknowledge(std::uint32_t snapshotId) {
+  if (snapshotId > acked_) acked_ = snapshotId;
+}
+
+std::uint32_t SnapshotServer::encode(const std::vector<Player>& players, std::string& out) {
+  using Entry = wire::SnapshotEntry;
+  const State* baselineState = find(acked_);
+  static const std::vector<SnapshotHistory::Player> kNone;
+  const std::vector<SnapshotHistory::Player>& baseline =
+      baselineState ? baselineState->players : kNone;
+
+  std::vector<SnapshotHistory::Player> current;
+  current.reserve(players.size());
+  changes_.clear();
+  std::size_t b = 0;
+  for (const Player& player : players) {
+    const SnapshotHistory::Player now{player.netId, wire::quantize(player.position.x),
+                                      wire::quantize(player.position.y), player.lastSequence};
+    current.push_back(now);
+    for (; b < baseline.size() && baseline[b].netId < now.netId; ++b) {
+      changes_.push_back({baseline[b].netId, Entry::kRemoved});
+    }
+    Entry change;
+    change.netId = now.netId;
+    if (b < baseline.size() && baseline[b].netId == now.netId) {
+      const SnapshotHistory::Player& before = baseline[b++];
+      if (now.x != before.x || now.y != before.y) {
+        change.fields |= Entry::kPosition;
+        change.dx = now.x - before.x;
+        change.dy = now.y - before.y;
+      }
+      if (now.lastSequence != before.lastSequence) change.fields |= Entry::kSequence;
+      if (change.fields == 0) continue;
+    } else {
+      change.fields = Entry::kUserId | Entry::kPosition | Entry::kSequence;
+      change.userId = player.userId;
+      change.dx = now.x;
+      change.dy = now.y;
+    }
+    change.lastSequence = now.lastSequence;
+    changes_.push_back(change);
+  }
+  for (; b < baseline.size(); ++b) changes_.push_back({baseline[b].netId, Entry::kRemoved});
+
+  const std::uint32_t id = nextId_++;
+  wire::SnapshotWriter writer(out, id, baselineState ? baselineState->id : 0,
+                              static_cast<std::uint32_t>(changes_.size()));
+  for (const Entry& change : changes_) writer.add(change);
+
+  State& slot = history_[id % kHistory];
+  slot.id = id;
+  slot.players = std::move(current);
+  return id;
+}
@@ -0,0 +1,53 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef TESTS_SUPPORT_SNAPSHOTSERVER_H_
+#define TESTS_SUPPORT_SNAPSHOTSERVER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "networking/SnapshotHistory.h"
+#include "networking/WireProtocol.h"
+
+// In-process stand-in for the server side of delta world snapshots
+// (opcode 3). It numbers each world state it encodes, keeps the last
+// kHistory of them, and encodes the next one against the newest snapshot
+// the client acknowledged, or in full when that one is no longer held.
+class SnapshotServer {
+ public:
+  static constexpr std::size_t kHistory = SnapshotHistory::kRingSize;
+
+  struct Player {
+    std::uint32_t netId = 0;
+    std::string userId;
+    sf::Vector2f position;
+    std::uint32_t lastSequence = 0;
+  };
+
+  // Encodes `players`, ascending by netId, as the next snapshot and
+  // returns its id.
+  std::uint32_t encode(const std::vector<Player>& players, std::string& out);
+  // Client ack (opcode 8); older ids than the newest acked are ignored.
+  void acknowledge(std::uint32_t snapshotId);
+  std::uint32_t acknowledged() const { return acked_; }
+
+ private:
+  struct State {
+    std::uint32_t id = 0;
+    std::vector<SnapshotHistory::Player> players;
+  };
+
+  const State* find(std::uint32_t snapshotId) const;
+
+  std::array<State, kHistory> history_;
+  std::uint32_t nextId_ = 1;
+  std::uint32_t acked_ = 0;
+  std::vector<wire::SnapshotEntry> changes_;
+};
+
+#endif  // TESTS_SUPPORT_SNAPSHOTSERVER_H_
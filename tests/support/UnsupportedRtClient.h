@@ -0,0 +1,376 @@
+// Copyright 2025 WildSpark Authors
+
+#ifndef TESTS_SUPPORT_UNSUPPORTEDRTCLIENT_H_
+#define TESTS_SUPPORT_UNSUPPORTEDRTCLIENT_H_
+
+#include <nakama-cpp/Nakama.h>
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Realtime client that is never connected and supports nothing: callback
+// calls report RtErrorCode::RUNTIME_FUNCTION_NOT_FOUND, async calls return
+// a failed future. In-process stand-ins derive from it and implement what
+// they serve; see LocalRtClient.
+class UnsupportedRtClient : public Nakama::NRtClientInterface {
+ public:
+  void tick() override {}
+
+  Nakama::NRtTransportPtr getTransport() const override { return nullptr; }
+
+  void setListener(Nakama::NRtClientListenerInterface* listener) override { listener_ = listener; }
+
+  void setUserData(void* userData) override { userData_ = userData; }
+
+  void* getUserData() const override { return userData_; }
+
+  void setHeartbeatIntervalMs(Nakama::opt::optional<int> ms) override { heartbeatMs_ = ms; }
+
+  Nakama::opt::optional<int> getHeartbeatIntervalMs() override { return heartbeatMs_; }
+
+  void connect(Nakama::NSessionPtr /*session*/, bool /*createStatus*/,
+               Nakama::NRtClientProtocol /*protocol*/) override {}
+
+  std::future<void> connectAsync(Nakama::NSessionPtr /*session*/, bool /*createStatus*/,
+                                 Nakama::NRtClientProtocol /*protocol*/) override {
+    return failed<void>("connectAsync");
+  }
+
+  bool isConnecting() const override { return false; }
+
+  bool isConnected() const override { return false; }
+
+  void disconnect() override {}
+
+  std::future<void> disconnectAsync() override {
+    return failed<void>("disconnectAsync");
+  }
+
+  void joinChat(const std::string& /*target*/, Nakama::NChannelType /*type*/,
+                const Nakama::opt::optional<bool>& /*persistence*/,
+                const Nakama::opt::optional<bool>& /*hidden*/,
+                std::function<void(Nakama::NChannelPtr)> /*successCallback*/,
+                Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "joinChat");
+  }
+
+  void leaveChat(const std::string& /*channelId*/, std::function<void()> /*successCallback*/,
+                 Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "leaveChat");
+  }
+
+  void writeChatMessage(const std::string& /*channelId*/, const std::string& /*content*/,
+                        std::function<void(const Nakama::NChannelMessageAck&)> /*successCallback*/,
+                        Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "writeChatMessage");
+  }
+
+  void updateChatMessage(const std::string& /*channelId*/, const std::string& /*messageId*/,
+                         const std::string& /*content*/,
+                         std::function<void(const Nakama::NChannelMessageAck&)> /*successCallback*/,
+                         Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "updateChatMessage");
+  }
+
+  void removeChatMessage(const std::string& /*channelId*/, const std::string& /*messageId*/,
+                         std::function<void(const Nakama::NChannelMessageAck&)> /*successCallback*/,
+                         Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "removeChatMessage");
+  }
+
+  void createMatch(std::function<void(const Nakama::NMatch&)> /*successCallback*/,
+                   Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "createMatch");
+  }
+
+  void joinMatch(const std::string& /*matchId*/, const Nakama::NStringMap& /*metadata*/,
+                 std::function<void(const Nakama::NMatch&)> /*successCallback*/,
+                 Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "joinMatch");
+  }
+
+  void joinMatchByToken(const std::string& /*token*/,
+                        std::function<void(const Nakama::NMatch&)> /*successCallback*/,
+                        Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "joinMatchByToken");
+  }
+
+  void leaveMatch(const std::string& /*matchId*/, std::function<void()> /*successCallback*/,
+                  Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "leaveMatch");
+  }
+
+  void addMatchmaker(const Nakama::opt::optional<int32_t>& /*minCount*/,
+                     const Nakama::opt::optional<int32_t>& /*maxCount*/,
+                     const Nakama::opt::optional<std::string>& /*query*/,
+                     const Nakama::NStringMap& /*stringProperties*/,
+                     const Nakama::NStringDoubleMap& /*numericProperties*/,
+                     const Nakama::opt::optional<int32_t>& /*countMultiple*/,
+                     std::function<void(const Nakama::NMatchmakerTicket&)> /*successCallback*/,
+                     Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "addMatchmaker");
+  }
+
+  void removeMatchmaker(const std::string& /*ticket*/, std::function<void()> /*successCallback*/,
+                        Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "removeMatchmaker");
+  }
+
+  void sendMatchData(const std::string& /*matchId*/, int64_t /*opCode*/,
+                     const Nakama::NBytes& /*data*/,
+                     const std::vector<Nakama::NUserPresence>& /*presences*/) override {}
+
+  void followUsers(const std::vector<std::string>& /*userIds*/,
+                   std::function<void(const Nakama::NStatus&)> /*successCallback*/,
+                   Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "followUsers");
+  }
+
+  void unfollowUsers(const std::vector<std::string>& /*userIds*/,
+                     std::function<void()> /*successCallback*/,
+                     Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "unfollowUsers");
+  }
+
+  void updateStatus(const std::string& /*status*/, std::function<void()> /*successCallback*/,
+                    Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "updateStatus");
+  }
+
+  void rpc(const std::string& /*id*/, const Nakama::opt::optional<std::string>& /*payload*/,
+           std::function<void(const Nakama::NRpc&)> /*successCallback*/,
+           Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "rpc");
+  }
+
+  void acceptPartyMember(const std::string& /*partyId*/, Nakama::NUserPresence& /*presence*/,
+                         std::function<void()> /*successCallback*/,
+                         Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "acceptPartyMember");
+  }
+
+  void addMatchmakerParty(
+      const std::string& /*partyId*/, const std::string& /*query*/, int32_t /*minCount*/,
+      int32_t /*maxCount*/, const Nakama::NStringMap& /*stringProperties*/,
+      const Nakama::NStringDoubleMap& /*numericProperties*/,
+      const Nakama::opt::optional<int32_t>& /*countMultiple*/,
+      std::function<void(const Nakama::NPartyMatchmakerTicket&)> /*successCallback*/,
+      Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "addMatchmakerParty");
+  }
+
+  void closeParty(const std::string& /*partyId*/, std::function<void()> /*successCallback*/,
+                  Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "closeParty");
+  }
+
+  void createParty(bool /*open*/, int /*maxSize*/,
+                   std::function<void(const Nakama::NParty&)> /*successCallback*/,
+                   Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "createParty");
+  }
+
+  void joinParty(const std::string& /*partyId*/, std::function<void()> /*successCallback*/,
+                 Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "joinParty");
+  }
+
+  void leaveParty(const std::string& /*partyId*/, std::function<void()> /*successCallback*/,
+                  Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "leaveParty");
+  }
+
+  void listPartyJoinRequests(
+      const std::string& /*partyId*/,
+      std::function<void(const Nakama::NPartyJoinRequest&)> /*successCallback*/,
+      Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "listPartyJoinRequests");
+  }
+
+  void promotePartyMember(const std::string& /*partyId*/, Nakama::NUserPresence& /*partyMember*/,
+                          std::function<void()> /*successCallback*/,
+                          Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "promotePartyMember");
+  }
+
+  void removeMatchmakerParty(const std::string& /*partyId*/, const std::string& /*ticket*/,
+                             std::function<void()> /*successCallback*/,
+                             Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "removeMatchmakerParty");
+  }
+
+  void removePartyMember(const std::string& /*partyId*/, Nakama::NUserPresence& /*presence*/,
+                         std::function<void()> /*successCallback*/,
+                         Nakama::RtErrorCallback errorCallback) override {
+    unsupported(errorCallback, "removePartyMember");
+  }
+
+  void sendPartyData(const std::string& /*partyId*/, int64_t /*opCode*/,
+                     Nakama::NBytes& /*data*/) override {}
+
+  std::future<Nakama::NChannelPtr> joinChatAsync(
+      const std::string& /*target*/, Nakama::NChannelType /*type*/,
+      const Nakama::opt::optional<bool>& /*persistence*/,
+      const Nakama::opt::optional<bool>& /*hidden*/) override {
+    return failed<Nakama::NChannelPtr>("joinChatAsync");
+  }
+
+  std::future<void> leaveChatAsync(const std::string& /*channelId*/) override {
+    return failed<void>("leaveChatAsync");
+  }
+
+  std::future<Nakama::NChannelMessageAck> writeChatMessageAsync(
+      const std::string& /*channelId*/, const std::string& /*content*/) override {
+    return failed<Nakama::NChannelMessageAck>("writeChatMessageAsync");
+  }
+
+  std::future<Nakama::NChannelMessageAck> updateChatMessageAsync(
+      const std::string& /*channelId*/, const std::string& /*messageId*/,
+      const std::string& /*content*/) override {
+    return failed<Nakama::NChannelMessageAck>("updateChatMessageAsync");
+  }
+
+  std::future<void> removeChatMessageAsync(const std::string& /*channelId*/,
+                                           const std::string& /*messageId*/) override {
+    return failed<void>("removeChatMessageAsync");
+  }
+
+  std::future<Nakama::NMatch> createMatchAsync() override {
+    return failed<Nakama::NMatch>("createMatchAsync");
+  }
+
+  std::future<Nakama::NMatch> joinMatchAsync(const std::string& /*matchId*/,
+                                             const Nakama::NStringMap& /*metadata*/) override {
+    return failed<Nakama::NMatch>("joinMatchAsync");
+  }
+
+  std::future<Nakama::NMatch> joinMatchByTokenAsync(const std::string& /*token*/) override {
+    return failed<Nakama::NMatch>("joinMatchByTokenAsync");
+  }
+
+  std::future<void> leaveMatchAsync(const std::string& /*matchId*/) override {
+    return failed<void>("leaveMatchAsync");
+  }
+
+  std::future<Nakama::NMatchmakerTicket> addMatchmakerAsync(
+      const Nakama::opt::optional<int32_t>& /*minCount*/,
+      const Nakama::opt::optional<int32_t>& /*maxCount*/,
+      const Nakama::opt::optional<std::string>& /*query*/,
+      const Nakama::NStringMap& /*stringProperties*/,
+      const Nakama::NStringDoubleMap& /*numericProperties*/,
+      const Nakama::opt::optional<int32_t>& /*countMultiple*/) override {
+    return failed<Nakama::NMatchmakerTicket>("addMatchmakerAsync");
+  }
+
+  std::future<void> removeMatchmakerAsync(const std::string& /*ticket*/) override {
+    return failed<void>("removeMatchmakerAsync");
+  }
+
+  std::future<void> sendMatchDataAsync(
+      const std::string& /*matchId*/, std::int64_t /*opCode*/, const Nakama::NBytes& /*data*/,
+      const std::vector<Nakama::NUserPresence>& /*presences*/) override {
+    return failed<void>("sendMatchDataAsync");
+  }
+
+  std::future<Nakama::NStatus> followUsersAsync(
+      const std::vector<std::string>& /*userIds*/) override {
+    return failed<Nakama::NStatus>("followUsersAsync");
+  }
+
+  std::future<void> unfollowUsersAsync(const std::vector<std::string>& /*userIds*/) override {
+    return failed<void>("unfollowUsersAsync");
+  }
+
+  std::future<void> updateStatusAsync(const std::string& /*status*/) override {
+    return failed<void>("updateStatusAsync");
+  }
+
+  std::future<Nakama::NRpc> rpcAsync(
+      const std::string& /*id*/, const Nakama::opt::optional<std::string>& /*payload*/) override {
+    return failed<Nakama::NRpc>("rpcAsync");
+  }
+
+  std::future<void> acceptPartyMemberAsync(const std::string& /*partyId*/,
+                                           Nakama::NUserPresence& /*presence*/) override {
+    return failed<void>("acceptPartyMemberAsync");
+  }
+
+  std::future<Nakama::NPartyMatchmakerTicket> addMatchmakerPartyAsync(
+      const std::string& /*partyId*/, const std::string& /*query*/, int32_t /*minCount*/,
+      int32_t /*maxCount*/, const Nakama::NStringMap& /*stringProperties*/,
+      const Nakama::NStringDoubleMap& /*numericProperties*/,
+      const Nakama::opt::optional<int32_t>& /*countMultiple*/) override {
+    return failed<Nakama::NPartyMatchmakerTicket>("addMatchmakerPartyAsync");
+  }
+
+  std::future<void> closePartyAsync(const std::string& /*partyId*/) override {
+    return failed<void>("closePartyAsync");
+  }
+
+  std::future<Nakama::NParty> createPartyAsync(bool /*open*/, int /*maxSize*/) override {
+    return failed<Nakama::NParty>("createPartyAsync");
+  }
+
+  std::future<void> joinPartyAsync(const std::string& /*partyId*/) override {
+    return failed<void>("joinPartyAsync");
+  }
+
+  std::future<void> leavePartyAsync(const std::string& /*partyId*/) override {
+    return failed<void>("leavePartyAsync");
+  }
+
+  std::future<Nakama::NPartyJoinRequest> listPartyJoinRequestsAsync(
+      const std::string& /*partyId*/) override {
+    return failed<Nakama::NPartyJoinRequest>("listPartyJoinRequestsAsync");
+  }
+
+  std::future<void> promotePartyMemberAsync(const std::string& /*partyId*/,
+                                            Nakama::NUserPresence& /*partyMember*/) override {
+    return failed<void>("promotePartyMemberAsync");
+  }
+
+  std::future<void> removeMatchmakerPartyAsync(const std::string& /*partyId*/,
+                                               const std::string& /*ticket*/) override {
+    return failed<void>("removeMatchmakerPartyAsync");
+  }
+
+  std::future<void> removePartyMemberAsync(const std::string& /*partyId*/,
+                                           Nakama::NUserPresence& /*presence*/) override {
+    return failed<void>("removePartyMemberAsync");
+  }
+
+  std::future<void> sendPartyDataAsync(const std::string& /*partyId*/, int64_t /*opCode*/,
+                                       Nakama::NBytes& /*data*/) override {
+    return failed<void>("sendPartyDataAsync");
+  }
+
+ protected:
+  static void unsupported(const Nakama::RtErrorCallback& errorCallback, const char* what) {
+    if (!errorCallback) return;
+    Nakama::NRtError error;
+    error.code = Nakama::RtErrorCode::RUNTIME_FUNCTION_NOT_FOUND;
+    error.message = std::string(what) + " is not supported here";
+    errorCallback(error);
+  }
+
+  template <typename T>
+  static std::future<T> failed(const char* what) {
+    std::promise<T> promise;
+    promise.set_exception(
+        std::make_exception_ptr(std::runtime_error(std::string(what) + " is not supported here")));
+    return promise.get_future();
+  }
+
+  Nakama::NRtClientListenerInterface* listener_ = nullptr;
+
+ private:
+  void* userData_ = nullptr;
+  Nakama::opt::optional<int> heartbeatMs_;
+};
+
+#endif  // TESTS_SUPPORT_UNSUPPORTEDRTCLIENT_H_
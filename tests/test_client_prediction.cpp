@@ -0,0 +1,150 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+#include "world/entities/ClientPrediction.h"
+#include "world/entities/MovementModel.h"
+
+namespace {
+
+// Server stand-in with the same rules as the match handler: an input sets
+// the velocity, which is held until the next input, and every ack carries
+// the position at the moment the input was applied.
+class FakeServer {
+ public:
+  explicit FakeServer(sf::Vector2f start) : position_(start) {}
+
+  struct Ack {
+    unsigned int sequence;
+    sf::Vector2f position;
+  };
+
+  Ack apply(unsigned int sequence, sf::Vector2f velocity) {
+    velocity_ = velocity;
+    sequence_ = sequence;
+    return {sequence, position_};
+  }
+  void tick(float dt) { position_ = simulateMove(position_, {sequence_, velocity_, dt}); }
+  sf::Vector2f position() const { return position_; }
+
+ private:
+  sf::Vector2f position_;
+  sf::Vector2f velocity_;
+  unsigned int sequence_ = 0;
+};
+
+}  // namespace
+
+TEST(ClientPrediction, StepMovesImmediatelyAndMergesFrames) {
+  ClientPrediction prediction;
+  prediction.reset({0.f, 0.f});
+  prediction.step({1, {100.f, 0.f}, 0.1f});
+  prediction.step({1, {100.f, 0.f}, 0.1f});
+  prediction.step({2, {0.f, 50.f}, 0.2f});
+  prediction.step({2, {0.f, 0.f}, 1.f});  // standing still is not recorded
+  EXPECT_NEAR(prediction.predicted().x, 20.f, 1e-4f);
+  EXPECT_NEAR(prediction.predicted().y, 10.f, 1e-4f);
+  EXPECT_EQ(prediction.pendingInputs(), 2u);
+}
+
+TEST(ClientPrediction, AckReplaysUnacknowledgedInputs) {
+  ClientPrediction prediction;
+  prediction.reset({0.f, 0.f});
+  prediction.step({1, {100.f, 0.f}, 0.1f});
+  prediction.step({2, {0.f, 100.f}, 0.1f});
+  prediction.step({3, {-100.f, 0.f}, 0.1f});
+
+  // Input 2 was applied 1px further right than predicted.
+  prediction.reconcile(2, true, {11.f, 0.f});
+  EXPECT_EQ(prediction.lastReplayCount(), 2u);
+  EXPECT_NEAR(prediction.predicted().x, 1.f, 1e-4f);
+  EXPECT_NEAR(prediction.predicted().y, 10.f, 1e-4f);
+  // Without smoothing the correction is applied at once.
+  EXPECT_EQ(prediction.displayed(), prediction.predicted());
+}
+
+TEST(ClientPrediction, RejectedInputIsNotReplayed) {
+  ClientPrediction prediction;
+  prediction.reset({0.f, 0.f});
+  prediction.step({1, {100.f, 0.f}, 0.1f});
+  prediction.step({2, {0.f, 100.f}, 0.1f});
+  prediction.reconcile(1, false, {0.f, 0.f});
+  EXPECT_NEAR(prediction.predicted().x, 0.f, 1e-4f);
+  EXPECT_NEAR(prediction.predicted().y, 10.f, 1e-4f);
+
+  // Older acks arriving late are ignored.
+  prediction.reconcile(0, true, {500.f, 500.f});
+  EXPECT_NEAR(prediction.predicted().y, 10.f, 1e-4f);
+}
+
+TEST(ClientPrediction, SmoothingDecaysTheCorrection) {
+  ClientPrediction prediction;
+  PredictionSettings settings;
+  settings.smoothing = 10.f;
+  settings.snapDistance = 50.f;
+  prediction.setSettings(settings);
+  prediction.reset({0.f, 0.f});
+  prediction.step({1, {100.f, 0.f}, 0.1f});
+
+  prediction.reconcile(1, true, {-5.f, 0.f});
+  // Nothing pops on the ack; the error is folded out over time.
+  EXPECT_NEAR(prediction.displayed().x, 10.f, 1e-4f);
+  EXPECT_NEAR(prediction.predicted().x, 5.f, 1e-4f);
+  prediction.update(0.1f);
+  EXPECT_LT(prediction.correction().x, 5.f);
+  EXPECT_GT(prediction.correction().x, 0.f);
+  for (int i = 0; i < 100; ++i) prediction.update(0.1f);
+  EXPECT_EQ(prediction.correction(), sf::Vector2f(0.f, 0.f));
+
+  // Large errors snap regardless of smoothing.
+  prediction.reconcile(1, true, {500.f, 0.f});
+  EXPECT_EQ(prediction.correction(), sf::Vector2f(0.f, 0.f));
+}
+
+TEST(ClientPrediction, MatchesServerUnderLatency) {
+  const sf::Vector2f start(100.f, 100.f);
+  FakeServer server(start);
+  ClientPrediction client;
+  client.reset(start);
+
+  // Inputs reach the server three frames after they are sent, and acks come
+  // back three frames later.
+  constexpr int kLatencyFrames = 3;
+  const float frameDt = 1.f / 60.f;
+  struct InFlight {
+    int arrives;
+    unsigned int sequence;
+    sf::Vector2f velocity;
+  };
+  std::vector<InFlight> toServer;
+  std::vector<std::pair<int, FakeServer::Ack>> toClient;
+
+  unsigned int sequence = 0;
+  sf::Vector2f velocity;
+  for (int frame = 0; frame < 240; ++frame) {
+    if (frame % 20 == 0) {
+      velocity = {(frame / 20) % 2 ? 100.f : -40.f, (frame / 20) % 3 ? 60.f : -80.f};
+      toServer.push_back({frame + kLatencyFrames, ++sequence, velocity});
+    }
+    client.step({sequence, velocity, frameDt});
+
+    for (auto it = toServer.begin(); it != toServer.end();) {
+      if (it->arrives != frame) { ++it; continue; }
+      toClient.push_back({frame + kLatencyFrames, server.apply(it->sequence, it->velocity)});
+      it = toServer.erase(it);
+    }
+    server.tick(frameDt);
+    for (auto it = toClient.begin(); it != toClient.end();) {
+      if (it->first != frame) { ++it; continue; }
+      const sf::Vector2f before = client.displayed();
+      client.reconcile(it->second.sequence, true, it->second.position);
+      // With a deterministic model the replay lands where we already were.
+      EXPECT_NEAR(client.displayed().x, before.x, 0.05f);
+      EXPECT_NEAR(client.displayed().y, before.y, 0.05f);
+      it = toClient.erase(it);
+    }
+  }
+}
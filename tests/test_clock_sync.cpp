@@ -0,0 +1,78 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "networking/ClockSync.h"
+
+namespace {
+
+// One ping/pong exchange with the given one-way delays. The server clock
+// runs `skew` seconds ahead of the local one.
+bool exchange(ClockSync& sync, double& now, double up, double down, double skew) {
+  std::uint32_t id;
+  if (!sync.pollPing(now, id)) return false;
+  const double serverTime = now + up + skew;
+  now += up + down;
+  return sync.onPong(id, serverTime, now);
+}
+
+}  // namespace
+
+TEST(ClockSync, SymmetricDelaysRecoverOffsetAndRtt) {
+  ClockSync sync;
+  double now = 100.0;
+  ASSERT_TRUE(exchange(sync, now, 0.04, 0.04, 12.5));
+  EXPECT_TRUE(sync.synced());
+  EXPECT_NEAR(sync.offset(), 12.5, 1e-9);
+  EXPECT_NEAR(sync.rtt(), 0.08, 1e-9);
+  EXPECT_NEAR(sync.serverNow(now), now + 12.5, 1e-9);
+}
+
+TEST(ClockSync, PingsFollowBurstThenInterval) {
+  ClockSync sync;
+  double now = 0.0;
+  std::uint32_t id;
+  for (std::size_t i = 0; i < sync.settings().burstSamples; ++i) {
+    ASSERT_TRUE(exchange(sync, now, 0.01, 0.01, 0.0));
+    EXPECT_FALSE(sync.pollPing(now, id));
+    now += sync.settings().burstInterval;
+  }
+  ASSERT_TRUE(sync.pollPing(now, id));
+  EXPECT_FALSE(sync.pollPing(now + sync.settings().burstInterval, id));
+  EXPECT_TRUE(sync.pollPing(now + sync.settings().interval, id));
+}
+
+TEST(ClockSync, QueuedSamplesDoNotSkewTheEstimate) {
+  ClockSync sync;
+  double now = 0.0;
+  // Mostly clean 50 ms round trips, with every third one stuck in an
+  // upstream queue for 300 ms.
+  for (int i = 0; i < 30; ++i) {
+    const double up = i % 3 == 0 ? 0.325 : 0.025;
+    ASSERT_TRUE(exchange(sync, now, up, 0.025, -3.0));
+    now += 1.0;
+  }
+  EXPECT_NEAR(sync.rtt(), 0.05, 1e-9);
+  EXPECT_NEAR(sync.offset(), -3.0, 1e-9);
+  EXPECT_GT(sync.jitter(), 0.1);
+}
+
+TEST(ClockSync, UnknownAndLatePongsAreIgnored) {
+  ClockSync sync;
+  std::uint32_t id;
+  ASSERT_TRUE(sync.pollPing(0.0, id));
+  EXPECT_FALSE(sync.onPong(id + 1, 5.0, 0.1));
+  EXPECT_FALSE(sync.onPong(id, 5.0, sync.settings().timeout + 1.0));
+  EXPECT_FALSE(sync.onPong(id, 5.0, 0.1));  // already consumed
+  EXPECT_FALSE(sync.synced());
+}
+
+TEST(ClockSync, LocalTimeHasSubMillisecondResolution) {
+  const double a = ClockSync::localTime();
+  double b = a;
+  for (int i = 0; i < 1000000 && b == a; ++i) b = ClockSync::localTime();
+  EXPECT_GT(b, a);
+  EXPECT_LT(b - a, 1e-3);
+}
@@ -0,0 +1,226 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mocks/MockRtClient.h"
+#include "networking/ConditionedRtClient.h"
+
+using testing::_;
+
+namespace {
+
+class RecordingListener : public Nakama::NRtClientListenerInterface {
+ public:
+  void onConnect() override { ++connects; }
+  void onMatchData(const Nakama::NMatchData& data) override { received.push_back(data.data); }
+  void onMatchPresence(const Nakama::NMatchPresenceEvent& event) override {
+    for (const auto& left : event.leaves) received.push_back("leave " + left.userId);
+  }
+
+  int connects = 0;
+  std::vector<std::string> received;
+};
+
+// A ConditionedRtClient over a mock, with a clock the test moves.
+struct Harness {
+  explicit Harness(const NetworkConditions& conditions)
+      : inner(std::make_shared<testing::NiceMock<MockRtClient>>()) {
+    ON_CALL(*inner, setListener(_)).WillByDefault([this](Nakama::NRtClientListenerInterface* l) {
+      innerListener = l;
+    });
+    ON_CALL(*inner, sendMatchData(_, _, _, _))
+        .WillByDefault([this](const std::string&, std::int64_t, const Nakama::NBytes& data,
+                              const std::vector<Nakama::NUserPresence>&) {
+          sent.push_back(data);
+        });
+    client = std::make_unique<ConditionedRtClient>(inner, conditions, [this] { return now; });
+    client->setListener(&listener);
+  }
+
+  // What the server would push down; reaches the wrapper right away.
+  void serverSends(const std::string& bytes) {
+    Nakama::NMatchData data;
+    data.opCode = 2;
+    data.data = bytes;
+    innerListener->onMatchData(data);
+  }
+
+  void serverSendsLeave(const std::string& userId) {
+    Nakama::NMatchPresenceEvent event;
+    event.leaves.push_back({});
+    event.leaves.back().userId = userId;
+    innerListener->onMatchPresence(event);
+  }
+
+  void tickAt(double seconds) {
+    now = seconds;
+    client->tick();
+  }
+
+  std::shared_ptr<testing::NiceMock<MockRtClient>> inner;
+  std::unique_ptr<ConditionedRtClient> client;
+  Nakama::NRtClientListenerInterface* innerListener = nullptr;
+  RecordingListener listener;
+  std::vector<std::string> sent;
+  double now = 0.0;
+};
+
+NetworkConditions bothWays(const LinkConditions& link, std::uint32_t seed = 1) {
+  NetworkConditions conditions;
+  conditions.send = link;
+  conditions.receive = link;
+  conditions.seed = seed;
+  return conditions;
+}
+
+}  // namespace
+
+TEST(ConditionedRtClient, DelaysMatchDataBothWays) {
+  LinkConditions link;
+  link.latencyMs = 50.0;
+  Harness h(bothWays(link));
+  ASSERT_NE(h.innerListener, nullptr);
+
+  h.client->sendMatchData("m", 1, "up", {});
+  h.serverSends("down");
+  h.tickAt(0.049);
+  EXPECT_TRUE(h.sent.empty());
+  EXPECT_TRUE(h.listener.received.empty());
+  EXPECT_EQ(h.client->pendingSends(), 1u);
+
+  h.tickAt(0.050);
+  EXPECT_EQ(h.sent, std::vector<std::string>{"up"});
+  EXPECT_EQ(h.listener.received, std::vector<std::string>{"down"});
+  EXPECT_EQ(h.client->sendStats().delivered, 1u);
+  EXPECT_EQ(h.client->receiveStats().bytesDelivered, 4u);
+
+  // Other events are not delayed.
+  h.innerListener->onConnect();
+  EXPECT_EQ(h.listener.connects, 1);
+}
+
+TEST(ConditionedRtClient, ForwardsEverythingElse) {
+  Harness h(NetworkConditions{});
+  EXPECT_CALL(*h.inner, isConnected()).WillOnce(testing::Return(true));
+  EXPECT_CALL(*h.inner, leaveMatch("m", _, _));
+  EXPECT_CALL(*h.inner, tick());
+  EXPECT_TRUE(h.client->isConnected());
+  h.client->leaveMatch("m", nullptr, nullptr);
+
+  // Without conditions, data goes out on the next tick.
+  h.client->sendMatchData("m", 1, "x", {});
+  h.tickAt(0.0);
+  EXPECT_EQ(h.sent.size(), 1u);
+}
+
+TEST(ConditionedRtClient, LossIsRepeatableForASeed) {
+  LinkConditions link;
+  link.lossPercent = 30.0;
+  auto run = [&](std::uint32_t seed) {
+    Harness h(bothWays(link, seed));
+    for (int i = 0; i < 1000; ++i) h.client->sendMatchData("m", 1, std::to_string(i), {});
+    h.tickAt(1.0);
+    EXPECT_EQ(h.client->sendStats().dropped + h.sent.size(), 1000u);
+    return h.sent;
+  };
+  const std::vector<std::string> first = run(7);
+  EXPECT_EQ(run(7), first);
+  EXPECT_NE(run(8), first);
+  EXPECT_GT(first.size(), 620u);
+  EXPECT_LT(first.size(), 780u);
+}
+
+TEST(ConditionedRtClient, JitterKeepsOrderAndReorderingBreaksIt) {
+  LinkConditions link;
+  link.latencyMs = 40.0;
+  link.jitterMs = 30.0;
+  {
+    Harness h(bothWays(link));
+    for (int i = 0; i < 100; ++i) {
+      h.now = i * 0.005;
+      h.serverSends(std::to_string(i));
+    }
+    h.tickAt(2.0);
+    ASSERT_EQ(h.listener.received.size(), 100u);
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(h.listener.received[i], std::to_string(i));
+  }
+
+  link.reorderPercent = 20.0;
+  Harness h(bothWays(link));
+  for (int i = 0; i < 100; ++i) {
+    h.now = i * 0.005;
+    h.serverSends(std::to_string(i));
+  }
+  h.tickAt(2.0);
+  ASSERT_EQ(h.listener.received.size(), 100u);
+  int outOfOrder = 0;
+  for (std::size_t i = 1; i < h.listener.received.size(); ++i) {
+    outOfOrder += std::stoi(h.listener.received[i]) < std::stoi(h.listener.received[i - 1]);
+  }
+  EXPECT_GT(outOfOrder, 0);
+  EXPECT_GT(h.client->receiveStats().reordered, 0u);
+}
+
+TEST(ConditionedRtClient, BandwidthCapSerializesPackets) {
+  LinkConditions link;
+  link.bandwidthKbps = 8.0;  // 1000 bytes/s
+  Harness h(bothWays(link));
+  const std::string packet(100, 'x');
+  h.client->sendMatchData("m", 1, packet, {});
+  h.client->sendMatchData("m", 1, packet, {});
+
+  h.tickAt(0.099);
+  EXPECT_EQ(h.sent.size(), 0u);
+  h.tickAt(0.1);
+  EXPECT_EQ(h.sent.size(), 1u);
+  h.tickAt(0.199);
+  EXPECT_EQ(h.sent.size(), 1u);
+  h.tickAt(0.2);
+  EXPECT_EQ(h.sent.size(), 2u);
+}
+
+TEST(ConditionedRtClient, DisconnectDropsHeldPackets) {
+  LinkConditions link;
+  link.latencyMs = 100.0;
+  Harness h(bothWays(link));
+  h.client->sendMatchData("m", 1, "up", {});
+  h.serverSends("down");
+  h.client->disconnect();
+  h.tickAt(1.0);
+  EXPECT_TRUE(h.sent.empty());
+  EXPECT_TRUE(h.listener.received.empty());
+  EXPECT_EQ(h.client->sendStats().dropped, 1u);
+  EXPECT_EQ(h.client->receiveStats().dropped, 1u);
+}
+
+TEST(ConditionedRtClient, PresenceKeepsItsPlaceBehindMatchData) {
+  LinkConditions link;
+  link.latencyMs = 50.0;
+  link.jitterMs = 30.0;
+  Harness h(bothWays(link));
+  // The player's last world updates, then the leave.
+  for (int i = 0; i < 20; ++i) {
+    h.now = i * 0.001;
+    h.serverSends(std::to_string(i));
+  }
+  h.serverSendsLeave("gone");
+  h.tickAt(0.019);
+  EXPECT_TRUE(h.listener.received.empty());
+  h.tickAt(1.0);
+  ASSERT_EQ(h.listener.received.size(), 21u);
+  EXPECT_EQ(h.listener.received.back(), "leave gone");
+
+  // Presence is never lost.
+  link.lossPercent = 100.0;
+  Harness lossy(bothWays(link));
+  lossy.serverSends("update");
+  lossy.serverSendsLeave("gone");
+  lossy.tickAt(0.049);
+  EXPECT_TRUE(lossy.listener.received.empty());
+  lossy.tickAt(0.05);
+  EXPECT_EQ(lossy.listener.received, std::vector<std::string>{"leave gone"});
+}
@@ -0,0 +1,134 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "graphics/RenderCommandList.h"
+#include "world/WorldMap.h"
+#include "world/WorldRenderer.h"
+
+// Object layer with one 16x32 prop per entry of `feet` (foot Y), each at its
+// own x so the props never overlap.
+static WorldMap::LayerMesh makePropLayer(const char* name,
+                                         const std::vector<float>& feet,
+                                         const std::vector<const sf::Texture*>& textures) {
+  WorldMap::LayerMesh layer;
+  layer.type = "objectgroup";
+  layer.name = name;
+  for (std::size_t i = 0; i < feet.size(); ++i) {
+    WorldMap::LayerMesh::CellKey key{static_cast<int>(i), 0};
+    WorldMap::LayerMesh::Chunk ch;
+    ch.id = static_cast<uint32_t>(i + 1);
+    ch.texture = textures[i];
+    ch.sortY = feet[i];
+    const float x0 = static_cast<float>(i * 16), y0 = feet[i] - 32.f;
+    const float x1 = x0 + 16.f, y1 = feet[i];
+    ch.vertices.resize(6);
+    ch.vertices[0].position = {x0, y0};
+    ch.vertices[1].position = {x1, y0};
+    ch.vertices[2].position = {x1, y1};
+    ch.vertices[3].position = {x0, y0};
+    ch.vertices[4].position = {x1, y1};
+    ch.vertices[5].position = {x0, y1};
+    layer.chunk_buckets[key].chunks.push_back(std::move(ch));
+    layer.chunk_bucket_order.push_back(key);
+  }
+  return layer;
+}
+
+static sf::View wideView() {
+  return sf::View(sf::Vector2f{128.f, 128.f}, sf::Vector2f{512.f, 512.f});
+}
+
+TEST(DepthPass, ActorsInterleaveWithObjectsByFootY) {
+  sf::Texture a, b;
+  WorldMap wm;
+  wm.setTileSize(16, 16);
+  // Alternate textures so every prop is its own draw call.
+  wm.layersMutable().push_back(makePropLayer("level_0_1", {40.f, 80.f, 120.f}, {&a, &b, &a}));
+  wm.rebuildObjectDrawOrderForLayer(0);
+
+  WorldRenderer renderer(wm);
+  renderer.setDebugObjectAreas(false);
+  renderer.setDepthSorting(true);
+
+  std::vector<WorldRenderer::DepthActor> actors{{100.f, 7}, {20.f, 3}, {80.f, 5}};
+  WorldRenderer::sortDepthActors(actors);
+
+  RenderCommandList list;
+  list.setView(wideView());
+  renderer.resetStats();
+  renderer.renderDepthSorted(list, actors, [&](std::uint32_t id, RenderSink&) {
+    list.addActorMarker(id);
+  });
+
+  // Expected: actor 3 (20), prop 40, prop 80, actor 5 (80, after the tie),
+  // actor 7 (100), prop 120.
+  const auto& recs = list.records();
+  ASSERT_EQ(recs.size(), 6u);
+  EXPECT_EQ(recs[0].actor, 3u);
+  EXPECT_EQ(recs[1].texture, &a);
+  EXPECT_EQ(recs[2].texture, &b);
+  EXPECT_EQ(recs[3].actor, 5u);
+  EXPECT_EQ(recs[4].actor, 7u);
+  EXPECT_EQ(recs[5].texture, &a);
+  EXPECT_EQ(renderer.stats().actorsDrawn, 3u);
+  EXPECT_EQ(renderer.stats().chunksDrawn, 3u);
+}
+
+TEST(DepthPass, BatchesConsecutiveSameTextureObjects) {
+  sf::Texture a, b;
+  WorldMap wm;
+  wm.setTileSize(16, 16);
+  wm.layersMutable().push_back(
+      makePropLayer("level_0_1", {10.f, 20.f, 30.f, 40.f}, {&a, &a, &a, &b}));
+  wm.rebuildObjectDrawOrderForLayer(0);
+
+  WorldRenderer renderer(wm);
+  renderer.setDebugObjectAreas(false);
+  renderer.setDepthSorting(true);
+
+  NullRenderSink sink;
+  sink.setView(wideView());
+  renderer.resetStats();
+  renderer.renderDepthSorted(sink, {}, [](std::uint32_t, RenderSink&) {});
+
+  EXPECT_EQ(sink.drawCalls(), 2u);
+  EXPECT_EQ(sink.vertexCount(), 24u);
+  EXPECT_EQ(renderer.stats().chunksDrawn, 4u);
+}
+
+TEST(DepthPass, OverlaysSkipDepthSortedLayers) {
+  sf::Texture a;
+  WorldMap wm;
+  wm.setTileSize(16, 16);
+  wm.layersMutable().push_back(makePropLayer("level_0_1", {40.f}, {&a}));
+  wm.layersMutable().push_back(makePropLayer("level_1_1", {60.f}, {&a}));
+  wm.rebuildObjectDrawOrderForLayer(0);
+  wm.rebuildObjectDrawOrderForLayer(1);
+
+  WorldRenderer renderer(wm);
+  renderer.setDebugObjectAreas(false);
+  NullRenderSink sink;
+  sink.setView(wideView());
+  renderer.renderOverlays(sink);
+  EXPECT_EQ(sink.drawCalls(), 2u);
+
+  // With depth sorting on, only the upper level remains an overlay.
+  renderer.setDepthSorting(true);
+  sink.reset();
+  renderer.renderOverlays(sink);
+  EXPECT_EQ(sink.drawCalls(), 1u);
+}
+
+TEST(DepthPass, SortDepthActorsIsStableAndOrdersByFootY) {
+  std::vector<WorldRenderer::DepthActor> actors{{5.f, 0}, {1.f, 1}, {5.f, 2}, {3.f, 3}};
+  WorldRenderer::sortDepthActors(actors);
+  ASSERT_EQ(actors.size(), 4u);
+  EXPECT_EQ(actors[0].id, 1u);
+  EXPECT_EQ(actors[1].id, 3u);
+  EXPECT_EQ(actors[2].id, 0u);
+  EXPECT_EQ(actors[3].id, 2u);
+}
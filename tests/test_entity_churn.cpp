@@ -0,0 +1,167 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "graphics/FontCache.h"
+#include "graphics/TextBatch.h"
+#include "networking/IdInterner.h"
+#include "networking/Networking.h"
+#include "support/AllocationCounter.h"
+#include "world/entities/EntityStore.h"
+#include "world/entities/PlayerLayer.h"
+
+namespace {
+
+// One join/leave cycle as GameScene sees it: presence join, first state
+// update spawns, a frame is simulated and drawn, presence leave despawns.
+class ChurnFixture {
+ public:
+  ChurnFixture() : labels_(FontCache::instance().defaultFont()) {
+    for (int i = 0; i < 32; ++i) join(i, {i * 40.f, 100.f});  // residents
+  }
+
+  void cycle(int i) {
+    const PlayerHandle handle = join(1000000 + i, {i % 640 * 1.f, 300.f});
+    const EntityStore::EntityId entity = store_.find(handle);
+    store_.applyServerState(entity, {i % 640 + 5.f, 305.f}, static_cast<unsigned>(i));
+    store_.update(sf::milliseconds(16));
+
+    body_.clear();
+    labels_.clear();
+    for (std::size_t k = 0; k < store_.size(); ++k) {
+      store_.appendBody(k, body_);
+      store_.appendLabels(k, labels_);
+    }
+
+    store_.despawn(entity);
+    ids_.release(handle);
+  }
+
+  const EntityStore& store() const { return store_; }
+  const IdInterner& ids() const { return ids_; }
+
+ private:
+  PlayerHandle join(int n, sf::Vector2f position) {
+    // Nakama user ids are UUIDs, well past the small-string buffer.
+    char userId[40];
+    std::snprintf(userId, sizeof(userId), "%08x-4e2a-4c1b-9f3d-%012d", n, n);
+    const PlayerHandle handle = ids_.intern(userId);
+    store_.spawn(handle, ids_.name(handle), position);
+    return handle;
+  }
+
+  IdInterner ids_;
+  EntityStore store_;
+  TextBatch labels_;
+  std::vector<sf::Vertex> body_;
+};
+
+// The same lifecycle through the real message path: presence and
+// world_update events go through Networking into GameScene's PlayerLayer.
+// Events are built up front, so only the client's own work is measured.
+class NetworkChurnFixture {
+ public:
+  static constexpr int kIds = 640;
+
+  NetworkChurnFixture() : networking_(nullptr), listener_(&networking_) {
+    networking_.setPlayerStateUpdateCallback(
+        [this](PlayerHandle player, const sf::Vector2f& position, unsigned int seq) {
+          layer_.applyServerState(player, networking_.playerIds().name(player), position, seq);
+        });
+    networking_.setPresenceCallback([this](PlayerHandle player, bool joined) {
+      if (!joined) layer_.despawn(player);
+    });
+    events_.resize(kIds);
+    for (int i = 0; i < kIds; ++i) {
+      char userId[40];
+      std::snprintf(userId, sizeof(userId), "%08x-4e2a-4c1b-9f3d-%012d", i, i);
+      Event& event = events_[i];
+      event.join.joins.push_back(Nakama::NUserPresence{});
+      event.join.joins.back().userId = userId;
+      event.leave.leaves = event.join.joins;
+      const std::string update = std::string(R"({"type":"world_update","data":{"players":{")") +
+                                 userId + R"(":{"position":{"x":)" + std::to_string(i) +
+                                 R"(,"y":300}}}}})";
+      event.update.opCode = 2;
+      event.update.data.assign(update.begin(), update.end());
+    }
+  }
+
+  void cycle(int i) {
+    const Event& event = events_[i % kIds];
+    listener_.onMatchPresence(event.join);
+    listener_.onMatchData(event.update);
+    layer_.update(sf::milliseconds(16), view_);
+    listener_.onMatchPresence(event.leave);
+    // A late update after the leave is dropped, not a respawn.
+    listener_.onMatchData(event.update);
+  }
+
+  const PlayerLayer& layer() const { return layer_; }
+  const Networking& networking() const { return networking_; }
+
+ private:
+  struct Event {
+    Nakama::NMatchPresenceEvent join, leave;
+    Nakama::NMatchData update;
+  };
+
+  Networking networking_;
+  InternalRtListener listener_;
+  PlayerLayer layer_;
+  std::vector<Event> events_;
+  const sf::View view_{sf::Vector2f{320.f, 300.f}, sf::Vector2f{640.f, 480.f}};
+};
+
+}  // namespace
+
+TEST(EntityChurn, TenThousandJoinLeaveCyclesKeepMemoryFlat) {
+  ChurnFixture fixture;
+  // Warm the pools; one full sweep of positions also creates every grid
+  // cell the churn will touch.
+  for (int i = 0; i < 640; ++i) fixture.cycle(i);
+
+  const auto before = AllocationCounter::snapshot();
+  for (int i = 640; i < 10640; ++i) fixture.cycle(i);
+  const auto after = AllocationCounter::snapshot();
+
+  EXPECT_EQ(after.liveBytes, before.liveBytes);
+  EXPECT_EQ(after.allocations - before.allocations, 0u);
+  EXPECT_EQ(fixture.store().size(), 32u);
+  EXPECT_EQ(fixture.ids().size(), 32u);
+}
+
+TEST(EntityChurn, RespawnFromPoolStartsClean) {
+  EntityStore store;
+  const auto a = store.spawn(0, "alice", {10.f, 10.f}, sf::Color::Blue, 20.f);
+  store.applyServerState(a, {12.f, 10.f}, 9);
+  store.update(sf::seconds(1.f));
+  store.despawn(a);
+  EXPECT_EQ(store.pooled(), 1u);
+
+  const auto b = store.spawn(1, "bob", {50.f, 60.f});
+  EXPECT_EQ(store.pooled(), 0u);
+  const std::size_t i = store.indexOf(b);
+  EXPECT_EQ(store.names()[i], "bob");
+  EXPECT_FLOAT_EQ(store.radius(i), 15.f);
+  EXPECT_TRUE(store.debugText(i).empty());
+  EXPECT_EQ(store.positions()[i], sf::Vector2f(50.f, 60.f));
+}
+
+TEST(EntityChurn, JoinLeaveThroughNetworkingKeepsMemoryFlat) {
+  NetworkChurnFixture fixture;
+  for (int i = 0; i < NetworkChurnFixture::kIds; ++i) fixture.cycle(i);
+
+  const auto before = AllocationCounter::snapshot();
+  for (int i = 0; i < 10000; ++i) fixture.cycle(i);
+  const auto after = AllocationCounter::snapshot();
+
+  EXPECT_EQ(after.liveBytes, before.liveBytes);
+  EXPECT_EQ(after.allocations - before.allocations, 0u);
+  EXPECT_TRUE(fixture.layer().remotePlayers().empty());
+  EXPECT_EQ(fixture.networking().playerIds().size(), 0u);
+}
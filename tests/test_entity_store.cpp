@@ -0,0 +1,125 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "world/entities/EntityStore.h"
+
+TEST(EntityStore, SpawnFindAndApplyServerState) {
+  EntityStore store;
+  const auto a = store.spawn(0, "alice", {10.f, 20.f});
+  const auto b = store.spawn(5, "bob", {30.f, 40.f});
+  ASSERT_NE(a, b);
+  EXPECT_EQ(store.size(), 2u);
+  EXPECT_EQ(store.find(0), a);
+  EXPECT_EQ(store.find(5), b);
+  EXPECT_EQ(store.find(3), EntityStore::kInvalidEntity);
+  EXPECT_EQ(store.find(99), EntityStore::kInvalidEntity);
+
+  InterpolationSettings noDelay;
+  noDelay.delay = 0.0;
+  store.setInterpolation(noDelay);
+  store.applyServerState(b, {35.f, 45.f}, 7);
+  const std::size_t ib = store.indexOf(b);
+  EXPECT_EQ(store.history(ib).newest().position, sf::Vector2f(35.f, 45.f));
+  store.update(sf::Time::Zero);
+  EXPECT_EQ(store.positions()[ib], sf::Vector2f(35.f, 45.f));
+  EXPECT_EQ(store.names()[ib], "bob");
+  EXPECT_EQ(store.handles()[ib], 5u);
+  EXPECT_FLOAT_EQ(store.sortY(ib), 45.f + store.radius(ib));
+}
+
+TEST(EntityStore, DespawnKeepsOtherIdsValidAndReusesSlots) {
+  EntityStore store;
+  const auto a = store.spawn(0, "a", {1.f, 0.f});
+  const auto b = store.spawn(1, "b", {2.f, 0.f});
+  const auto c = store.spawn(2, "c", {3.f, 0.f});
+
+  store.despawn(a);
+  EXPECT_FALSE(store.alive(a));
+  EXPECT_EQ(store.find(0), EntityStore::kInvalidEntity);
+  ASSERT_EQ(store.size(), 2u);
+  // The last entity was swapped into the hole; lookups still resolve.
+  EXPECT_EQ(store.positions()[store.indexOf(b)].x, 2.f);
+  EXPECT_EQ(store.positions()[store.indexOf(c)].x, 3.f);
+  EXPECT_EQ(store.names()[store.indexOf(c)], "c");
+  EXPECT_EQ(store.find(2), c);
+
+  const auto d = store.spawn(3, "d", {4.f, 0.f});
+  EXPECT_EQ(d, a);  // freed id is reused
+  EXPECT_EQ(store.positions()[store.indexOf(d)].x, 4.f);
+
+  store.clear();
+  EXPECT_TRUE(store.empty());
+  EXPECT_EQ(store.find(1), EntityStore::kInvalidEntity);
+}
+
+TEST(EntityStore, VelocityIsEstimatedFromServerUpdates) {
+  EntityStore store;
+  const auto e = store.spawn(0, "e", {0.f, 0.f});
+  store.update(sf::seconds(0.05f));
+  store.applyServerState(e, {5.f, -2.5f}, 1);
+  const sf::Vector2f v = store.velocities()[store.indexOf(e)];
+  EXPECT_NEAR(v.x, 100.f, 1e-3f);
+  EXPECT_NEAR(v.y, -50.f, 1e-3f);
+}
+
+TEST(EntityStore, SweepRefreshesDebugText) {
+  EntityStore store;
+  const auto e = store.spawn(0, "e", {12.f, 34.f});
+  store.applyServerState(e, {12.f, 34.f}, 3);
+  store.update(sf::seconds(1.f));
+  const std::string& text = store.debugText(store.indexOf(e));
+  EXPECT_NE(text.find("SrvPos: (12,34)"), std::string::npos);
+  EXPECT_NE(text.find("Ack: 3"), std::string::npos);
+}
+
+TEST(EntityStore, BodyIsEmittedAsTriangles) {
+  EntityStore store;
+  const auto e = store.spawn(0, "e", {100.f, 50.f}, sf::Color::Red, 10.f);
+  std::vector<sf::Vertex> out;
+  store.appendBody(store.indexOf(e), out);
+  ASSERT_EQ(out.size() % 3, 0u);
+  ASSERT_FALSE(out.empty());
+  for (const auto& v : out) {
+    const sf::Vector2f d = v.position - sf::Vector2f(100.f, 50.f);
+    EXPECT_LE(d.x * d.x + d.y * d.y, 100.f + 1e-3f);
+    EXPECT_EQ(v.color, sf::Color::Red);
+  }
+}
+
+TEST(EntityStore, EntitiesOutsideInterestUseTheCheapTier) {
+  EntityStore store;
+  InterpolationSettings s;
+  s.delay = 0.1;
+  store.setInterpolation(s);
+  const auto near = store.spawn(0, "near", {50.f, 50.f});
+  const auto far = store.spawn(1, "far", {5000.f, 50.f});
+  store.setInterestRect({{0.f, 0.f}, {800.f, 600.f}});
+
+  store.update(sf::seconds(0.05f));
+  store.applyServerState(near, {60.f, 50.f}, 1);
+  store.applyServerState(far, {5010.f, 50.f}, 1);
+  store.update(sf::seconds(0.05f));
+
+  const std::size_t in = store.indexOf(near);
+  const std::size_t out = store.indexOf(far);
+  EXPECT_TRUE(store.inInterest(in));
+  EXPECT_FALSE(store.inInterest(out));
+  // Visible entities render behind by the delay; the rest hold the newest
+  // server position.
+  EXPECT_LT(store.positions()[in].x, 60.f);
+  EXPECT_EQ(store.positions()[out].x, 5010.f);
+
+  // Walking into the rect promotes the entity on the next sweep.
+  store.applyServerState(far, {700.f, 50.f}, 2);
+  store.update(sf::seconds(0.05f));
+  store.update(sf::seconds(0.05f));
+  EXPECT_TRUE(store.inInterest(store.indexOf(far)));
+
+  store.clearInterestRect();
+  store.applyServerState(far, {5000.f, 50.f}, 3);
+  store.update(sf::seconds(0.05f));
+  EXPECT_TRUE(store.inInterest(store.indexOf(far)));
+}
@@ -0,0 +1,55 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+
+#include "networking/IdInterner.h"
+
+TEST(IdInterner, AssignsDenseStableHandles) {
+  IdInterner ids;
+  const PlayerHandle a = ids.intern("3f2c-alice");
+  const PlayerHandle b = ids.intern("9d41-bob");
+  EXPECT_EQ(a, 0u);
+  EXPECT_EQ(b, 1u);
+  EXPECT_EQ(ids.intern("3f2c-alice"), a);
+  EXPECT_EQ(ids.size(), 2u);
+  EXPECT_EQ(ids.name(a), "3f2c-alice");
+  EXPECT_EQ(ids.name(b), "9d41-bob");
+  EXPECT_TRUE(ids.name(42).empty());
+}
+
+TEST(IdInterner, FindDoesNotInsert) {
+  IdInterner ids;
+  ids.intern("known");
+  // Lookup from a view into a larger buffer, as the decoder does.
+  const std::string packet = "xxknownxx";
+  EXPECT_EQ(ids.find(std::string_view(packet).substr(2, 5)), 0u);
+  EXPECT_EQ(ids.find("unknown"), kInvalidPlayerHandle);
+  EXPECT_EQ(ids.size(), 1u);
+}
+
+TEST(IdInterner, ClearForgetsHandles) {
+  IdInterner ids;
+  ids.intern("a");
+  ids.clear();
+  EXPECT_EQ(ids.find("a"), kInvalidPlayerHandle);
+  EXPECT_EQ(ids.intern("b"), 0u);
+}
+
+TEST(IdInterner, ReleasedHandlesAreReused) {
+  IdInterner ids;
+  const PlayerHandle a = ids.intern("alice");
+  const PlayerHandle b = ids.intern("bob");
+  ids.release(a);
+  EXPECT_EQ(ids.find("alice"), kInvalidPlayerHandle);
+  EXPECT_TRUE(ids.name(a).empty());
+  EXPECT_EQ(ids.size(), 1u);
+  ids.release(a);  // twice is harmless
+
+  const PlayerHandle c = ids.intern("carol");
+  EXPECT_EQ(c, a);
+  EXPECT_EQ(ids.name(c), "carol");
+  EXPECT_EQ(ids.find("carol"), c);
+  EXPECT_EQ(ids.find("bob"), b);
+}
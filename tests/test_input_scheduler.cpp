@@ -0,0 +1,99 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "networking/InputScheduler.h"
+
+namespace {
+
+const sf::Time kFrame = sf::seconds(1.f / 60.f);
+
+struct Recorder {
+  unsigned int sequence = 0;
+  std::vector<std::vector<wire::PlayerInput>> packets;
+
+  // Runs `frames` frames with the intent given per frame index.
+  template <typename Intent>
+  void run(InputScheduler& scheduler, int frames, Intent intent) {
+    for (int f = 0; f < frames; ++f) {
+      scheduler.sample(intent(f));
+      if (scheduler.update(kFrame, [this] { return ++sequence; })) {
+        const auto packet = scheduler.packet();
+        packets.emplace_back(packet.begin(), packet.end());
+      }
+    }
+  }
+};
+
+}  // namespace
+
+TEST(InputScheduler, HeldDirectionIsSentOnceAndRepeatedForRedundancy) {
+  InputScheduler scheduler;  // 20 Hz, redundancy 2
+  Recorder rec;
+  rec.run(scheduler, 60, [](int) { return sf::Vector2f(100.f, 0.f); });
+
+  // One input, sent on its tick and resent on the next two.
+  EXPECT_EQ(scheduler.inputsCommitted(), 1u);
+  ASSERT_EQ(rec.packets.size(), 3u);
+  for (const auto& packet : rec.packets) {
+    ASSERT_EQ(packet.size(), 1u);
+    EXPECT_EQ(packet[0].sequence, 1u);
+    EXPECT_EQ(packet[0].velocity, sf::Vector2f(100.f, 0.f));
+  }
+}
+
+TEST(InputScheduler, SteeringEveryFrameIsCappedAtTheSendRate) {
+  InputScheduler scheduler;
+  Recorder rec;
+  rec.run(scheduler, 120, [](int f) {
+    const float a = f * 0.05f;
+    return sf::Vector2f(std::cos(a), std::sin(a)) * 100.f;
+  });
+
+  // Two seconds at 20 Hz; the intent changed every frame.
+  EXPECT_LE(rec.packets.size(), 41u);
+  EXPECT_GE(rec.packets.size(), 39u);
+  EXPECT_EQ(scheduler.inputsCommitted(), rec.packets.size());
+  const auto& last = rec.packets.back();
+  ASSERT_EQ(last.size(), 3u);  // newest plus two earlier inputs
+  EXPECT_EQ(last[0].sequence + 1, last[1].sequence);
+  EXPECT_EQ(last[1].sequence + 1, last[2].sequence);
+  EXPECT_EQ(last[2].sequence, rec.sequence);
+}
+
+TEST(InputScheduler, SmallWobbleMergesIntoTheSameInput) {
+  InputSchedulerSettings settings;
+  settings.mergeTolerance = 2.f;
+  InputScheduler scheduler(settings);
+  Recorder rec;
+  rec.run(scheduler, 60, [](int f) { return sf::Vector2f(100.f + (f % 2), 0.f); });
+  EXPECT_EQ(scheduler.inputsCommitted(), 1u);
+}
+
+TEST(InputScheduler, StoppingSendsAZeroInput) {
+  InputScheduler scheduler;
+  Recorder rec;
+  rec.run(scheduler, 30, [](int f) { return f < 10 ? sf::Vector2f(0.f, 50.f) : sf::Vector2f(); });
+  EXPECT_EQ(scheduler.inputsCommitted(), 2u);
+  ASSERT_FALSE(rec.packets.empty());
+  EXPECT_EQ(rec.packets.back().back().velocity, sf::Vector2f());
+  EXPECT_EQ(rec.packets.back().back().sequence, 2u);
+
+  // Standing still from the start sends nothing.
+  InputScheduler idle;
+  Recorder idleRec;
+  idleRec.run(idle, 60, [](int) { return sf::Vector2f(); });
+  EXPECT_TRUE(idleRec.packets.empty());
+}
+
+TEST(InputScheduler, LongFramesDoNotBurst) {
+  InputScheduler scheduler;
+  unsigned int sequence = 0;
+  scheduler.sample({100.f, 0.f});
+  EXPECT_TRUE(scheduler.update(sf::seconds(1.f), [&] { return ++sequence; }));
+  scheduler.sample({0.f, 100.f});
+  EXPECT_FALSE(scheduler.update(sf::milliseconds(1), [&] { return ++sequence; }));
+}
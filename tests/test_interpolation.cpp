@@ -0,0 +1,79 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include "world/entities/EntityStore.h"
+#include "world/entities/InterpolationBuffer.h"
+
+namespace {
+
+InterpolationSettings linear() {
+  InterpolationSettings s;
+  s.mode = InterpolationSettings::Mode::Linear;
+  return s;
+}
+
+}  // namespace
+
+TEST(InterpolationBuffer, LinearSampleBetweenSnapshots) {
+  InterpolationBuffer buffer;
+  buffer.push(0.0, {0.f, 0.f});
+  buffer.push(0.1, {10.f, 20.f});
+  const sf::Vector2f p = buffer.sample(0.05, linear());
+  EXPECT_NEAR(p.x, 5.f, 1e-4f);
+  EXPECT_NEAR(p.y, 10.f, 1e-4f);
+  // Before the oldest snapshot the oldest position is held.
+  EXPECT_EQ(buffer.sample(-1.0, linear()), sf::Vector2f(0.f, 0.f));
+}
+
+TEST(InterpolationBuffer, HermiteIsExactForConstantVelocity) {
+  InterpolationBuffer buffer;
+  for (int i = 0; i < 5; ++i) buffer.push(i * 0.1, {i * 10.f, i * -5.f});
+  InterpolationSettings hermite;
+  const sf::Vector2f p = buffer.sample(0.25, hermite);
+  EXPECT_NEAR(p.x, 25.f, 1e-3f);
+  EXPECT_NEAR(p.y, -12.5f, 1e-3f);
+}
+
+TEST(InterpolationBuffer, ExtrapolationIsCapped) {
+  InterpolationBuffer buffer;
+  buffer.push(0.0, {0.f, 0.f});
+  buffer.push(1.0, {100.f, 0.f});
+  InterpolationSettings s;
+  s.maxExtrapolation = 0.2;
+  EXPECT_NEAR(buffer.sample(1.1, s).x, 110.f, 1e-3f);
+  EXPECT_NEAR(buffer.sample(5.0, s).x, 120.f, 1e-3f);
+}
+
+TEST(InterpolationBuffer, StalePushIsDroppedAndSameTimeReplaces) {
+  InterpolationBuffer buffer;
+  EXPECT_TRUE(buffer.push(1.0, {1.f, 0.f}));
+  EXPECT_FALSE(buffer.push(0.5, {9.f, 0.f}));
+  EXPECT_TRUE(buffer.push(1.0, {2.f, 0.f}));
+  ASSERT_EQ(buffer.size(), 1u);
+  EXPECT_EQ(buffer.newest().position, sf::Vector2f(2.f, 0.f));
+}
+
+TEST(InterpolationBuffer, RingKeepsNewestSnapshots) {
+  InterpolationBuffer buffer;
+  const int total = static_cast<int>(InterpolationBuffer::kCapacity) + 8;
+  for (int i = 0; i < total; ++i) buffer.push(i, {static_cast<float>(i), 0.f});
+  ASSERT_EQ(buffer.size(), InterpolationBuffer::kCapacity);
+  EXPECT_EQ(buffer.at(0).position.x, 8.f);
+  EXPECT_EQ(buffer.newest().position.x, static_cast<float>(total - 1));
+}
+
+TEST(InterpolationBuffer, EntityStoreRendersBehindByDelay) {
+  EntityStore store;
+  InterpolationSettings s = linear();
+  s.delay = 0.1;
+  store.setInterpolation(s);
+  const auto e = store.spawn(0, "e", {0.f, 0.f});
+  for (int i = 1; i <= 4; ++i) {
+    store.update(sf::seconds(0.05f));
+    store.applyServerState(e, {i * 5.f, 0.f}, i);
+  }
+  // Clock is at 0.2 s with the newest snapshot at x=20; rendering at 0.1 s.
+  store.update(sf::Time::Zero);
+  EXPECT_NEAR(store.positions()[store.indexOf(e)].x, 10.f, 1e-3f);
+}
@@ -0,0 +1,86 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+#include "networking/JsonScanner.h"
+
+TEST(JsonScanner, ReadsMembersAsViewsIntoTheInput) {
+  const std::string text = R"( {"name": "alice", "x": -1.5e1, "tags": [1, {"a": null}], "y": 2} )";
+  JsonScanner s(text);
+  ASSERT_TRUE(s.enterObject());
+
+  std::string_view key, name, tags;
+  float x = 0.f, y = 0.f;
+  ASSERT_TRUE(s.nextKey(key));
+  EXPECT_EQ(key, "name");
+  ASSERT_TRUE(s.readString(name));
+  EXPECT_EQ(name, "alice");
+  EXPECT_GE(name.data(), text.data());
+  EXPECT_LT(name.data(), text.data() + text.size());
+
+  ASSERT_TRUE(s.nextKey(key));
+  EXPECT_EQ(key, "x");
+  ASSERT_TRUE(s.readNumber(x));
+  EXPECT_FLOAT_EQ(x, -15.f);
+
+  ASSERT_TRUE(s.nextKey(key));
+  EXPECT_EQ(key, "tags");
+  ASSERT_TRUE(s.skipValue(&tags));
+  EXPECT_EQ(tags, R"([1, {"a": null}])");
+
+  ASSERT_TRUE(s.nextKey(key));
+  EXPECT_EQ(s.peek(), '2');
+  ASSERT_TRUE(s.readNumber(y));
+  EXPECT_FLOAT_EQ(y, 2.f);
+
+  EXPECT_FALSE(s.nextKey(key));
+  EXPECT_TRUE(s.ok());
+}
+
+TEST(JsonScanner, NestedObjectsAndEmptyObjects) {
+  JsonScanner s(R"({"a":{},"b":{"c":1},"d":true})");
+  std::string_view key;
+  ASSERT_TRUE(s.enterObject());
+  ASSERT_TRUE(s.nextKey(key));
+  ASSERT_TRUE(s.enterObject());
+  EXPECT_FALSE(s.nextKey(key));
+  ASSERT_TRUE(s.nextKey(key));
+  EXPECT_EQ(key, "b");
+  ASSERT_TRUE(s.enterObject());
+  ASSERT_TRUE(s.nextKey(key));
+  ASSERT_TRUE(s.skipValue());
+  EXPECT_FALSE(s.nextKey(key));
+  ASSERT_TRUE(s.nextKey(key));
+  EXPECT_EQ(key, "d");
+  ASSERT_TRUE(s.skipValue());
+  EXPECT_FALSE(s.nextKey(key));
+  EXPECT_TRUE(s.ok());
+}
+
+TEST(JsonScanner, EscapedStringsAreReportedRaw) {
+  JsonScanner s(R"({"a\"b": "c\\"})");
+  std::string_view key, value;
+  ASSERT_TRUE(s.enterObject());
+  ASSERT_TRUE(s.nextKey(key));
+  EXPECT_EQ(key, R"(a\"b)");
+  EXPECT_TRUE(s.lastStringEscaped());
+  ASSERT_TRUE(s.readString(value));
+  EXPECT_EQ(value, R"(c\\)");
+  EXPECT_FALSE(s.nextKey(key));
+  EXPECT_TRUE(s.ok());
+}
+
+TEST(JsonScanner, MalformedInputFailsWithoutReadingPastTheEnd) {
+  for (const char* text : {R"({"a":1 "b":2})", R"({"a":)", R"({"a)", R"({"a":"x\)",
+                           R"({"a":[1,2})", "", "[]"}) {
+    JsonScanner s(text);
+    std::string_view key;
+    if (s.enterObject()) {
+      while (s.nextKey(key)) s.skipValue();
+    }
+    EXPECT_FALSE(s.ok()) << text;
+  }
+}
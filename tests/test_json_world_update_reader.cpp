@@ -0,0 +1,66 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "networking/JsonWorldUpdateReader.h"
+
+TEST(JsonWorldUpdateReader, MatchesTheDomForAnEncodedSnapshot) {
+  nlohmann::json players = nlohmann::json::object();
+  for (int i = 0; i < 50; ++i) {
+    char id[40];
+    std::snprintf(id, sizeof(id), "%08x-4e2a-4c1b-9f3d-%012d", i * 2654435761u, i);
+    players[id] = {{"position", {{"x", i * 13.37f}, {"y", -i * 0.5f}}}, {"hp", 100}};
+  }
+  const std::string text =
+      nlohmann::json{{"type", "world_update"}, {"data", {{"players", players}}}}.dump(2);
+
+  JsonWorldUpdateReader reader(text);
+  ASSERT_TRUE(reader.isWorldUpdate());
+  JsonWorldUpdateReader::Entry entry;
+  std::size_t n = 0;
+  while (reader.next(entry)) {
+    const auto& expected = players.at(std::string(entry.userId))["position"];
+    EXPECT_FLOAT_EQ(entry.position.x, expected["x"].get<float>());
+    EXPECT_FLOAT_EQ(entry.position.y, expected["y"].get<float>());
+    ++n;
+  }
+  EXPECT_TRUE(reader.ok());
+  EXPECT_EQ(n, players.size());
+}
+
+TEST(JsonWorldUpdateReader, OtherTypesAndOddShapesYieldNothing) {
+  JsonWorldUpdateReader::Entry entry;
+  for (const char* text :
+       {R"({"type":"input_ack","data":{"players":{"a":{"position":{"x":1}}}}})",
+        R"({"type":"world_update"})", R"({"type":"world_update","data":[]})",
+        R"({"type":"world_update","data":{"players":[]}})"}) {
+    JsonWorldUpdateReader reader(text);
+    EXPECT_FALSE(reader.next(entry)) << text;
+    EXPECT_TRUE(reader.ok()) << text;
+  }
+
+  JsonWorldUpdateReader truncated(R"({"type":"world_update","data":{"players":{"a":{"posi)");
+  EXPECT_FALSE(truncated.ok());
+  EXPECT_FALSE(truncated.next(entry));
+}
+
+TEST(JsonWorldUpdateReader, MissingAxesDefaultToZero) {
+  JsonWorldUpdateReader reader(
+      R"({"type":"world_update","data":{"players":{"a":{"position":{"y":2}},)"
+      R"("b":{"position":{"x":"bad","y":3}}}}})");
+  JsonWorldUpdateReader::Entry entry;
+  ASSERT_TRUE(reader.next(entry));
+  EXPECT_EQ(entry.userId, "a");
+  EXPECT_EQ(entry.position, sf::Vector2f(0.f, 2.f));
+  ASSERT_TRUE(reader.next(entry));
+  EXPECT_EQ(entry.userId, "b");
+  EXPECT_EQ(entry.position, sf::Vector2f(0.f, 3.f));
+  EXPECT_FALSE(reader.next(entry));
+  EXPECT_TRUE(reader.ok());
+}
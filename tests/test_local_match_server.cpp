@@ -0,0 +1,286 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mocks/MockNClientFull.h"
+#include "networking/InputScheduler.h"
+#include "networking/Networking.h"
+#include "support/LocalMatchServer.h"
+#include "world/entities/ClientPrediction.h"
+#include "world/entities/Player.h"
+
+namespace {
+
+// A full Networking client of a LocalMatchServer, recording what it hears.
+struct SimClient {
+  SimClient(LocalMatchServer& server, const std::string& userId)
+      : session(std::make_shared<LocalSession>(userId)),
+        networking(std::make_shared<testing::NiceMock<MockNClientFull>>()) {
+    EXPECT_TRUE(networking.initialize(session));
+    networking.setRtClientFactory([&server] { return server.createClient(); });
+    networking.setPlayerStateUpdateCallback(
+        [this](PlayerHandle player, const sf::Vector2f& position, unsigned int) {
+          positions[networking.playerIds().name(player)] = position;
+        });
+    networking.setPresenceCallback([this](PlayerHandle player, bool joined) {
+      const std::string& id = networking.playerIds().name(player);
+      if (joined) {
+        present[id] = true;
+      } else {
+        present.erase(id);
+        positions.erase(id);
+      }
+    });
+    networking.setInputAckCallback([this](PlayerHandle, const wire::InputAck& ack) {
+      acks.push_back(ack.sequence);
+      if (prediction) prediction->reconcile(ack.sequence, ack.approved, ack.position);
+    });
+    networking.setObjectUpdateCallback(
+        [this](const wire::ObjectUpdate& update) { objects.push_back(update); });
+    networking.joinMatch(server.matchId(), [this](bool ok) { joined = ok; });
+  }
+
+  void steer(sf::Vector2f velocity) {
+    ++sequence;
+    networking.sendPlayerUpdate(velocity, 1.f, sequence);
+  }
+
+  std::shared_ptr<LocalSession> session;
+  Networking networking;
+  bool joined = false;
+  unsigned int sequence = 0;
+  std::map<std::string, sf::Vector2f> positions;
+  std::map<std::string, bool> present;
+  std::vector<std::uint32_t> acks;
+  std::vector<wire::ObjectUpdate> objects;
+  ClientPrediction* prediction = nullptr;
+};
+
+// Server ticks, each followed by a network tick of every client.
+void run(LocalMatchServer& server, std::vector<std::unique_ptr<SimClient>>& clients,
+         int ticks) {
+  for (int i = 0; i < ticks; ++i) {
+    server.step();
+    for (auto& client : clients) client->networking.tick();
+  }
+}
+
+std::vector<std::unique_ptr<SimClient>> connect(LocalMatchServer& server, int count) {
+  std::vector<std::unique_ptr<SimClient>> clients;
+  for (int i = 0; i < count; ++i) {
+    clients.push_back(std::make_unique<SimClient>(server, "player" + std::to_string(i)));
+  }
+  run(server, clients, 4);
+  return clients;
+}
+
+}  // namespace
+
+TEST(LocalMatchServer, ClientsJoinSeeEachOtherAndGetAcks) {
+  LocalMatchServer server;
+  auto clients = connect(server, 2);
+  SimClient& a = *clients[0];
+  SimClient& b = *clients[1];
+  ASSERT_TRUE(a.joined);
+  ASSERT_TRUE(b.joined);
+  EXPECT_EQ(server.playerCount(), 2u);
+  EXPECT_TRUE(a.present.count("player1"));
+  EXPECT_TRUE(b.present.count("player0"));
+  // Offered binary and snapshots at join, so that is what they got.
+  EXPECT_EQ(a.networking.wireFormat(), Networking::WireFormat::Binary);
+  EXPECT_GT(a.networking.snapshots().latestId(), 0u);
+
+  a.steer({100.f, 0.f});
+  run(server, clients, 20);  // one second at 20 Hz
+  EXPECT_EQ(a.acks, std::vector<std::uint32_t>{1});
+
+  LocalMatchServer::Player player;
+  ASSERT_TRUE(server.findPlayer("player0", player));
+  EXPECT_EQ(player.lastSequence, 1u);
+  EXPECT_NEAR(player.position.x, 200.f, 1e-3f);
+  EXPECT_NEAR(b.positions["player0"].x, player.position.x, 0.5f / wire::kPositionScale);
+
+  clients.pop_back();  // b leaves
+  run(server, clients, 2);
+  EXPECT_EQ(server.playerCount(), 1u);
+  EXPECT_FALSE(a.present.count("player1"));
+}
+
+TEST(LocalMatchServer, SpeaksJsonWhenBinaryIsOff) {
+  LocalMatchServer::Settings settings;
+  settings.binary = false;
+  LocalMatchServer server(settings);
+  auto clients = connect(server, 2);
+  SimClient& a = *clients[0];
+
+  a.steer({0.f, 50.f});
+  run(server, clients, 10);
+  EXPECT_EQ(a.networking.wireFormat(), Networking::WireFormat::Json);
+  EXPECT_EQ(a.acks, std::vector<std::uint32_t>{1});
+  EXPECT_NEAR(clients[1]->positions["player0"].y, 125.f, 1e-3f);
+  EXPECT_EQ(server.stats().malformed, 0u);
+}
+
+TEST(LocalMatchServer, ClampsSpeedAndRejectsTheInput) {
+  LocalMatchServer server;
+  auto clients = connect(server, 1);
+  std::vector<bool> verdicts;
+  clients[0]->networking.setInputAckCallback(
+      [&](PlayerHandle, const wire::InputAck& ack) { verdicts.push_back(ack.approved); });
+
+  clients[0]->steer({1000.f, 0.f});
+  run(server, clients, 20);
+  EXPECT_EQ(verdicts, std::vector<bool>{false});
+  LocalMatchServer::Player player;
+  ASSERT_TRUE(server.findPlayer("player0", player));
+  EXPECT_NEAR(player.position.x, 100.f + server.settings().maxSpeed, 1e-3f);
+}
+
+TEST(LocalMatchServer, BroadcastsObjectInteractions) {
+  LocalMatchServer server;
+  auto clients = connect(server, 3);
+  EXPECT_TRUE(server.objectVisible(42));
+
+  clients[2]->networking.sendPlayerAction(42, "interact", 1);
+  run(server, clients, 1);
+  EXPECT_FALSE(server.objectVisible(42));
+  for (const auto& client : clients) {
+    ASSERT_EQ(client->objects.size(), 1u);
+    EXPECT_EQ(client->objects[0].objectId, 42u);
+    EXPECT_TRUE(client->objects[0].fields & wire::ObjectUpdate::kVisible);
+    EXPECT_FALSE(client->objects[0].visible);
+  }
+  EXPECT_EQ(server.stats().actions, 1u);
+}
+
+TEST(LocalMatchServer, AnswersPings) {
+  LocalMatchServer server;
+  auto clients = connect(server, 1);
+  server.advance(10.0);
+  run(server, clients, 2);
+  const ClockSync& clock = clients[0]->networking.clockSync();
+  EXPECT_TRUE(clock.synced());
+  EXPECT_GT(clients[0]->networking.networkStats().opcodes[opcode::kPing].messagesIn, 0u);
+}
+
+TEST(LocalMatchServer, PredictionMatchesTheServer) {
+  LocalMatchServer server;
+  auto clients = connect(server, 1);
+  SimClient& client = *clients[0];
+  ClientPrediction prediction;
+  prediction.reset(server.settings().spawn);
+  client.prediction = &prediction;
+
+  // The client frame rate is not the server's, and inputs change between
+  // server ticks; after the last ack the prediction is exact.
+  const float frame = 1.f / 60.f;
+  const std::vector<sf::Vector2f> velocities = {
+      {120.f, 0.f}, {0.f, -80.f}, {-150.f, 150.f}, {0.f, 0.f}, {60.f, 30.f}, {0.f, 0.f}};
+  int frames = 0;
+  for (const sf::Vector2f& velocity : velocities) {
+    client.steer(velocity);
+    for (int i = 0; i < 37; ++i, ++frames) {
+      prediction.step({client.sequence, velocity, frame});
+      // Three client frames per server tick.
+      if (frames % 3 == 2) run(server, clients, 1);
+    }
+  }
+  run(server, clients, 5);
+
+  LocalMatchServer::Player player;
+  ASSERT_TRUE(server.findPlayer("player0", player));
+  EXPECT_EQ(client.acks.back(), client.sequence);
+  EXPECT_NEAR(prediction.predicted().x, player.position.x, 0.5f);
+  EXPECT_NEAR(prediction.predicted().y, player.position.y, 0.5f);
+}
+
+TEST(LocalMatchServer, SchedulerBatchedInputPredictsWithoutCorrections) {
+  LocalMatchServer server;
+  auto clients = connect(server, 1);
+  SimClient& client = *clients[0];
+  Player player("player0", sf::Color::Green, true);
+  player.setPosition(server.settings().spawn);
+
+  // The jump an ack makes to the prediction is the correction the player sees.
+  float largestCorrection = 0.f;
+  client.networking.setInputAckCallback([&](PlayerHandle, const wire::InputAck& ack) {
+    client.acks.push_back(ack.sequence);
+    const sf::Vector2f before = player.getPosition();
+    player.handleServerAck(ack.sequence, ack.approved, ack.position);
+    largestCorrection = std::max(largestCorrection, (player.getPosition() - before).length());
+  });
+
+  // Driven the way GameScene does it: the direction changes on arbitrary
+  // frames, the scheduler commits it on its own 20 Hz tick, and the player
+  // predicts with the committed input.
+  InputScheduler scheduler;
+  const sf::Time frame = sf::seconds(1.f / 60.f);
+  const std::vector<sf::Vector2f> directions = {
+      {1.f, 0.f}, {0.f, -1.f}, {-0.6f, 0.8f}, {0.f, 0.f}, {0.8f, 0.6f}, {0.f, 1.f}};
+  for (int i = 0; i < 240; ++i) {
+    player.setTargetDirection(directions[(i / 7) % directions.size()]);
+    scheduler.sample(player.getDirection() * player.getSpeed());
+    if (scheduler.update(frame, [&] { return player.getNextSequenceNumber(); })) {
+      client.networking.sendPlayerInputs(scheduler.packet());
+    }
+    const wire::PlayerInput committed = scheduler.latest();
+    player.setPredictionInput(committed.sequence, committed.velocity);
+    player.update(frame);
+    // Three client frames per server tick, the scheduler's first one leading.
+    if (i % 3 == 1) run(server, clients, 1);
+  }
+  run(server, clients, 2);
+
+  ASSERT_GT(scheduler.inputsCommitted(), 20u);
+  EXPECT_EQ(client.acks.back(), scheduler.latest().sequence);
+  EXPECT_LT(largestCorrection, 0.01f);
+  LocalMatchServer::Player state;
+  ASSERT_TRUE(server.findPlayer("player0", state));
+  EXPECT_NEAR(player.getPosition().x, state.position.x, 0.01f);
+  EXPECT_NEAR(player.getPosition().y, state.position.y, 0.01f);
+}
+
+TEST(LocalMatchServer, SoakManyClientsConverge) {
+  LocalMatchServer server;
+  constexpr int kClients = 48;
+  auto clients = connect(server, kClients);
+  ASSERT_EQ(server.playerCount(), static_cast<std::size_t>(kClients));
+
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> speed(-150.f, 150.f);
+  std::uniform_int_distribution<int> pick(0, kClients - 1);
+  for (int second = 0; second < 30; ++second) {
+    for (int i = 0; i < 8; ++i) clients[pick(rng)]->steer({speed(rng), speed(rng)});
+    if (second % 5 == 0) clients[pick(rng)]->networking.sendPlayerAction(second, "use", 1);
+    run(server, clients, 20);
+  }
+  for (auto& client : clients) client->steer({0.f, 0.f});
+  run(server, clients, 4);
+
+  const LocalMatchServer::Stats stats = server.stats();
+  EXPECT_EQ(stats.malformed, 0u);
+  EXPECT_EQ(stats.actions, 6u);
+  EXPECT_EQ(stats.inputsApplied, 30u * 8u + kClients);
+  for (const auto& client : clients) {
+    ASSERT_TRUE(client->joined);
+    EXPECT_EQ(client->present.size(), static_cast<std::size_t>(kClients - 1));
+    EXPECT_EQ(client->acks.back(), client->sequence);
+    EXPECT_EQ(client->objects.size(), 6u);
+    for (const auto& [userId, position] : client->positions) {
+      LocalMatchServer::Player player;
+      ASSERT_TRUE(server.findPlayer(userId, player));
+      // Snapshots carry positions quantized to 1/16 px.
+      EXPECT_NEAR(position.x, player.position.x, 0.5f / wire::kPositionScale);
+      EXPECT_NEAR(position.y, player.position.y, 0.5f / wire::kPositionScale);
+    }
+    EXPECT_EQ(client->positions.size(), static_cast<std::size_t>(kClients));
+  }
+}
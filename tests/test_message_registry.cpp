@@ -0,0 +1,148 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "networking/MessageRegistry.h"
+#include "networking/WireProtocol.h"
+
+namespace {
+
+class CollectingSink : public MessageSink {
+ public:
+  void emit(InboundMessage& message) override { messages.push_back(message); }
+  std::vector<InboundMessage> messages;
+};
+
+using Result = MessageRegistry::Result;
+
+Result decode(std::int64_t opCode, const std::string& bytes, CollectingSink& sink) {
+  InboundMessage scratch;
+  return MessageRegistry::match().decode(opCode, bytes, scratch, sink);
+}
+
+}  // namespace
+
+TEST(MessageRegistry, JsonInputAckIsDecodedOnce) {
+  CollectingSink sink;
+  EXPECT_EQ(decode(opcode::kInputAck,
+                   R"({"data":{"playerId":"alice","inputSequence":12,"approved":true,)"
+                   R"("x":1.5,"y":-2,"extra":[1,{"a":2}]},"type":"input_ack"})",
+                   sink),
+            Result::Decoded);
+  ASSERT_EQ(sink.messages.size(), 1u);
+  const InboundMessage& ack = sink.messages[0];
+  EXPECT_EQ(ack.kind, InboundMessage::Kind::InputAck);
+  EXPECT_EQ(ack.userId.view(), "alice");
+  EXPECT_EQ(ack.sequence, 12u);
+  EXPECT_TRUE(ack.approved);
+  ASSERT_TRUE(ack.hasPosition);
+  EXPECT_EQ(ack.position, sf::Vector2f(1.5f, -2.f));
+
+  sink.messages.clear();
+  decode(opcode::kInputAck,
+         R"({"type":"input_ack","data":{"playerId":"bob","inputSequence":3,"approved":false}})",
+         sink);
+  ASSERT_EQ(sink.messages.size(), 1u);
+  EXPECT_FALSE(sink.messages[0].hasPosition);
+  EXPECT_FALSE(sink.messages[0].approved);
+}
+
+TEST(MessageRegistry, JsonObjectUpdateSetsOnlySentFields) {
+  CollectingSink sink;
+  EXPECT_EQ(decode(opcode::kObjectUpdate,
+                   R"({"type":"object_update","data":{"objectId":7,"gid":2147483658,)"
+                   R"("visible":false,"pos":{"x":32,"y":64}}})",
+                   sink),
+            Result::Decoded);
+  ASSERT_EQ(sink.messages.size(), 1u);
+  const wire::ObjectUpdate& update = sink.messages[0].object;
+  EXPECT_EQ(sink.messages[0].kind, InboundMessage::Kind::ObjectUpdate);
+  EXPECT_EQ(update.objectId, 7u);
+  EXPECT_EQ(update.fields,
+            wire::ObjectUpdate::kGid | wire::ObjectUpdate::kVisible | wire::ObjectUpdate::kPos);
+  EXPECT_EQ(update.gid, 0x8000000Au);  // flip flag kept
+  EXPECT_FALSE(update.visible);
+  EXPECT_EQ(update.pos, sf::Vector2f(32.f, 64.f));
+
+  // Without an object id there is nothing to apply it to.
+  sink.messages.clear();
+  EXPECT_EQ(decode(opcode::kObjectUpdate, R"({"type":"object_update","data":{"gid":1}})", sink),
+            Result::Decoded);
+  EXPECT_TRUE(sink.messages.empty());
+}
+
+TEST(MessageRegistry, JsonPongCarriesServerTimeInSeconds) {
+  CollectingSink sink;
+  decode(opcode::kPing, R"({"type":"pong","data":{"id":5,"serverTime":2500}})", sink);
+  ASSERT_EQ(sink.messages.size(), 1u);
+  EXPECT_EQ(sink.messages[0].kind, InboundMessage::Kind::Pong);
+  EXPECT_EQ(sink.messages[0].pingId, 5u);
+  EXPECT_DOUBLE_EQ(sink.messages[0].serverTime, 2.5);
+}
+
+TEST(MessageRegistry, BinaryAndJsonShareAnOpcode) {
+  wire::InputAck ack;
+  ack.sequence = 9;
+  ack.playerId = "carol";
+  std::string bytes;
+  wire::encode(ack, bytes);
+
+  CollectingSink sink;
+  EXPECT_EQ(decode(opcode::kInputAck, bytes, sink), Result::Decoded);
+  ASSERT_EQ(sink.messages.size(), 1u);
+  EXPECT_EQ(sink.messages[0].userId.view(), "carol");
+  EXPECT_EQ(sink.messages[0].sequence, 9u);
+  EXPECT_FALSE(sink.messages[0].hasPosition);
+
+  // Pong has no binary form.
+  bytes[2] = 0;
+  EXPECT_EQ(decode(opcode::kPing, bytes, sink), Result::UnknownOpCode);
+}
+
+TEST(MessageRegistry, RejectsUnknownOpcodesAndMalformedPayloads) {
+  CollectingSink sink;
+  EXPECT_EQ(decode(9, R"({"type":"input_ack","data":{}})", sink), Result::UnknownOpCode);
+  EXPECT_EQ(decode(-1, "{}", sink), Result::UnknownOpCode);
+  EXPECT_EQ(decode(1000, "{}", sink), Result::UnknownOpCode);
+  EXPECT_EQ(decode(opcode::kInputAck, R"({"type":"input_ack","data":{"x":1,})", sink),
+            Result::Malformed);
+  EXPECT_EQ(decode(opcode::kObjectUpdate, std::string("\xB7\x01", 2), sink), Result::Malformed);
+  // Another message type on the same opcode is not an error.
+  EXPECT_EQ(decode(opcode::kInputAck, R"({"type":"chat","data":{"text":"hi"}})", sink),
+            Result::Decoded);
+  EXPECT_TRUE(sink.messages.empty());
+}
+
+TEST(MessageRegistry, RejectsWorldUpdateNetIdsPastTheLimit) {
+  CollectingSink sink;
+  std::string bytes;
+  {
+    wire::WorldUpdateWriter writer(bytes, 2);
+    writer.add({InboundMessage::kMaxNetId, "alice", {1.f, 2.f}, 0});
+    writer.add({0xFFFFFFF0u, "bob", {3.f, 4.f}, 0});
+  }
+  EXPECT_EQ(decode(opcode::kWorldUpdate, bytes, sink), Result::Malformed);
+  ASSERT_EQ(sink.messages.size(), 1u);
+  EXPECT_EQ(sink.messages[0].netId, InboundMessage::kMaxNetId);
+}
+
+TEST(MessageRegistry, CustomDecodersAreLookedUpByOpcode) {
+  MessageRegistry registry;
+  registry.add(9, MessageRegistry::Encoding::Json,
+               [](std::string_view bytes, InboundMessage& message, MessageSink& sink, void*) {
+                 message.kind = InboundMessage::Kind::Presence;
+                 message.joined = true;
+                 message.userId.assign(bytes);
+                 sink.emit(message);
+                 return true;
+               });
+  CollectingSink sink;
+  InboundMessage scratch;
+  EXPECT_EQ(registry.decode(9, "dave", scratch, sink), Result::Decoded);
+  EXPECT_EQ(registry.decode(opcode::kWorldUpdate, "{}", scratch, sink), Result::UnknownOpCode);
+  ASSERT_EQ(sink.messages.size(), 1u);
+  EXPECT_EQ(sink.messages[0].userId.view(), "dave");
+}
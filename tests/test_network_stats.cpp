@@ -0,0 +1,144 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "networking/NetworkStats.h"
+
+namespace {
+
+std::size_t countFields(const std::string& line) {
+  std::size_t fields = 1;
+  for (char c : line) fields += c == ',';
+  return fields;
+}
+
+}  // namespace
+
+TEST(DurationHistogram, BucketsByPowersOfTwo) {
+  DurationHistogram h;
+  EXPECT_EQ(h.percentile(0.5), 0.0);
+
+  h.add(1.0);     // bucket 0
+  h.add(3.0);     // bucket 1: [2, 4)
+  h.add(100.0);   // bucket 6: [64, 128)
+  h.add(-5.0);    // clamped to 0
+  EXPECT_EQ(h.count(), 4u);
+  EXPECT_EQ(h.bucket(0), 2u);
+  EXPECT_EQ(h.bucket(1), 1u);
+  EXPECT_EQ(h.bucket(6), 1u);
+  EXPECT_DOUBLE_EQ(h.mean(), 26.0);
+  EXPECT_DOUBLE_EQ(h.max(), 100.0);
+
+  EXPECT_DOUBLE_EQ(h.percentile(0.5), 2.0);   // upper edge of bucket 0
+  EXPECT_DOUBLE_EQ(h.percentile(0.75), 4.0);
+  EXPECT_DOUBLE_EQ(h.percentile(1.0), 100.0);  // capped at the maximum
+
+  h.add(1e12);  // past the last bucket
+  EXPECT_EQ(h.bucket(DurationHistogram::kBuckets - 1), 1u);
+  h.clear();
+  EXPECT_EQ(h.count(), 0u);
+}
+
+TEST(NetworkTelemetry, CountsTrafficPerOpCode) {
+  NetworkTelemetry telemetry;
+  telemetry.onReceived(opcode::kWorldUpdate, 100, 12.0, 1.0);
+  telemetry.onReceived(opcode::kWorldUpdate, 50, 20.0, 1.05);
+  telemetry.onReceived(opcode::kInputAck, 30, 3.0, 1.06);
+  telemetry.onReceived(99, 7, 1.0, 1.07);  // unknown, lands in the last slot
+  telemetry.onSent(opcode::kPlayerInput, 20);
+
+  const NetworkStats stats = telemetry.snapshot();
+  EXPECT_EQ(stats.opcodes[opcode::kWorldUpdate].messagesIn, 2u);
+  EXPECT_EQ(stats.opcodes[opcode::kWorldUpdate].bytesIn, 150u);
+  EXPECT_EQ(stats.decodeUs[opcode::kWorldUpdate].count(), 2u);
+  EXPECT_EQ(stats.opcodes[opcode::kInputAck].bytesIn, 30u);
+  EXPECT_EQ(stats.opcodes.back().bytesIn, 7u);
+  EXPECT_EQ(stats.opcodes[opcode::kPlayerInput].messagesOut, 1u);
+
+  const NetworkStats::Traffic total = stats.total();
+  EXPECT_EQ(total.messagesIn, 4u);
+  EXPECT_EQ(total.bytesIn, 187u);
+  EXPECT_EQ(total.bytesOut, 20u);
+
+  // Only world state counts towards the snapshot interval.
+  EXPECT_EQ(stats.snapshotIntervalUs.count(), 1u);
+  EXPECT_NEAR(stats.snapshotIntervalUs.max(), 50000.0, 1.0);
+}
+
+TEST(NetworkTelemetry, MeasuresRttAndJitterFromInputAcks) {
+  NetworkTelemetry telemetry;
+  EXPECT_FALSE(telemetry.awaitingInputAcks());
+
+  telemetry.onInputSent(1, 10.0);
+  telemetry.onInputSent(1, 10.05);  // redundant copy keeps the first send time
+  EXPECT_TRUE(telemetry.awaitingInputAcks());
+  telemetry.onInputAck(1, 10.1);
+  EXPECT_FALSE(telemetry.awaitingInputAcks());
+  telemetry.onInputAck(1, 10.2);  // duplicate ack is ignored
+
+  NetworkStats stats = telemetry.snapshot();
+  EXPECT_EQ(stats.ackSamples, 1u);
+  EXPECT_NEAR(stats.ackRttMs, 100.0, 1e-6);
+  EXPECT_NEAR(stats.ackRttMinMs, 100.0, 1e-6);
+  EXPECT_EQ(stats.ackRttJitterMs, 0.0);
+
+  telemetry.onInputSent(2, 11.0);
+  telemetry.onInputAck(2, 11.18);
+  telemetry.onInputAck(3, 11.2);  // never sent
+  stats = telemetry.snapshot();
+  EXPECT_EQ(stats.ackSamples, 2u);
+  EXPECT_NEAR(stats.ackRttMs, 110.0, 1e-6);      // 100 + (180 - 100) / 8
+  EXPECT_NEAR(stats.ackRttMinMs, 100.0, 1e-6);
+  EXPECT_NEAR(stats.ackRttJitterMs, 5.0, 1e-6);  // |180 - 100| / 16
+}
+
+TEST(NetworkTelemetry, SnapshotJitterFollowsIntervalChanges) {
+  NetworkTelemetry telemetry;
+  telemetry.onReceived(opcode::kWorldSnapshot, 10, 1.0, 0.0);
+  telemetry.onReceived(opcode::kWorldSnapshot, 10, 1.0, 0.05);
+  telemetry.onReceived(opcode::kWorldSnapshot, 10, 1.0, 0.10);
+  EXPECT_NEAR(telemetry.snapshot().snapshotJitterMs, 0.0, 1e-6);
+
+  telemetry.onReceived(opcode::kWorldSnapshot, 10, 1.0, 0.23);  // 130 ms late
+  EXPECT_NEAR(telemetry.snapshot().snapshotJitterMs, 5.0, 1e-6);
+}
+
+TEST(NetworkStatsLog, CsvRowsMatchTheHeader) {
+  NetworkTelemetry telemetry;
+  telemetry.onReceived(opcode::kWorldUpdate, 100, 12.0, 1.0);
+  NetworkStats stats = telemetry.snapshot();
+  stats.queues.inboundDropped = 3;
+
+  std::ostringstream out;
+  NetworkStatsLog::writeCsvHeader(out);
+  NetworkStatsLog::writeCsvRow(out, 2.5, stats);
+  std::istringstream lines(out.str());
+  std::string header, row;
+  std::getline(lines, header);
+  std::getline(lines, row);
+  EXPECT_EQ(header.rfind("time_s,", 0), 0u);
+  EXPECT_NE(header.find("op2_bytes_in"), std::string::npos);
+  EXPECT_EQ(countFields(header), countFields(row));
+  EXPECT_EQ(row.rfind("2.5,1,100,", 0), 0u);
+}
+
+TEST(NetworkStatsLog, JsonLinesCarryOpCodesAndHistograms) {
+  NetworkTelemetry telemetry;
+  telemetry.onReceived(opcode::kWorldUpdate, 100, 12.0, 1.0);
+  telemetry.onSent(opcode::kPing, 40);
+
+  std::ostringstream out;
+  NetworkStatsLog::writeJsonLine(out, 1.0, telemetry.snapshot());
+  const auto line = nlohmann::json::parse(out.str());
+  EXPECT_EQ(line["time_s"], 1.0);
+  EXPECT_EQ(line["opcodes"]["2"]["bytes_in"], 100);
+  EXPECT_EQ(line["opcodes"]["2"]["decode"]["count"], 1);
+  EXPECT_EQ(line["opcodes"]["6"]["bytes_out"], 40);
+  EXPECT_FALSE(line["opcodes"].contains("1"));
+  EXPECT_TRUE(line.contains("queues"));
+}
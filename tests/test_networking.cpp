@@ -2,8 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "mocks/MockNClientFull.h"
@@ -27,6 +31,8 @@
 #include "nakama-cpp/realtime/rtdata/NStreamData.h"
 #include "nakama-cpp/realtime/rtdata/NStreamPresenceEvent.h"
 #include "networking/Networking.h"
+#include "support/AllocationCounter.h"
+#include "support/SnapshotServer.h"
 
 #include <SFML/System/Vector2.hpp>
 #include <nlohmann/json.hpp>
@@ -326,6 +332,38 @@ TEST(NetworkingTest, SendPlayerUpdate) {
   networking.sendPlayerUpdate(direction, speed, sequenceNumber);
 }
 
+TEST(NetworkingTest, SendPlayerInputsCarriesEarlierInputs) {
+  auto mockNClient = std::make_shared<MockNClientFull>();
+  auto mockSession = std::make_shared<MockSession>();
+  auto mockRtClient = std::make_shared<MockRtClient>();
+  TestableNetworking networking(mockNClient);
+  networking.initialize(mockSession);
+  networking.setProtectedRtClient(mockRtClient);
+  networking.setCurrentMatchIdForTest("match_for_inputs");
+
+  const std::string userId = "player123";
+  EXPECT_CALL(*mockSession, getUserId()).WillRepeatedly(testing::ReturnRef(userId));
+  EXPECT_CALL(*mockRtClient, isConnected()).WillRepeatedly(testing::Return(true));
+
+  nlohmann::json sent;
+  EXPECT_CALL(*mockRtClient, sendMatchData("match_for_inputs", 1, testing::_, testing::_))
+      .WillOnce([&](const std::string&, std::int64_t, const Nakama::NBytes& bytes,
+                    const std::vector<Nakama::NUserPresence>&) {
+        sent = nlohmann::json::parse(bytes.begin(), bytes.end());
+      });
+
+  const wire::PlayerInput inputs[] = {{4, {1.f, 0.f}}, {5, {0.f, 2.f}}, {6, {3.f, 0.f}}};
+  networking.sendPlayerInputs(inputs);
+
+  // The newest input stays at the top level for servers that ignore the rest.
+  EXPECT_EQ(sent.value("inputSequence", 0u), 6u);
+  EXPECT_EQ(sent.value("velocityX", 0.f), 3.f);
+  ASSERT_EQ(sent["inputs"].size(), 2u);
+  EXPECT_EQ(sent["inputs"][0].value("inputSequence", 0u), 5u);
+  EXPECT_EQ(sent["inputs"][1].value("inputSequence", 0u), 4u);
+  EXPECT_EQ(sent["inputs"][0].value("velocityY", 0.f), 2.f);
+}
+
 TEST(NetworkingTest, SendPlayerUpdateNotConnected) {
   auto mockNClient = std::make_shared<MockNClientFull>();
   auto mockSession = std::make_shared<MockSession>();
@@ -364,3 +402,543 @@ TEST(NetworkingTest, SendPlayerUpdateNoMatchId) {
 
   networking.sendPlayerUpdate(sf::Vector2f(1, 0), 10, 1);
 }
+
+TEST(NetworkingTest, WorldUpdateDeliversInternedHandles) {
+  auto mockNClient = std::make_shared<MockNClientFull>();
+  auto mockSession = std::make_shared<MockSession>();
+  TestableNetworking networking(mockNClient);
+  ASSERT_TRUE(networking.initialize(mockSession));
+
+  std::vector<std::pair<PlayerHandle, sf::Vector2f>> updates;
+  networking.setPlayerStateUpdateCallback(
+      [&](PlayerHandle player, const sf::Vector2f& position, unsigned int) {
+        updates.emplace_back(player, position);
+      });
+
+  const std::string payload =
+      R"({"type":"world_update","data":{"players":{)"
+      R"("alice":{"position":{"x":1,"y":2}},"bob":{"position":{"x":3,"y":4}}}}})";
+  Nakama::NMatchData data;
+  data.opCode = 2;
+  data.data.assign(payload.begin(), payload.end());
+
+  networking.getInternalListener()->onMatchData(data);
+  networking.getInternalListener()->onMatchData(data);
+
+  ASSERT_EQ(updates.size(), 4u);
+  const PlayerHandle alice = networking.playerIds().find("alice");
+  const PlayerHandle bob = networking.playerIds().find("bob");
+  ASSERT_NE(alice, kInvalidPlayerHandle);
+  ASSERT_NE(bob, kInvalidPlayerHandle);
+  EXPECT_EQ(networking.playerIds().size(), 2u);
+  EXPECT_EQ(updates[0].first, alice);
+  EXPECT_EQ(updates[0].second, sf::Vector2f(1.f, 2.f));
+  EXPECT_EQ(updates[3].first, bob);
+  EXPECT_EQ(updates[3].second, sf::Vector2f(3.f, 4.f));
+}
+
+TEST(NetworkingTest, JsonWorldUpdateDecodesWithoutAllocating) {
+  auto mockNClient = std::make_shared<MockNClientFull>();
+  auto mockSession = std::make_shared<MockSession>();
+  TestableNetworking networking(mockNClient);
+  ASSERT_TRUE(networking.initialize(mockSession));
+
+  std::size_t received = 0;
+  sf::Vector2f last;
+  networking.setPlayerStateUpdateCallback(
+      [&](PlayerHandle, const sf::Vector2f& position, unsigned int) {
+        ++received;
+        last = position;
+      });
+
+  // "data" before "type" (as sorted-key encoders emit), extra fields, an
+  // entry without a position and an escaped id that can't be a user id.
+  const std::string payload =
+      R"({"data":{"tick":9,"players":{)"
+      R"("alice":{"name":"A","position":{"x":1.5,"y":-2}},)"
+      R"("bob":{"position":{"y":4,"x":3}},"idle":{"hp":3},"e\u0301":{"position":{"x":0,"y":0}}}},)"
+      R"("type":"world_update"})";
+  Nakama::NMatchData data;
+  data.opCode = 2;
+  data.data.assign(payload.begin(), payload.end());
+
+  networking.getInternalListener()->onMatchData(data);  // interns the ids
+  ASSERT_EQ(received, 2u);
+  EXPECT_EQ(last, sf::Vector2f(3.f, 4.f));
+  EXPECT_EQ(networking.playerIds().size(), 2u);
+
+  const auto before = AllocationCounter::snapshot();
+  for (int i = 0; i < 100; ++i) networking.getInternalListener()->onMatchData(data);
+  EXPECT_EQ(AllocationCounter::snapshot().allocations - before.allocations, 0u);
+  EXPECT_EQ(received, 202u);
+
+  // A truncated message is dropped before its type is known.
+  data.data.resize(data.data.size() / 2);
+  networking.getInternalListener()->onMatchData(data);
+  EXPECT_EQ(received, 202u);
+}
+
+TEST(NetworkingTest, TickPingsAndPongUpdatesClock) {
+  auto mockNClient = std::make_shared<MockNClientFull>();
+  auto mockSession = std::make_shared<MockSession>();
+  auto mockRtClient = std::make_shared<MockRtClient>();
+
+  TestableNetworking networking(mockNClient);
+  networking.initialize(mockSession);
+  networking.setProtectedRtClient(mockRtClient);
+  networking.setCurrentMatchIdForTest("match_for_pings");
+
+  EXPECT_CALL(*mockRtClient, tick()).Times(testing::AnyNumber());
+  EXPECT_CALL(*mockRtClient, isConnected())
+      .WillRepeatedly(testing::Return(true));
+
+  std::uint32_t pingId = 0;
+  EXPECT_CALL(*mockRtClient,
+              sendMatchData("match_for_pings", 6, testing::_, testing::_))
+      .WillOnce([&](const std::string&, std::int64_t, const Nakama::NBytes& bytes,
+                    const std::vector<Nakama::NUserPresence>&) {
+        const auto ping = nlohmann::json::parse(std::string(bytes.begin(), bytes.end()));
+        EXPECT_EQ(ping.value("type", ""), "ping");
+        pingId = ping["data"].value("id", 0u);
+      });
+  networking.tick();
+  networking.tick();  // the next ping is not due yet
+  ASSERT_NE(pingId, 0u);
+  EXPECT_FALSE(networking.clockSync().synced());
+
+  // Server clock is an hour ahead.
+  const double serverMs = (ClockSync::localTime() + 3600.0) * 1000.0;
+  nlohmann::json pong;
+  pong["type"] = "pong";
+  pong["data"]["id"] = pingId;
+  pong["data"]["serverTime"] = serverMs;
+  const std::string payload = pong.dump();
+  Nakama::NMatchData data;
+  data.opCode = 6;
+  data.data.assign(payload.begin(), payload.end());
+  networking.getInternalListener()->onMatchData(data);
+
+  ASSERT_TRUE(networking.clockSync().synced());
+  EXPECT_NEAR(networking.serverNow() - ClockSync::localTime(), 3600.0, 0.5);
+}
+
+TEST(NetworkingTest, PresenceEventsReportJoinsAndReleaseLeavers) {
+  auto mockNClient = std::make_shared<MockNClientFull>();
+  auto mockSession = std::make_shared<MockSession>();
+  TestableNetworking networking(mockNClient);
+  ASSERT_TRUE(networking.initialize(mockSession));
+  const std::string self = "me";
+  EXPECT_CALL(*mockSession, getUserId()).WillRepeatedly(testing::ReturnRef(self));
+
+  std::vector<std::pair<std::string, bool>> events;
+  networking.setPresenceCallback([&](PlayerHandle player, bool joined) {
+    // The handle still resolves while the callback runs.
+    events.emplace_back(networking.playerIds().name(player), joined);
+  });
+
+  Nakama::NMatchPresenceEvent join;
+  join.joins.resize(2);
+  join.joins[0].userId = "alice";
+  join.joins[1].userId = "me";
+  networking.getInternalListener()->onMatchPresence(join);
+
+  Nakama::NMatchPresenceEvent leave;
+  leave.leaves.resize(2);
+  leave.leaves[0].userId = "alice";
+  leave.leaves[1].userId = "never-joined";
+  networking.getInternalListener()->onMatchPresence(leave);
+
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0], std::make_pair(std::string("alice"), true));
+  EXPECT_EQ(events[1], std::make_pair(std::string("alice"), false));
+  EXPECT_EQ(networking.playerIds().find("alice"), kInvalidPlayerHandle);
+  EXPECT_EQ(networking.playerIds().find("me"), kInvalidPlayerHandle);
+}
+
+TEST(NetworkingTest, UpdatesAfterALeaveDoNotResurrectThePlayer) {
+  auto mockNClient = std::make_shared<MockNClientFull>();
+  auto mockSession = std::make_shared<MockSession>();
+  TestableNetworking networking(mockNClient);
+  ASSERT_TRUE(networking.initialize(mockSession));
+  const std::string self = "me";
+  EXPECT_CALL(*mockSession, getUserId()).WillRepeatedly(testing::ReturnRef(self));
+
+  std::vector<std::string> updated;
+  networking.setPlayerStateUpdateCallback(
+      [&](PlayerHandle player, const sf::Vector2f&, unsigned int) {
+        updated.push_back(networking.playerIds().name(player));
+      });
+  int acks = 0;
+  networking.setInputAckCallback([&](PlayerHandle, const wire::InputAck&) { ++acks; });
+
+  Nakama::NMatchPresenceEvent presence;
+  presence.joins.resize(1);
+  presence.joins[0].userId = "alice";
+  networking.getInternalListener()->onMatchPresence(presence);
+  std::swap(presence.joins, presence.leaves);
+  networking.getInternalListener()->onMatchPresence(presence);
+
+  // A world_update and an ack that were in flight when alice left.
+  const std::string payload =
+      R"({"type":"world_update","data":{"players":{"alice":{"position":{"x":1,"y":2}}}}})";
+  Nakama::NMatchData data;
+  data.opCode = 2;
+  data.data = payload;
+  networking.getInternalListener()->onMatchData(data);
+  data.opCode = 4;
+  data.data = R"({"type":"input_ack","data":{"playerId":"alice","inputSequence":3,)"
+              R"("approved":true,"x":1,"y":2}})";
+  networking.getInternalListener()->onMatchData(data);
+  // Binary: a netId introduced with the departed id.
+  data.opCode = 2;
+  {
+    wire::WorldUpdateWriter writer(data.data, 1);
+    writer.add({3, "alice", {1.f, 2.f}, 0});
+  }
+  networking.getInternalListener()->onMatchData(data);
+
+  EXPECT_TRUE(updated.empty());
+  EXPECT_EQ(acks, 0);
+  EXPECT_EQ(networking.playerIds().find("alice"), kInvalidPlayerHandle);
+  EXPECT_EQ(networking.playerIds().size(), 0u);
+
+  // Rejoining brings the updates back.
+  std::swap(presence.joins, presence.leaves);
+  networking.getInternalListener()->onMatchPresence(presence);
+  data.data = payload;
+  networking.getInternalListener()->onMatchData(data);
+  EXPECT_EQ(updated, std::vector<std::string>{"alice"});
+}
+
+TEST(NetworkingTest, BinaryMessagesAreDecodedAndSwitchSendFormat) {
+  auto mockNClient = std::make_shared<MockNClientFull>();
+  auto mockSession = std::make_shared<MockSession>();
+  auto mockRtClient = std::make_shared<MockRtClient>();
+  TestableNetworking networking(mockNClient);
+  ASSERT_TRUE(networking.initialize(mockSession));
+  networking.setProtectedRtClient(mockRtClient);
+  networking.setCurrentMatchIdForTest("binary_match");
+  EXPECT_EQ(networking.wireFormat(), Networking::WireFormat::Json);
+
+  std::vector<std::pair<PlayerHandle, sf::Vector2f>> updates;
+  networking.setPlayerStateUpdateCallback(
+      [&](PlayerHandle player, const sf::Vector2f& position, unsigned int) {
+        updates.emplace_back(player, position);
+      });
+  PlayerHandle ackPlayer = kInvalidPlayerHandle;
+  wire::InputAck ack;
+  networking.setInputAckCallback([&](PlayerHandle player, const wire::InputAck& message) {
+    ackPlayer = player;
+    ack = message;
+    ack.playerId = {};  // only valid during the call
+  });
+  std::vector<wire::ObjectUpdate> objectUpdates;
+  networking.setObjectUpdateCallback(
+      [&](const wire::ObjectUpdate& update) { objectUpdates.push_back(update); });
+
+  Nakama::NMatchData data;
+  data.opCode = 2;
+  {
+    wire::WorldUpdateWriter writer(data.data, 2);
+    writer.add({0, "alice", {1.f, 2.f}, 0});
+    writer.add({5, "", {3.f, 4.f}, 0});  // never introduced: skipped
+  }
+  networking.getInternalListener()->onMatchData(data);
+  {
+    wire::WorldUpdateWriter writer(data.data, 1);
+    writer.add({0, "", {1.5f, 2.f}, 0});  // known netId, no user id
+  }
+  networking.getInternalListener()->onMatchData(data);
+
+  const PlayerHandle alice = networking.playerIds().find("alice");
+  ASSERT_EQ(updates.size(), 2u);
+  EXPECT_EQ(updates[0], std::make_pair(alice, sf::Vector2f(1.f, 2.f)));
+  EXPECT_EQ(updates[1], std::make_pair(alice, sf::Vector2f(1.5f, 2.f)));
+  EXPECT_EQ(networking.wireFormat(), Networking::WireFormat::Binary);
+
+  wire::InputAck binaryAck;
+  binaryAck.sequence = 3;
+  binaryAck.approved = true;
+  binaryAck.hasPosition = true;
+  binaryAck.playerId = "me";
+  binaryAck.position = {8.f, 9.f};
+  data.opCode = 4;
+  wire::encode(binaryAck, data.data);
+  networking.getInternalListener()->onMatchData(data);
+  EXPECT_EQ(ackPlayer, networking.playerIds().find("me"));
+  EXPECT_EQ(ack.sequence, 3u);
+  EXPECT_TRUE(ack.approved);
+  ASSERT_TRUE(ack.hasPosition);
+  EXPECT_EQ(ack.position, sf::Vector2f(8.f, 9.f));
+
+  wire::ObjectUpdate binaryUpdate;
+  binaryUpdate.objectId = 42;
+  binaryUpdate.fields = wire::ObjectUpdate::kVisible;
+  binaryUpdate.visible = false;
+  data.opCode = 5;
+  wire::encode(binaryUpdate, data.data);
+  networking.getInternalListener()->onMatchData(data);
+  ASSERT_EQ(objectUpdates.size(), 1u);
+  EXPECT_EQ(objectUpdates[0].objectId, 42u);
+  EXPECT_EQ(objectUpdates[0].fields, wire::ObjectUpdate::kVisible);
+  EXPECT_FALSE(objectUpdates[0].visible);
+
+  // Once the server spoke binary, inputs go out binary as well.
+  const std::string userId = "me";
+  EXPECT_CALL(*mockSession, getUserId()).WillRepeatedly(testing::ReturnRef(userId));
+  EXPECT_CALL(*mockRtClient, isConnected()).WillRepeatedly(testing::Return(true));
+  EXPECT_CALL(*mockRtClient, sendMatchData("binary_match", 1, testing::_, testing::_))
+      .WillOnce([](const std::string&, std::int64_t, const Nakama::NBytes& bytes,
+                   const std::vector<Nakama::NUserPresence>&) {
+        wire::PlayerInput input;
+        ASSERT_TRUE(wire::decode(bytes, input));
+        EXPECT_EQ(input.sequence, 7u);
+        EXPECT_EQ(input.velocity, sf::Vector2f(100.f, 0.f));
+      });
+  networking.sendPlayerUpdate({1.f, 0.f}, 100.f, 7);
+}
+
+TEST(NetworkingTest, WorldSnapshotsAreRebuiltAndAcknowledged) {
+  auto mockNClient = std::make_shared<MockNClientFull>();
+  auto mockSession = std::make_shared<MockSession>();
+  auto mockRtClient = std::make_shared<MockRtClient>();
+  TestableNetworking networking(mockNClient);
+  ASSERT_TRUE(networking.initialize(mockSession));
+  networking.setProtectedRtClient(mockRtClient);
+  networking.setCurrentMatchIdForTest("snapshot_match");
+  EXPECT_CALL(*mockRtClient, tick()).Times(testing::AnyNumber());
+  EXPECT_CALL(*mockRtClient, isConnected()).WillRepeatedly(testing::Return(true));
+  EXPECT_CALL(*mockRtClient, sendMatchData("snapshot_match", 6, testing::_, testing::_))
+      .Times(testing::AnyNumber());
+
+  std::vector<std::pair<std::string, sf::Vector2f>> updates;
+  networking.setPlayerStateUpdateCallback(
+      [&](PlayerHandle player, const sf::Vector2f& position, unsigned int) {
+        updates.emplace_back(networking.playerIds().name(player), position);
+      });
+
+  SnapshotServer server;
+  std::vector<SnapshotServer::Player> players = {{1, "alice", {1.f, 2.f}, 0},
+                                                 {2, "bob", {3.f, 4.f}, 0}};
+  EXPECT_CALL(*mockRtClient, sendMatchData("snapshot_match", 8, testing::_, testing::_))
+      .Times(2)
+      .WillRepeatedly([&](const std::string&, std::int64_t, const Nakama::NBytes& bytes,
+                          const std::vector<Nakama::NUserPresence>&) {
+        wire::SnapshotAck ack;
+        ASSERT_TRUE(wire::decode(bytes, ack));
+        server.acknowledge(ack.snapshotId);
+      });
+
+  Nakama::NMatchData data;
+  data.opCode = 3;
+  server.encode(players, data.data);
+  networking.getInternalListener()->onMatchData(data);
+  networking.tick();
+  networking.tick();  // nothing new to acknowledge
+  EXPECT_EQ(server.acknowledged(), 1u);
+
+  players[1].position = {5.f, 6.f};
+  server.encode(players, data.data);
+  networking.getInternalListener()->onMatchData(data);
+  networking.tick();
+  EXPECT_EQ(server.acknowledged(), 2u);
+
+  ASSERT_EQ(updates.size(), 4u);
+  EXPECT_EQ(updates[2], std::make_pair(std::string("alice"), sf::Vector2f(1.f, 2.f)));
+  EXPECT_EQ(updates[3], std::make_pair(std::string("bob"), sf::Vector2f(5.f, 6.f)));
+  EXPECT_EQ(networking.snapshots().stats().rebuilt, 2u);
+}
+
+TEST(NetworkingTest, TelemetryCountsTrafficAndInputRoundTrips) {
+  auto mockNClient = std::make_shared<MockNClientFull>();
+  auto mockSession = std::make_shared<MockSession>();
+  auto mockRtClient = std::make_shared<MockRtClient>();
+  TestableNetworking networking(mockNClient);
+  ASSERT_TRUE(networking.initialize(mockSession));
+  networking.setProtectedRtClient(mockRtClient);
+  networking.setCurrentMatchIdForTest("stats_match");
+  const std::string userId = "me";
+  EXPECT_CALL(*mockSession, getUserId()).WillRepeatedly(testing::ReturnRef(userId));
+  EXPECT_CALL(*mockRtClient, isConnected()).WillRepeatedly(testing::Return(true));
+  std::size_t sentBytes = 0;
+  EXPECT_CALL(*mockRtClient, sendMatchData("stats_match", 1, testing::_, testing::_))
+      .WillOnce([&](const std::string&, std::int64_t, const Nakama::NBytes& bytes,
+                    const std::vector<Nakama::NUserPresence>&) { sentBytes = bytes.size(); });
+
+  networking.sendPlayerUpdate({1.f, 0.f}, 100.f, 7);
+
+  Nakama::NMatchData data;
+  data.opCode = 4;
+  wire::InputAck ack;
+  ack.sequence = 7;
+  ack.approved = true;
+  ack.playerId = "someone else";
+  wire::encode(ack, data.data);
+  std::size_t receivedBytes = data.data.size();
+  networking.getInternalListener()->onMatchData(data);
+  EXPECT_EQ(networking.networkStats().ackSamples, 0u);
+
+  ack.playerId = "me";
+  wire::encode(ack, data.data);
+  receivedBytes += data.data.size();
+  networking.getInternalListener()->onMatchData(data);
+
+  const NetworkStats stats = networking.networkStats();
+  EXPECT_EQ(stats.opcodes[1].messagesOut, 1u);
+  EXPECT_EQ(stats.opcodes[1].bytesOut, sentBytes);
+  EXPECT_EQ(stats.opcodes[4].messagesIn, 2u);
+  EXPECT_EQ(stats.opcodes[4].bytesIn, receivedBytes);
+  EXPECT_EQ(stats.decodeUs[4].count(), 2u);
+  EXPECT_EQ(stats.ackSamples, 1u);
+  EXPECT_GE(stats.ackRttMs, 0.0);
+}
+
+TEST(NetworkingTest, DecodeTimeLeavesOutInlineCallbacks) {
+  auto mockNClient = std::make_shared<MockNClientFull>();
+  auto mockSession = std::make_shared<MockSession>();
+  TestableNetworking networking(mockNClient);
+  ASSERT_TRUE(networking.initialize(mockSession));
+  networking.setPlayerStateUpdateCallback([](PlayerHandle, const sf::Vector2f&, unsigned int) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));  // a slow game callback
+  });
+
+  Nakama::NMatchData data;
+  data.opCode = 2;
+  data.data = R"({"type":"world_update","data":{"players":{"alice":{"position":{"x":1,"y":2}}}}})";
+  networking.getInternalListener()->onMatchData(data);
+
+  const NetworkStats stats = networking.networkStats();
+  ASSERT_EQ(stats.decodeUs[2].count(), 1u);
+  EXPECT_LT(stats.decodeUs[2].max(), 10000.0);
+}
+
+TEST(NetworkingTest, RtClientFactoryReplacesCreateRtClient) {
+  auto mockNClient = std::make_shared<MockNClientFull>();
+  auto mockSession = std::make_shared<MockSession>();
+  auto mockRtClient = std::make_shared<MockRtClient>();
+  TestableNetworking networking(mockNClient);
+  ASSERT_TRUE(networking.initialize(mockSession));
+
+  EXPECT_CALL(*mockNClient, createRtClient()).Times(0);
+  EXPECT_CALL(*mockRtClient, setListener(testing::_));
+  EXPECT_CALL(*mockRtClient, isConnected()).WillRepeatedly(testing::Return(false));
+  EXPECT_CALL(*mockRtClient, connect(testing::_, true, testing::_));
+  int made = 0;
+  networking.setRtClientFactory([&] {
+    ++made;
+    return mockRtClient;
+  });
+  networking.joinMatch("factory_match", nullptr);
+  EXPECT_EQ(made, 1);
+  EXPECT_EQ(networking.getRtClient(), mockRtClient);
+}
+
+TEST(NetworkingTest, DestroyingAThreadedClientDropsQueuedMessages) {
+  // Stands in for GameScene: its callbacks must not run once it is gone.
+  struct Owner {
+    bool* alive;
+    explicit Owner(bool* flag) : alive(flag) { *alive = true; }
+    ~Owner() { *alive = false; }
+  };
+  bool ownerAlive = false;
+  int callsAfterDeath = 0;
+
+  auto mockNClient = std::make_shared<MockNClientFull>();
+  auto mockSession = std::make_shared<MockSession>();
+  auto mockRtClient = std::make_shared<testing::NiceMock<MockRtClient>>();
+  auto networking = std::make_unique<TestableNetworking>(mockNClient);
+  ASSERT_TRUE(networking->initialize(mockSession));
+  networking->setProtectedRtClient(mockRtClient);
+  networking->setCurrentMatchIdForTest("threaded_match");
+  const std::string userId = "me";
+  EXPECT_CALL(*mockSession, getUserId()).WillRepeatedly(testing::ReturnRef(userId));
+
+  auto owner = std::make_unique<Owner>(&ownerAlive);
+  const auto touch = [&] { if (!ownerAlive) ++callsAfterDeath; };
+  networking->setPlayerStateUpdateCallback(
+      [&](PlayerHandle, const sf::Vector2f&, unsigned int) { touch(); });
+  networking->setPresenceCallback([&](PlayerHandle, bool) { touch(); });
+  networking->startNetworkThread(std::chrono::microseconds(100));
+
+  const std::string payload =
+      R"({"type":"world_update","data":{"players":{"alice":{"position":{"x":1,"y":2}}}}})";
+  Nakama::NMatchData data;
+  data.opCode = 2;
+  data.data.assign(payload.begin(), payload.end());
+  networking->getInternalListener()->onMatchData(data);
+  Nakama::NMatchPresenceEvent presence;
+  presence.joins.push_back(Nakama::NUserPresence{});
+  presence.joins.back().userId = "bob";
+  networking->getInternalListener()->onMatchPresence(presence);
+  ASSERT_GT(networking->queueStats().inboundDepth, 0u);
+
+  owner.reset();       // the scene's members go first...
+  networking.reset();  // ...then its Networking, with messages still queued
+  EXPECT_EQ(callsAfterDeath, 0);
+}
+
+TEST(NetworkingTest, NetworkThreadQueuesMessagesForTick) {
+  auto mockNClient = std::make_shared<MockNClientFull>();
+  auto mockSession = std::make_shared<MockSession>();
+  auto mockRtClient = std::make_shared<MockRtClient>();
+  TestableNetworking networking(mockNClient);
+  ASSERT_TRUE(networking.initialize(mockSession));
+  networking.setProtectedRtClient(mockRtClient);
+  networking.setCurrentMatchIdForTest("threaded_match");
+
+  const std::string userId = "me";
+  EXPECT_CALL(*mockSession, getUserId()).WillRepeatedly(testing::ReturnRef(userId));
+  EXPECT_CALL(*mockRtClient, tick()).Times(testing::AnyNumber());
+  EXPECT_CALL(*mockRtClient, isConnected()).WillRepeatedly(testing::Return(true));
+  EXPECT_CALL(*mockRtClient, sendMatchData("threaded_match", 6, testing::_, testing::_))
+      .Times(testing::AnyNumber());
+  std::atomic<std::thread::id> sentFrom;
+  std::atomic<bool> sent{false};
+  EXPECT_CALL(*mockRtClient, sendMatchData("threaded_match", 1, testing::_, testing::_))
+      .WillOnce([&](const std::string&, std::int64_t, const Nakama::NBytes&,
+                    const std::vector<Nakama::NUserPresence>&) {
+        sentFrom = std::this_thread::get_id();
+        sent = true;
+      });
+
+  std::vector<std::pair<std::string, sf::Vector2f>> updates;
+  networking.setPlayerStateUpdateCallback(
+      [&](PlayerHandle player, const sf::Vector2f& position, unsigned int) {
+        updates.emplace_back(networking.playerIds().name(player), position);
+      });
+
+  networking.startNetworkThread(std::chrono::microseconds(100));
+  ASSERT_TRUE(networking.networkThreadRunning());
+
+  // Stand-in for the worker's receive callback: decoded and queued only.
+  const std::string payload =
+      R"({"type":"world_update","data":{"players":{)"
+      R"("alice":{"position":{"x":1,"y":2}},"bob":{"position":{"x":3,"y":4}}}}})";
+  Nakama::NMatchData data;
+  data.opCode = 2;
+  data.data.assign(payload.begin(), payload.end());
+  networking.getInternalListener()->onMatchData(data);
+  EXPECT_TRUE(updates.empty());
+  EXPECT_EQ(networking.queueStats().inboundDepth, 2u);
+
+  networking.tick();  // drains on this thread
+  ASSERT_EQ(updates.size(), 2u);
+  EXPECT_EQ(updates[0], std::make_pair(std::string("alice"), sf::Vector2f(1.f, 2.f)));
+  EXPECT_EQ(updates[1], std::make_pair(std::string("bob"), sf::Vector2f(3.f, 4.f)));
+
+  // Sends are encoded and sent by the worker.
+  networking.sendPlayerUpdate({1.f, 0.f}, 100.f, 1);
+  for (int i = 0; i < 1000 && !sent; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_TRUE(sent);
+  EXPECT_NE(sentFrom.load(), std::this_thread::get_id());
+
+  networking.stopNetworkThread();
+  EXPECT_FALSE(networking.networkThreadRunning());
+  const NetworkQueueStats stats = networking.queueStats();
+  EXPECT_EQ(stats.inboundDepth, 0u);
+  EXPECT_EQ(stats.inboundHighWater, 2u);
+  EXPECT_EQ(stats.inboundDropped, 0u);
+  EXPECT_EQ(stats.outboundDropped, 0u);
+}
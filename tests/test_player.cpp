@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include "SFML/System/Time.hpp"
 #include "SFML/System/Vector2.hpp"
 #include "world/entities/Player.h"
@@ -53,14 +56,16 @@ TEST_F(PlayerTest, HandleServerUpdate) {
 }
 
 TEST_F(PlayerTest, HandleServerAckApproved) {
+  // Input 1 is sent, then the player moves under it for 0.1 s.
   player.setTargetDirection({0.f, 1.f});
+  unsigned int seq = player.getNextSequenceNumber();
   player.update(sf::seconds(0.1f));
-  unsigned int seq = player.getNextSequenceNumber() - 1;
-  sf::Vector2f serverPos =
-      player.getPosition() + sf::Vector2f(0.f, player.getSpeed() * 0.1f);
+  // The server applied input 1 at a slightly different spot; the 0.1 s of
+  // movement since is replayed on top instead of snapping back.
+  sf::Vector2f serverPos(102.f, 100.f);
   player.handleServerAck(seq, true, serverPos);
-  EXPECT_EQ(player.getPosition().x, serverPos.x);
-  EXPECT_EQ(player.getPosition().y, serverPos.y);
+  EXPECT_NEAR(player.getPosition().x, 102.f, 1e-4f);
+  EXPECT_NEAR(player.getPosition().y, 100.f + player.getSpeed() * 0.1f, 1e-4f);
 }
 
 TEST_F(PlayerTest, HandleServerAckNotApproved) {
@@ -71,3 +76,85 @@ TEST_F(PlayerTest, HandleServerAckNotApproved) {
   EXPECT_EQ(player.getPosition().x, 90.f);
   EXPECT_EQ(player.getPosition().y, 90.f);
 }
+
+TEST_F(PlayerTest, CaptureSnapshotCopiesRenderState) {
+  ActorSnapshot snapshot;
+  player.captureSnapshot(snapshot);
+  EXPECT_EQ(snapshot.position, player.getPosition());
+  EXPECT_FLOAT_EQ(snapshot.radius, 15.f);
+  EXPECT_EQ(snapshot.color, sf::Color::Blue);
+}
+
+TEST_F(PlayerTest, AppendBodyEmitsTheCircleAsTriangles) {
+  player.setPosition({40.f, 60.f});
+  std::vector<sf::Vertex> body;
+  player.appendBody(body);
+  ASSERT_FALSE(body.empty());
+  EXPECT_EQ(body.size() % 3, 0u);
+  for (const sf::Vertex& vertex : body) {
+    EXPECT_EQ(vertex.color, sf::Color::Blue);
+    const sf::Vector2f d = vertex.position - player.getPosition();
+    EXPECT_LE(d.length(), 15.f + 1e-3f);
+  }
+}
+
+TEST(PlayerDebugText, RebuiltOnlyWhenShownIntegersChange) {
+  Player remote("remote", sf::Color::Red);
+  remote.handleServerUpdate({10.2f, 20.7f}, 1);
+  remote.update(sf::seconds(1.f));
+  EXPECT_EQ(remote.debugTextRebuilds(), 1u);
+  EXPECT_NE(remote.getDebugText().find("SrvPos: (10,20)"), std::string::npos);
+
+  // Sub-pixel movement renders the same integers: nothing to rebuild.
+  remote.handleServerUpdate({10.6f, 20.1f}, 1);
+  remote.update(sf::seconds(1.f));
+  EXPECT_EQ(remote.debugTextRebuilds(), 1u);
+
+  remote.handleServerUpdate({11.f, 20.f}, 2);
+  remote.update(sf::seconds(1.f));
+  EXPECT_EQ(remote.debugTextRebuilds(), 2u);
+  EXPECT_NE(remote.getDebugText().find("Ack: 2"), std::string::npos);
+}
+
+TEST(PlayerDebugText, RebuildsAreThrottled) {
+  const float rate = Player::debugTextRate();
+  Player::setDebugTextRate(2.f);  // at most every 0.5 s
+
+  Player remote("remote", sf::Color::Red);
+  remote.handleServerUpdate({1.f, 1.f}, 1);
+  remote.update(sf::seconds(0.1f));
+  EXPECT_EQ(remote.debugTextRebuilds(), 1u);
+
+  remote.handleServerUpdate({2.f, 1.f}, 2);
+  remote.update(sf::seconds(0.1f));
+  remote.handleServerUpdate({3.f, 1.f}, 3);
+  remote.update(sf::seconds(0.1f));
+  EXPECT_EQ(remote.debugTextRebuilds(), 1u);
+
+  remote.update(sf::seconds(0.4f));
+  EXPECT_EQ(remote.debugTextRebuilds(), 2u);
+  EXPECT_NE(remote.getDebugText().find("SrvPos: (3,1)"), std::string::npos);
+
+  Player::setDebugTextRate(rate);
+}
+
+TEST(PlayerDebugText, TogglePerPlayerClass) {
+  Player local("local", sf::Color::Green, true);
+  Player remote("remote", sf::Color::Red);
+
+  Player::setDebugTextEnabled(false, false);
+  local.handleServerUpdate({5.f, 5.f}, 1);
+  remote.handleServerUpdate({5.f, 5.f}, 1);
+  local.update(sf::seconds(1.f));
+  remote.update(sf::seconds(1.f));
+  EXPECT_EQ(local.debugTextRebuilds(), 1u);
+  EXPECT_EQ(remote.debugTextRebuilds(), 0u);
+
+  ActorSnapshot snapshot;
+  remote.captureSnapshot(snapshot);
+  EXPECT_TRUE(snapshot.debugText.empty());
+
+  Player::setDebugTextEnabled(false, true);
+  remote.update(sf::seconds(1.f));
+  EXPECT_EQ(remote.debugTextRebuilds(), 1u);
+}
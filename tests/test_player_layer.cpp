@@ -0,0 +1,68 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include "graphics/FontCache.h"
+#include "graphics/RenderCommandList.h"
+#include "graphics/TextBatch.h"
+#include "world/WorldMap.h"
+#include "world/WorldRenderer.h"
+#include "world/entities/Player.h"
+#include "world/entities/PlayerLayer.h"
+
+namespace {
+
+const sf::View kView(sf::Vector2f{200.f, 200.f}, sf::Vector2f{400.f, 400.f});
+
+class PlayerLayerTest : public ::testing::Test {
+ protected:
+  PlayerLayerTest() : renderer(map), labels(FontCache::instance().defaultFont()) {
+    renderer.setDebugObjectAreas(false);
+    renderer.setDepthSorting(true);
+    list.setView(kView);
+  }
+
+  WorldMap map;
+  WorldRenderer renderer;
+  TextBatch labels;
+  RenderCommandList list;
+  PlayerLayer layer;
+};
+
+}  // namespace
+
+TEST_F(PlayerLayerTest, DrawsEveryBodyThroughTheSinkInFootOrder) {
+  Player local("local", sf::Color::Blue, true);
+  local.setPosition({100.f, 150.f});
+  layer.setLocalPlayer(&local);
+  EXPECT_TRUE(layer.applyServerState(1, "near", {120.f, 50.f}, 0));
+  EXPECT_FALSE(layer.applyServerState(1, "near", {120.f, 60.f}, 1));
+  EXPECT_TRUE(layer.applyServerState(2, "far", {5000.f, 5000.f}, 0));
+
+  const sf::FloatRect interest = layer.update(sf::milliseconds(16), kView);
+  EXPECT_FLOAT_EQ(interest.position.x, -PlayerLayer::kInterestMargin);
+  layer.render(renderer, list, labels);
+
+  // The far player is out of interest; the remote one is drawn first, as
+  // its feet are higher up.
+  EXPECT_EQ(layer.drawn(), 2u);
+  ASSERT_EQ(list.records().size(), 2u);
+  EXPECT_EQ(list.droppedDrawables(), 0u);
+  EXPECT_EQ(list.vertices()[list.records()[0].firstVertex].color, sf::Color::Red);
+  EXPECT_EQ(list.vertices()[list.records()[1].firstVertex].color, sf::Color::Blue);
+}
+
+TEST_F(PlayerLayerTest, DespawnAndLocalRemovalLeaveThePass) {
+  Player local("local", sf::Color::Blue, true);
+  layer.setLocalPlayer(&local);
+  layer.applyServerState(1, "remote", {120.f, 50.f}, 0);
+  EXPECT_TRUE(layer.despawn(1));
+  EXPECT_FALSE(layer.despawn(1));
+  layer.setLocalPlayer(nullptr);
+
+  layer.update(sf::milliseconds(16), kView);
+  layer.render(renderer, list, labels);
+  EXPECT_EQ(layer.drawn(), 0u);
+  EXPECT_TRUE(list.records().empty());
+  EXPECT_TRUE(layer.remotePlayers().empty());
+}
@@ -0,0 +1,146 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+#include <utility>
+
+#include "graphics/RenderCommandList.h"
+#include "world/WorldMap.h"
+#include "world/WorldRenderer.h"
+
+// Build a ground layer with one 16x16 quad per bucket laid out on a grid.
+static WorldMap::LayerMesh makeGroundLayer(int cols, int rows, const sf::Texture* tex) {
+  WorldMap::LayerMesh layer;
+  layer.type = "tilelayer";
+  layer.name = "world";
+  for (int y = 0; y < rows; ++y) {
+    for (int x = 0; x < cols; ++x) {
+      WorldMap::LayerMesh::CellKey key{x, y};
+      WorldMap::LayerMesh::Chunk ch;
+      ch.texture = tex;
+      ch.vertices.resize(6);
+      const float x0 = static_cast<float>(x * 16), y0 = static_cast<float>(y * 16);
+      const float x1 = x0 + 16.f, y1 = y0 + 16.f;
+      ch.vertices[0].position = {x0, y0};
+      ch.vertices[1].position = {x1, y0};
+      ch.vertices[2].position = {x1, y1};
+      ch.vertices[3].position = {x0, y0};
+      ch.vertices[4].position = {x1, y1};
+      ch.vertices[5].position = {x0, y1};
+      layer.chunk_buckets[key].chunks.push_back(std::move(ch));
+      layer.chunk_bucket_order.push_back(key);
+    }
+  }
+  return layer;
+}
+
+static sf::View viewAt(float cx, float cy, float w, float h) {
+  return sf::View(sf::Vector2f{cx, cy}, sf::Vector2f{w, h});
+}
+
+TEST(RenderCommandList, RecordsCulledGroundChunks) {
+  sf::Texture tex;
+  WorldMap wm;
+  wm.setTileSize(16, 16);
+  wm.layersMutable().push_back(makeGroundLayer(10, 10, &tex));
+
+  WorldRenderer renderer(wm);
+  renderer.setCulling(true);
+
+  // A 30x30 view around (40, 40) spans x/y 25..55, i.e. a 3x3 block of quads.
+  RenderCommandList list;
+  list.setView(viewAt(40.f, 40.f, 30.f, 30.f));
+  renderer.resetStats();
+  renderer.renderGround(list);
+
+  EXPECT_EQ(list.records().size(), renderer.stats().chunksDrawn);
+  EXPECT_EQ(list.records().size(), 9u);
+  EXPECT_EQ(renderer.stats().chunksDrawn + renderer.stats().chunksCulled, 100u);
+  EXPECT_EQ(list.vertices().size(), list.records().size() * 6);
+  for (const auto& rec : list.records()) EXPECT_EQ(rec.texture, &tex);
+}
+
+TEST(RenderCommandList, ReplayMatchesDirectEmission) {
+  sf::Texture tex;
+  WorldMap wm;
+  wm.setTileSize(16, 16);
+  wm.layersMutable().push_back(makeGroundLayer(8, 8, &tex));
+
+  WorldRenderer renderer(wm);
+  const sf::View view = viewAt(64.f, 64.f, 64.f, 64.f);
+
+  NullRenderSink direct;
+  direct.setView(view);
+  renderer.renderGround(direct);
+
+  RenderCommandList list;
+  list.setView(view);
+  renderer.renderGround(list);
+  NullRenderSink replayed;
+  replayed.setView(view);
+  list.replay(replayed);
+
+  EXPECT_GT(direct.drawCalls(), 0u);
+  EXPECT_EQ(direct.drawCalls(), replayed.drawCalls());
+  EXPECT_EQ(direct.vertexCount(), replayed.vertexCount());
+  EXPECT_EQ(direct.hash(), replayed.hash());
+}
+
+TEST(RenderCommandList, ClearReusesStorage) {
+  sf::Texture tex;
+  WorldMap wm;
+  wm.setTileSize(16, 16);
+  wm.layersMutable().push_back(makeGroundLayer(4, 4, &tex));
+
+  WorldRenderer renderer(wm);
+  renderer.setCulling(false);
+  RenderCommandList list;
+  renderer.renderGround(list);
+  const auto capacity = list.vertices().capacity();
+  ASSERT_EQ(list.records().size(), 16u);
+
+  list.clear();
+  EXPECT_TRUE(list.records().empty());
+  renderer.renderGround(list);
+  EXPECT_EQ(list.records().size(), 16u);
+  EXPECT_EQ(list.vertices().capacity(), capacity);
+}
+
+TEST(NullRenderSink, HashIsDeterministicAndViewDependent) {
+  sf::Texture tex;
+  WorldMap wm;
+  wm.setTileSize(16, 16);
+  wm.layersMutable().push_back(makeGroundLayer(20, 20, &tex));
+
+  WorldRenderer renderer(wm);
+  renderer.setCulling(true);
+
+  NullRenderSink a;
+  a.setView(viewAt(80.f, 80.f, 64.f, 48.f));
+  renderer.renderGround(a);
+  const auto first = a.hash();
+
+  a.reset();
+  renderer.renderGround(a);
+  EXPECT_EQ(a.hash(), first);
+
+  a.reset();
+  a.setView(viewAt(200.f, 120.f, 64.f, 48.f));
+  renderer.renderGround(a);
+  EXPECT_NE(a.hash(), first);
+}
+
+TEST(RenderCommandList, DebugGridIsRecordedAsVertices) {
+  WorldMap wm;
+  wm.setTileSize(16, 16);
+  wm.layersMutable().push_back(makeGroundLayer(2, 2, nullptr));
+
+  WorldRenderer renderer(wm);
+  renderer.setDebugGrid(true);
+  RenderCommandList list;
+  list.setView(viewAt(16.f, 16.f, 32.f, 32.f));
+  renderer.renderGround(list);
+
+  // Grid lines are a vertex array, so they are recorded rather than dropped.
+  EXPECT_EQ(list.droppedDrawables(), 0u);
+  EXPECT_EQ(list.records().size(), 5u);
+}
@@ -0,0 +1,33 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include "graphics/RenderSnapshot.h"
+
+TEST(RenderSnapshot, AddActorReusesSlotsAfterClear) {
+  RenderSnapshot snapshot;
+  snapshot.addActor().label = "alice";
+  snapshot.addActor().label = "bob";
+  ASSERT_EQ(snapshot.actorCount, 2u);
+  const ActorSnapshot* first = &snapshot.actors[0];
+
+  snapshot.clear();
+  EXPECT_EQ(snapshot.actorCount, 0u);
+  EXPECT_EQ(snapshot.actors.size(), 2u);
+
+  ActorSnapshot& reused = snapshot.addActor();
+  EXPECT_EQ(&reused, first);
+  EXPECT_EQ(snapshot.actorCount, 1u);
+}
+
+TEST(RenderSnapshot, ClearEmptiesCommandLists) {
+  RenderSnapshot snapshot;
+  sf::Vertex quad[6];
+  snapshot.ground.draw(quad, 6, sf::PrimitiveType::Triangles, sf::RenderStates{});
+  snapshot.overlays.draw(quad, 6, sf::PrimitiveType::Triangles, sf::RenderStates{});
+  ASSERT_EQ(snapshot.ground.records().size(), 1u);
+
+  snapshot.clear();
+  EXPECT_TRUE(snapshot.ground.records().empty());
+  EXPECT_TRUE(snapshot.overlays.records().empty());
+}
@@ -0,0 +1,49 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include "graphics/RenderStats.h"
+
+TEST(FrameTimeHistory, EmptyHistoryReportsZero) {
+  FrameTimeHistory history(8);
+  EXPECT_EQ(history.size(), 0u);
+  EXPECT_FLOAT_EQ(history.percentile(0.5f), 0.f);
+  EXPECT_FLOAT_EQ(history.average(), 0.f);
+  EXPECT_FLOAT_EQ(history.max(), 0.f);
+}
+
+TEST(FrameTimeHistory, PercentilesUseNearestRank) {
+  FrameTimeHistory history(100);
+  for (int i = 1; i <= 100; ++i) history.push(static_cast<float>(i));
+
+  EXPECT_FLOAT_EQ(history.percentile(0.50f), 50.f);
+  EXPECT_FLOAT_EQ(history.percentile(0.95f), 95.f);
+  EXPECT_FLOAT_EQ(history.percentile(0.99f), 99.f);
+  EXPECT_FLOAT_EQ(history.percentile(1.0f), 100.f);
+  EXPECT_FLOAT_EQ(history.max(), 100.f);
+  EXPECT_FLOAT_EQ(history.average(), 50.5f);
+}
+
+TEST(FrameTimeHistory, RingOverwritesOldestSamples) {
+  FrameTimeHistory history(4);
+  for (float v : {100.f, 100.f, 1.f, 2.f, 3.f, 4.f}) history.push(v);
+
+  EXPECT_EQ(history.size(), 4u);
+  EXPECT_FLOAT_EQ(history.max(), 4.f);
+  // Oldest remaining sample (1.0) is at the reported offset.
+  EXPECT_FLOAT_EQ(history.data()[history.offset()], 1.f);
+}
+
+TEST(RenderStats, ResetClearsCountersAndLayers) {
+  RenderStats stats;
+  stats.drawCalls = 10;
+  stats.chunksCulled = 3;
+  stats.groundMs = 1.5f;
+  stats.layers.push_back({"world", 0.2f, 4, 24});
+
+  stats.reset();
+  EXPECT_EQ(stats.drawCalls, 0u);
+  EXPECT_EQ(stats.chunksCulled, 0u);
+  EXPECT_FLOAT_EQ(stats.groundMs, 0.f);
+  EXPECT_TRUE(stats.layers.empty());
+}
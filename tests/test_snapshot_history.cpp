@@ -0,0 +1,179 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "networking/SnapshotHistory.h"
+#include "networking/WireProtocol.h"
+#include "support/SnapshotServer.h"
+
+namespace {
+
+// Rebuilds the game's view the way Networking does: netIds are bound to
+// user ids when introduced, later entries carry the netId only.
+class WorldView : public MessageSink {
+ public:
+  void emit(InboundMessage& message) override {
+    if (!message.userId.empty()) names[message.netId] = std::string(message.userId.view());
+    positions[names.at(message.netId)] = message.position;
+    ++delivered;
+  }
+
+  std::map<std::uint32_t, std::string> names;
+  std::map<std::string, sf::Vector2f> positions;
+  std::size_t delivered = 0;
+};
+
+std::vector<SnapshotServer::Player> makePlayers(int n) {
+  std::vector<SnapshotServer::Player> players;
+  for (int i = 0; i < n; ++i) {
+    players.push_back({static_cast<std::uint32_t>(i * 3), "player-" + std::to_string(i),
+                       {i * 10.f, i * 5.f}, 0});
+  }
+  return players;
+}
+
+}  // namespace
+
+TEST(SnapshotHistory, RebuildsFullStateFromDeltas) {
+  SnapshotServer server;
+  SnapshotHistory history;
+  WorldView view;
+  InboundMessage scratch;
+  std::string bytes;
+  auto players = makePlayers(5);
+
+  server.encode(players, bytes);
+  ASSERT_TRUE(history.apply(bytes, scratch, view));
+  server.acknowledge(history.latestId());
+  EXPECT_EQ(view.delivered, 5u);
+  const std::size_t fullSize = bytes.size();
+
+  players[2].position = {123.5f, -4.f};
+  players[2].lastSequence = 9;
+  server.encode(players, bytes);
+  EXPECT_LT(bytes.size(), fullSize / 3);  // one changed player
+  ASSERT_TRUE(history.apply(bytes, scratch, view));
+  server.acknowledge(history.latestId());
+
+  EXPECT_EQ(view.delivered, 10u);  // every player again, as a world_update would
+  EXPECT_EQ(view.positions.at("player-2"), sf::Vector2f(123.5f, -4.f));
+  EXPECT_EQ(view.positions.at("player-4"), sf::Vector2f(40.f, 20.f));
+  const auto* latest = history.find(history.latestId());
+  ASSERT_NE(latest, nullptr);
+  EXPECT_EQ((*latest)[2].lastSequence, 9u);
+}
+
+TEST(SnapshotHistory, JoinsAndLeavesAgainstTheBaseline) {
+  SnapshotServer server;
+  SnapshotHistory history;
+  WorldView view;
+  InboundMessage scratch;
+  std::string bytes;
+  auto players = makePlayers(3);
+  server.encode(players, bytes);
+  history.apply(bytes, scratch, view);
+  server.acknowledge(history.latestId());
+
+  players.erase(players.begin() + 1);
+  players.push_back({100, "late", {7.f, 8.f}, 0});
+  server.encode(players, bytes);
+  ASSERT_TRUE(history.apply(bytes, scratch, view));
+
+  const auto* latest = history.find(history.latestId());
+  ASSERT_NE(latest, nullptr);
+  ASSERT_EQ(latest->size(), 3u);
+  EXPECT_EQ((*latest)[0].netId, 0u);
+  EXPECT_EQ((*latest)[1].netId, 6u);
+  EXPECT_EQ((*latest)[2].netId, 100u);
+  EXPECT_EQ(view.positions.at("late"), sf::Vector2f(7.f, 8.f));
+}
+
+TEST(SnapshotHistory, LostPacketsFallBackToTheAcknowledgedBaseline) {
+  SnapshotServer server;
+  SnapshotHistory history;
+  WorldView view;
+  InboundMessage scratch;
+  std::string bytes;
+  auto players = makePlayers(4);
+
+  for (int tick = 1; tick <= 20; ++tick) {
+    players[tick % 4].position.x += 1.f;
+    server.encode(players, bytes);
+    if (tick % 3 == 0) continue;  // lost on the way down
+    ASSERT_TRUE(history.apply(bytes, scratch, view));
+    if (tick % 5 != 0) server.acknowledge(history.latestId());  // ack lost otherwise
+  }
+  EXPECT_EQ(history.stats().missingBaseline, 0u);
+  for (const auto& player : players) {
+    EXPECT_EQ(view.positions.at(player.userId), player.position) << player.userId;
+  }
+}
+
+TEST(SnapshotHistory, DropsStaleSnapshotsAndUnknownBaselines) {
+  SnapshotServer server;
+  SnapshotHistory history;
+  WorldView view;
+  InboundMessage scratch;
+  auto players = makePlayers(2);
+  std::string first, second;
+  server.encode(players, first);
+  server.encode(players, second);
+
+  ASSERT_TRUE(history.apply(second, scratch, view));
+  ASSERT_TRUE(history.apply(first, scratch, view));  // arrived late
+  EXPECT_EQ(history.stats().stale, 1u);
+  EXPECT_EQ(history.latestId(), 2u);
+
+  // A baseline the client never had.
+  std::string bytes;
+  wire::SnapshotWriter writer(bytes, 50, 40, 0);
+  EXPECT_TRUE(history.apply(bytes, scratch, view));
+  EXPECT_EQ(history.stats().missingBaseline, 1u);
+  EXPECT_EQ(history.latestId(), 2u);
+  EXPECT_EQ(view.delivered, 2u);
+}
+
+TEST(SnapshotHistory, RejectsMalformedSnapshots) {
+  SnapshotHistory history;
+  WorldView view;
+  InboundMessage scratch;
+  std::string bytes;
+  {
+    wire::SnapshotWriter writer(bytes, 1, 0, 2);
+    writer.add({5, wire::SnapshotEntry::kUserId, "b"});
+    writer.add({4, wire::SnapshotEntry::kUserId, "a"});  // not ascending
+  }
+  EXPECT_FALSE(history.apply(bytes, scratch, view));
+  bytes.resize(bytes.size() - 3);
+  EXPECT_FALSE(history.apply(bytes, scratch, view));
+  EXPECT_EQ(history.stats().malformed, 2u);
+  EXPECT_EQ(history.latestId(), 0u);
+  EXPECT_EQ(history.find(1), nullptr);
+  EXPECT_EQ(view.delivered, 0u);
+}
+
+TEST(SnapshotHistory, TruncatedSnapshotMovesNoOne) {
+  SnapshotServer server;
+  SnapshotHistory history;
+  WorldView view;
+  InboundMessage scratch;
+  std::string bytes;
+  auto players = makePlayers(6);
+  server.encode(players, bytes);
+  ASSERT_TRUE(history.apply(bytes, scratch, view));
+  server.acknowledge(history.latestId());
+  const auto before = view.positions;
+  const std::size_t delivered = view.delivered;
+
+  for (auto& player : players) player.position += {7.f, -3.f};
+  server.encode(players, bytes);
+  bytes.resize(bytes.size() / 2);
+  EXPECT_FALSE(history.apply(bytes, scratch, view));
+  EXPECT_EQ(view.delivered, delivered);
+  EXPECT_EQ(view.positions, before);
+  EXPECT_EQ(history.latestId(), 1u);
+}
@@ -0,0 +1,51 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "world/entities/SpatialHash.h"
+
+namespace {
+
+std::vector<std::uint32_t> queryRect(const SpatialHash& hash, sf::FloatRect rect) {
+  std::vector<std::uint32_t> out;
+  hash.query(rect, out);
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+}  // namespace
+
+TEST(SpatialHash, QueryReturnsIdsInOverlappingCells) {
+  SpatialHash hash(100.f);
+  hash.insert(0, {10.f, 10.f});
+  hash.insert(1, {150.f, 20.f});
+  hash.insert(2, {-50.f, -50.f});
+  hash.insert(3, {1000.f, 1000.f});
+  EXPECT_EQ(hash.size(), 4u);
+
+  EXPECT_EQ(queryRect(hash, {{0.f, 0.f}, {50.f, 50.f}}), (std::vector<std::uint32_t>{0}));
+  EXPECT_EQ(queryRect(hash, {{-10.f, -10.f}, {120.f, 50.f}}),
+            (std::vector<std::uint32_t>{0, 1, 2}));
+  EXPECT_TRUE(queryRect(hash, {{400.f, 400.f}, {50.f, 50.f}}).empty());
+}
+
+TEST(SpatialHash, MoveAndRemoveKeepBucketsConsistent) {
+  SpatialHash hash(100.f);
+  hash.insert(0, {10.f, 10.f});
+  hash.insert(1, {20.f, 20.f});
+  hash.update(0, {30.f, 40.f});  // same cell
+  hash.update(1, {520.f, 20.f});
+  EXPECT_EQ(queryRect(hash, {{0.f, 0.f}, {90.f, 90.f}}), (std::vector<std::uint32_t>{0}));
+  EXPECT_EQ(queryRect(hash, {{500.f, 0.f}, {90.f, 90.f}}), (std::vector<std::uint32_t>{1}));
+
+  hash.remove(0);
+  hash.remove(0);  // already gone
+  hash.update(0, {520.f, 20.f});  // not present, ignored
+  EXPECT_EQ(hash.size(), 1u);
+  EXPECT_TRUE(queryRect(hash, {{0.f, 0.f}, {90.f, 90.f}}).empty());
+  EXPECT_EQ(queryRect(hash, {{500.f, 0.f}, {90.f, 90.f}}), (std::vector<std::uint32_t>{1}));
+}
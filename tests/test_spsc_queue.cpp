@@ -0,0 +1,69 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "networking/SpscQueue.h"
+
+TEST(SpscQueue, FifoUntilFullThenRejects) {
+  SpscQueue<int, 4> queue;
+  EXPECT_TRUE(queue.empty());
+  for (int i = 0; i < 4; ++i) EXPECT_TRUE(queue.tryPush(int{i}));
+  EXPECT_FALSE(queue.tryPush(99));
+  EXPECT_EQ(queue.size(), 4u);
+  EXPECT_EQ(queue.highWater(), 4u);
+
+  int value = -1;
+  ASSERT_TRUE(queue.tryPop(value));
+  EXPECT_EQ(value, 0);
+  EXPECT_TRUE(queue.tryPush(4));  // wraps around
+  for (int expected = 1; expected <= 4; ++expected) {
+    ASSERT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, expected);
+  }
+  EXPECT_FALSE(queue.tryPop(value));
+  EXPECT_EQ(queue.highWater(), 4u);
+}
+
+TEST(SpscQueue, MovesElementsInAndOut) {
+  SpscQueue<std::string, 2> queue;
+  std::string long_text(100, 'x');
+  ASSERT_TRUE(queue.tryPush(std::move(long_text)));
+  std::string out;
+  ASSERT_TRUE(queue.tryPop(out));
+  EXPECT_EQ(out, std::string(100, 'x'));
+}
+
+TEST(SpscQueue, TwoThreadsSeeEveryItemInOrder) {
+  constexpr int kItems = 200000;
+  SpscQueue<int, 256> queue;
+  std::thread producer([&] {
+    for (int i = 0; i < kItems; ++i) {
+      while (!queue.tryPush(int{i})) std::this_thread::yield();
+    }
+  });
+
+  // Keep draining after a mismatch so the producer can finish and be
+  // joined; the first mismatch is checked once it has.
+  int received = 0;
+  int value = 0;
+  int mismatchAt = -1, mismatchValue = 0;
+  while (received < kItems) {
+    if (!queue.tryPop(value)) {
+      std::this_thread::yield();
+      continue;
+    }
+    if (value != received && mismatchAt < 0) {
+      mismatchAt = received;
+      mismatchValue = value;
+    }
+    ++received;
+  }
+  producer.join();
+  EXPECT_EQ(mismatchAt, -1) << "item " << mismatchAt << " was " << mismatchValue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_LE(queue.highWater(), queue.capacity());
+}
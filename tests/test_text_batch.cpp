@@ -0,0 +1,93 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "graphics/FontCache.h"
+#include "graphics/RenderCommandList.h"
+#include "graphics/TextBatch.h"
+#include "world/entities/Player.h"
+
+TEST(FontCache, FailedLoadIsCachedAndReportedOnce) {
+  FontCache& cache = FontCache::instance();
+  const std::size_t before = cache.loadCount();
+  EXPECT_EQ(cache.get("/nonexistent/wildspark-test.ttf"), nullptr);
+  EXPECT_EQ(cache.get("/nonexistent/wildspark-test.ttf"), nullptr);
+  EXPECT_EQ(cache.loadCount(), before + 1);
+}
+
+TEST(FontCache, SpawningPlayersDoesNotReloadFonts) {
+  Player first("first");
+  const std::size_t loads = FontCache::instance().loadCount();
+  const sf::Font* font = FontCache::instance().defaultFont();
+
+  std::vector<std::unique_ptr<Player>> crowd;
+  for (int i = 0; i < 500; ++i) {
+    crowd.push_back(std::make_unique<Player>("remote_" + std::to_string(i), sf::Color::Red));
+  }
+  EXPECT_EQ(FontCache::instance().loadCount(), loads);
+  EXPECT_EQ(FontCache::instance().defaultFont(), font);
+}
+
+TEST(TextBatch, AllLabelsShareOneDrawCall) {
+  sf::Font font;
+  TextBatch batch(&font);
+  batch.add("ab", {10.f, 10.f}, 12);
+  batch.add("c d", {50.f, 10.f}, 10, sf::Color::Yellow, TextBatch::Anchor::Center);
+  batch.add("e\nf", {90.f, 10.f}, 12);
+
+  // Whitespace and newlines produce no quads.
+  EXPECT_EQ(batch.glyphCount(), 6u);
+
+  NullRenderSink sink;
+  batch.draw(sink);
+  EXPECT_EQ(sink.drawCalls(), 1u);
+  EXPECT_EQ(sink.vertexCount(), 36u);
+
+  batch.clear();
+  sink.reset();
+  batch.draw(sink);
+  EXPECT_EQ(sink.drawCalls(), 0u);
+}
+
+TEST(TextBatch, CachedLayoutIsPlacedByTranslation) {
+  sf::Font font;
+  TextBatch batch(&font);
+  TextLayout layout;
+  batch.layout("label", 12, sf::Color::White, layout);
+  ASSERT_FALSE(layout.vertices.empty());
+
+  batch.add(layout, {0.f, 0.f});
+  batch.add(layout, {25.f, -5.f});
+  const auto& v = batch.vertices();
+  const std::size_t n = layout.vertices.size();
+  ASSERT_EQ(v.size(), 2 * n);
+  for (std::size_t i = 0; i < n; ++i) {
+    EXPECT_FLOAT_EQ(v[n + i].position.x - v[i].position.x, 25.f);
+    EXPECT_FLOAT_EQ(v[n + i].position.y - v[i].position.y, -5.f);
+    EXPECT_EQ(v[n + i].texCoords, v[i].texCoords);
+  }
+}
+
+TEST(TextBatch, SmallerSizesAreScaledFromTheAtlas) {
+  sf::Font font;
+  TextBatch batch(&font, 12);
+  TextLayout full, half;
+  batch.layout("xy", 12, sf::Color::White, full);
+  batch.layout("xy", 6, sf::Color::White, half);
+  ASSERT_EQ(full.vertices.size(), half.vertices.size());
+  for (std::size_t i = 0; i < full.vertices.size(); ++i) {
+    EXPECT_FLOAT_EQ(half.vertices[i].position.x * 2.f, full.vertices[i].position.x);
+    EXPECT_FLOAT_EQ(half.vertices[i].position.y * 2.f, full.vertices[i].position.y);
+    // Same atlas texels regardless of requested size.
+    EXPECT_EQ(half.vertices[i].texCoords, full.vertices[i].texCoords);
+  }
+}
+
+TEST(TextBatch, NoFontProducesNothing) {
+  TextBatch batch(nullptr);
+  batch.add("name", {0.f, 0.f}, 12);
+  EXPECT_TRUE(batch.empty());
+}
@@ -0,0 +1,148 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+#include <utility>
+
+#include "world/WorldMap.h"
+#include "world/WorldRenderer.h"
+
+// 4-column spritesheet of 16x16 tiles where tile 0 animates 0 -> 1 -> 2.
+static WorldMap::Tileset makeAnimatedTileset() {
+  WorldMap::Tileset ts;
+  ts.firstGid = 1;
+  ts.tileWidth = 16;
+  ts.tileHeight = 16;
+  ts.columns = 4;
+  ts.animations[0] = {{0, 100}, {1, 100}, {2, 200}};
+  return ts;
+}
+
+static void appendTileQuad(WorldMap::LayerMesh::Chunk& ch, float x, float y) {
+  const size_t base = ch.vertices.getVertexCount();
+  ch.vertices.resize(base + 6);
+  ch.vertices[base + 0].position = {x, y};
+  ch.vertices[base + 1].position = {x + 16.f, y};
+  ch.vertices[base + 2].position = {x + 16.f, y + 16.f};
+  ch.vertices[base + 3].position = {x, y};
+  ch.vertices[base + 4].position = {x + 16.f, y + 16.f};
+  ch.vertices[base + 5].position = {x, y + 16.f};
+}
+
+TEST(TileAnimation, ParsesTiledAnimationFrames) {
+  WorldMap::Tileset ts;
+  const auto tile = nlohmann::json::parse(
+      R"({"id": 7, "animation": [{"tileid": 7, "duration": 120},
+                                 {"tileid": 8, "duration": 80}]})");
+  WorldMap::parseTileAnimation(tile, ts);
+
+  ASSERT_EQ(ts.animations.count(7), 1u);
+  const auto& frames = ts.animations.at(7);
+  ASSERT_EQ(frames.size(), 2u);
+  EXPECT_EQ(frames[0].tileId, 7);
+  EXPECT_EQ(frames[0].durationMs, 120);
+  EXPECT_EQ(frames[1].tileId, 8);
+  EXPECT_EQ(frames[1].durationMs, 80);
+
+  WorldMap::Tileset plain;
+  WorldMap::parseTileAnimation(nlohmann::json::parse(R"({"id": 1})"), plain);
+  EXPECT_TRUE(plain.animations.empty());
+}
+
+TEST(TileAnimation, RewritesOnlyVisibleTilesWhenFrameChanges) {
+  WorldMap wm;
+  wm.setTileSize(16, 16);
+  wm.tilesetsMutable().push_back(makeAnimatedTileset());
+  const auto& ts = wm.tilesets().front();
+
+  WorldMap::LayerMesh::Chunk ch;
+  appendTileQuad(ch, 0.f, 0.f);       // on screen
+  appendTileQuad(ch, 1000.f, 0.f);    // off screen, same row
+  appendTileQuad(ch, 0.f, 1000.f);    // off screen, later row
+  wm.registerAnimatedTileForTests(ch, ts, 0, 0, false, false, false);
+  wm.registerAnimatedTileForTests(ch, ts, 0, 6, false, false, false);
+  wm.registerAnimatedTileForTests(ch, ts, 0, 12, false, false, false);
+  ASSERT_TRUE(wm.hasAnimations());
+
+  const sf::FloatRect view({0.f, 0.f}, {64.f, 64.f});
+  EXPECT_EQ(wm.applyAnimationFrames(ch, &view), 1u);
+  EXPECT_EQ(ch.vertices[0].texCoords, sf::Vector2f(0.f, 0.f));
+
+  // Same frame: nothing to rewrite.
+  EXPECT_EQ(wm.applyAnimationFrames(ch, &view), 0u);
+
+  wm.advanceAnimations(sf::milliseconds(150));
+  EXPECT_EQ(wm.applyAnimationFrames(ch, &view), 1u);
+  EXPECT_EQ(ch.vertices[0].texCoords, sf::Vector2f(16.f, 0.f));
+  EXPECT_EQ(ch.vertices[2].texCoords, sf::Vector2f(32.f, 16.f));
+  // Off-screen tiles keep their load-time UVs.
+  EXPECT_EQ(ch.vertices[6].texCoords, sf::Vector2f(0.f, 0.f));
+
+  // Animation loops after 400 ms total.
+  wm.advanceAnimations(sf::milliseconds(300));
+  EXPECT_EQ(wm.applyAnimationFrames(ch, nullptr), 3u);
+  EXPECT_EQ(ch.vertices[0].texCoords, sf::Vector2f(0.f, 0.f));
+}
+
+TEST(TileAnimation, TallObjectsReachingIntoTheViewKeepAnimating) {
+  WorldMap wm;
+  wm.setTileSize(16, 16);
+  wm.tilesetsMutable().push_back(makeAnimatedTileset());
+
+  // A 16x16 tile placed as an object 64 px tall, its top well above the
+  // view and its lower half on screen.
+  WorldMap::LayerMesh::Chunk ch;
+  appendTileQuad(ch, 0.f, -40.f);
+  for (int i : {2, 4, 5}) ch.vertices[i].position.y = 24.f;
+  wm.registerAnimatedTileForTests(ch, wm.tilesets().front(), 0, 0, false, false, false);
+
+  const sf::FloatRect view({0.f, 0.f}, {64.f, 64.f});
+  wm.advanceAnimations(sf::milliseconds(100));
+  EXPECT_EQ(wm.applyAnimationFrames(ch, &view), 1u);
+  EXPECT_EQ(ch.vertices[0].texCoords, sf::Vector2f(16.f, 0.f));
+}
+
+TEST(TileAnimation, FlippedTilesKeepTheirOrientation) {
+  WorldMap wm;
+  wm.setTileSize(16, 16);
+  wm.tilesetsMutable().push_back(makeAnimatedTileset());
+
+  WorldMap::LayerMesh::Chunk ch;
+  appendTileQuad(ch, 0.f, 0.f);
+  wm.registerAnimatedTileForTests(ch, wm.tilesets().front(), 0, 0, true, false, false);
+  wm.advanceAnimations(sf::milliseconds(100));
+  ASSERT_EQ(wm.applyAnimationFrames(ch, nullptr), 1u);
+
+  // Horizontal flip swaps left and right edges of frame 1 (u 16..32).
+  EXPECT_EQ(ch.vertices[0].texCoords, sf::Vector2f(32.f, 0.f));
+  EXPECT_EQ(ch.vertices[1].texCoords, sf::Vector2f(16.f, 0.f));
+}
+
+TEST(TileAnimation, RendererCountsVisibleAnimatedTiles) {
+  WorldMap wm;
+  wm.setTileSize(16, 16);
+  wm.tilesetsMutable().push_back(makeAnimatedTileset());
+
+  WorldMap::LayerMesh layer;
+  layer.type = "tilelayer";
+  layer.name = "world";
+  WorldMap::LayerMesh::Chunk ch;
+  for (int i = 0; i < 8; ++i) {
+    appendTileQuad(ch, 16.f * i, 0.f);
+    wm.registerAnimatedTileForTests(ch, wm.tilesets().front(), 0, 6 * i, false, false, false);
+  }
+  layer.chunk_buckets[{0, 0}].chunks.push_back(std::move(ch));
+  layer.chunk_bucket_order.push_back({0, 0});
+  wm.layersMutable().push_back(std::move(layer));
+
+  WorldRenderer renderer(wm);
+  renderer.setCulling(true);
+  NullRenderSink sink;
+  sink.setView(sf::View(sf::Vector2f{24.f, 8.f}, sf::Vector2f{40.f, 16.f}));  // x 4..44
+  renderer.resetStats();
+  renderer.renderGround(sink);
+  EXPECT_EQ(renderer.stats().animatedTiles, 3u);
+
+  renderer.resetStats();
+  renderer.renderGround(sink);
+  EXPECT_EQ(renderer.stats().animatedTiles, 0u);
+}
@@ -0,0 +1,159 @@
+// Copyright 2025 WildSpark Authors
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "networking/WireProtocol.h"
+
+TEST(WireProtocol, VarintsAndFixedFieldsRoundTrip) {
+  std::string bytes;
+  wire::Writer w(bytes);
+  const std::vector<std::uint64_t> values = {0, 1, 127, 128, 300, 16383, 16384,
+                                             UINT32_MAX, UINT64_MAX};
+  for (const auto v : values) w.varint(v);
+  w.i32(-123456);
+  w.f32(3.25f);
+  w.str("héllo");
+  EXPECT_EQ(bytes[0], 0);           // 0 is one byte
+  EXPECT_EQ(bytes.substr(3, 2), "\x80\x01");  // 128
+
+  wire::Reader r(bytes);
+  for (const auto v : values) EXPECT_EQ(r.varint(), v);
+  EXPECT_EQ(r.i32(), -123456);
+  EXPECT_EQ(r.f32(), 3.25f);
+  EXPECT_EQ(r.str(), "héllo");
+  EXPECT_TRUE(r.ok());
+  EXPECT_TRUE(r.atEnd());
+}
+
+TEST(WireProtocol, SignedVarintsAreZigzagEncoded) {
+  std::string bytes;
+  wire::Writer w(bytes);
+  const std::vector<std::int64_t> values = {0, -1, 1, -64, 63, -65, INT32_MIN, INT64_MAX,
+                                            INT64_MIN};
+  for (const auto v : values) w.svarint(v);
+  EXPECT_EQ(bytes.substr(0, 5), std::string("\x00\x01\x02\x7F\x7E", 5));  // -64 and 63 fit a byte
+
+  wire::Reader r(bytes);
+  for (const auto v : values) EXPECT_EQ(r.svarint(), v);
+  EXPECT_TRUE(r.ok());
+  EXPECT_TRUE(r.atEnd());
+}
+
+TEST(WireProtocol, FixedFieldsAreLittleEndian) {
+  std::string bytes;
+  wire::Writer(bytes).i32(0x01020304);
+  ASSERT_EQ(bytes.size(), 4u);
+  EXPECT_EQ(bytes, std::string("\x04\x03\x02\x01", 4));
+}
+
+TEST(WireProtocol, WorldUpdateStreamsPlayers) {
+  std::string bytes;
+  {
+    wire::WorldUpdateWriter writer(bytes, 2);
+    writer.add({7, "3f2c-alice", {100.5f, -20.25f}, 12});
+    writer.add({300, "", {1.03f, 2.f}, 0});
+  }
+  EXPECT_TRUE(wire::isBinary(bytes));
+
+  wire::WorldUpdateReader reader(bytes);
+  ASSERT_TRUE(reader.ok());
+  EXPECT_EQ(reader.count(), 2u);
+  wire::PlayerState state;
+  ASSERT_TRUE(reader.next(state));
+  EXPECT_EQ(state.netId, 7u);
+  EXPECT_EQ(state.userId, "3f2c-alice");
+  EXPECT_EQ(state.position, sf::Vector2f(100.5f, -20.25f));
+  EXPECT_EQ(state.lastSequence, 12u);
+  ASSERT_TRUE(reader.next(state));
+  EXPECT_EQ(state.netId, 300u);
+  EXPECT_TRUE(state.userId.empty());
+  // Quantized to 1/16 px.
+  EXPECT_NEAR(state.position.x, 1.03f, 0.5f / wire::kPositionScale);
+  EXPECT_FALSE(reader.next(state));
+  EXPECT_TRUE(reader.ok());
+}
+
+TEST(WireProtocol, TruncatedMessagesAreRejected) {
+  std::string bytes;
+  {
+    wire::WorldUpdateWriter writer(bytes, 1);
+    writer.add({1, "bob", {5.f, 5.f}, 3});
+  }
+  for (std::size_t n = 0; n < bytes.size(); ++n) {
+    wire::WorldUpdateReader reader(std::string_view(bytes).substr(0, n));
+    wire::PlayerState state;
+    EXPECT_FALSE(reader.next(state)) << "prefix " << n;
+  }
+  // JSON and other versions are not mistaken for binary.
+  EXPECT_FALSE(wire::isBinary(R"({"type":"world_update"})"));
+  std::string future = bytes;
+  future[1] = static_cast<char>(wire::kVersion + 1);
+  EXPECT_FALSE(wire::WorldUpdateReader(future).ok());
+}
+
+TEST(WireProtocol, ClientAndAckMessagesRoundTrip) {
+  std::string bytes;
+  wire::encode(wire::PlayerInput{42, {70.7f, -70.7f}}, bytes);
+  wire::PlayerInput input;
+  ASSERT_TRUE(wire::decode(bytes, input));
+  EXPECT_EQ(input.sequence, 42u);
+  EXPECT_EQ(input.velocity, sf::Vector2f(70.7f, -70.7f));  // floats are exact
+
+  wire::encode(wire::PlayerAction{43, 1201, "interact"}, bytes);
+  wire::PlayerAction action;
+  ASSERT_TRUE(wire::decode(bytes, action));
+  EXPECT_EQ(action.objectId, 1201u);
+  EXPECT_EQ(action.action, "interact");
+
+  wire::InputAck ack;
+  ack.sequence = 42;
+  ack.approved = true;
+  ack.hasPosition = true;
+  ack.playerId = "me";
+  ack.position = {10.f, 20.f};
+  wire::encode(ack, bytes);
+  wire::InputAck decodedAck;
+  ASSERT_TRUE(wire::decode(bytes, decodedAck));
+  EXPECT_TRUE(decodedAck.approved);
+  EXPECT_EQ(decodedAck.playerId, "me");
+  EXPECT_EQ(decodedAck.position, sf::Vector2f(10.f, 20.f));
+
+  wire::ObjectUpdate update;
+  update.objectId = 9;
+  update.fields = wire::ObjectUpdate::kGid | wire::ObjectUpdate::kOpacity;
+  update.gid = 0x80000010u;
+  update.opacity = 0.5f;
+  wire::encode(update, bytes);
+  wire::ObjectUpdate decodedUpdate;
+  ASSERT_TRUE(wire::decode(bytes, decodedUpdate));
+  EXPECT_EQ(decodedUpdate.fields, update.fields);
+  EXPECT_EQ(decodedUpdate.gid, update.gid);
+  EXPECT_EQ(decodedUpdate.opacity, 0.5f);
+}
+
+TEST(WireProtocol, InputPacketsCarryEarlierInputs) {
+  const wire::PlayerInput inputs[] = {{7, {1.f, 0.f}}, {9, {0.f, 1.f}}, {10, {-1.f, 0.f}}};
+  std::string bytes;
+  wire::encode(inputs, bytes);
+
+  // Single-input readers see the newest input.
+  wire::PlayerInput newest;
+  ASSERT_TRUE(wire::decode(bytes, newest));
+  EXPECT_EQ(newest.sequence, 10u);
+
+  wire::PlayerInput decoded[4];
+  ASSERT_EQ(wire::decode(bytes, decoded), 3u);
+  EXPECT_EQ(decoded[0].sequence, 10u);
+  EXPECT_EQ(decoded[1].sequence, 9u);
+  EXPECT_EQ(decoded[2].sequence, 7u);
+  EXPECT_EQ(decoded[2].velocity, sf::Vector2f(1.f, 0.f));
+
+  // Fewer slots than inputs keeps the newest ones.
+  EXPECT_EQ(wire::decode(bytes, std::span(decoded, 2)), 2u);
+  bytes.pop_back();
+  EXPECT_EQ(wire::decode(bytes, decoded), 0u);
+}